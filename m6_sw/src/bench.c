@@ -0,0 +1,498 @@
+/*
+ * bench.c -- driver microbenchmark implementation
+ *
+ * Author: Joshua M. Meise
+ * Created: 10-19-2026
+ * Version: 1.0
+ *
+ * Description: Times single driver operations with warm and cold caches
+ * using the pmu cycle counter and the global timer, and prints one
+ * machine-readable line per case.
+ */
+
+// Library inclusions.
+#include <string.h>
+#include <stdbool.h>
+#include "bench.h"
+#include "led.h"
+#include "adc.h"
+#include "servo.h"
+#include "xgpio.h"
+#include "xttcps.h"
+#include "xuartps.h"
+#include "xstatus.h"
+#ifdef BENCH_SIM
+#include <time.h>
+#else
+#include "gic.h"
+#include "memmap.h"
+#include "mpool.h"
+#include "tlsf.h"
+#include "xil_io.h"
+#include "xil_cache.h"
+#include "xil_exception.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+#include "xtime_l.h"
+#endif
+
+// Predefined constants.
+#define WARM_CALLS 200
+#define COLD_CALLS 50
+#define CAL_CALLS 64
+#define CHANNEL1 1
+#define TTC_FREQ_A 10
+#define TTC_FREQ_B 1000
+#define BENCH_GIC_ID XPAR_XTTCPS_1_INTR		/* the suite owns ttc 1 */
+#define EVICT_SIZE 0x800000U				/* sim: more than a host last-level cache */
+#define EVICT_STRIDE 64U
+#define IRQ_LATENCY_TRIALS 100
+#define IRQ_COST_TRIALS 100
+#define IRQ_ROUND_TRIPS 1000
+
+// A benchmarked operation.
+typedef struct {
+	const char *name;
+	void (*prepare)(void);		/* untimed, before every call */
+	void (*run)(void);
+} bench_case_t;
+
+// A benchmark of a whole subsystem that times and prints on its own.
+typedef struct {
+	const char *name;
+	void (*run)(void);
+} bench_suite_t;
+
+// Global variables.
+static XGpio gpio;
+static XTtcPs ttc;
+static XUartPs uart;
+static bool initialized;
+static u32 overhead;
+static u32 samples[WARM_CALLS];
+static u32 gtSamples[WARM_CALLS];
+static bool ledState;
+static double servoDuty;
+static u32 ttcFreq;
+static volatile u32 gpioVal;
+static volatile float potVal;
+#ifdef BENCH_SIM
+static u8 evictBuf[EVICT_SIZE];
+#endif
+
+#ifdef BENCH_SIM
+/*
+ * Host time in nanoseconds; stands in for both counters.
+ * Inputs: None.
+ * Outputs: Nanoseconds, truncated.
+ */
+static inline u32 bench_ns(void) {
+	// Variable declarations.
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u32)((u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec);
+}
+
+static inline u32 bench_cycles(void) {
+	return bench_ns();
+}
+
+static inline u32 bench_ticks(void) {
+	return bench_ns();
+}
+
+#define GT_SCALE 1U
+
+static inline bool bench_mask(void) {
+	return true;
+}
+
+static inline void bench_unmask(bool wasMasked) {
+	(void)wasMasked;
+}
+
+/*
+ * Push the caller's working set out of the host caches.
+ * Inputs: None.
+ * Outputs: None.
+ */
+static void bench_evict(void) {
+	// Variable declarations.
+	u32 n;
+
+	for (n = 0; n < EVICT_SIZE; n += EVICT_STRIDE)
+		evictBuf[n]++;
+}
+#else
+/*
+ * Read the pmu cycle counter.
+ * Inputs: None.
+ * Outputs: Cycles.
+ */
+static inline u32 bench_cycles(void) {
+	return mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+}
+
+/*
+ * Read the low word of the global timer.
+ * Inputs: None.
+ * Outputs: Ticks.
+ */
+static inline u32 bench_ticks(void) {
+	return Xil_In32(GLOBAL_TMR_BASEADDR + GTIMER_COUNTER_LOWER_OFFSET);
+}
+
+// Cpu cycles per global timer tick.
+#define GT_SCALE (XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / COUNTS_PER_SECOND)
+
+/*
+ * Mask irqs around a timed call.
+ * Inputs: None.
+ * Outputs: Whether irqs were already masked.
+ */
+static inline bool bench_mask(void) {
+	// Variable declarations.
+	bool wasMasked = (mfcpsr() & XIL_EXCEPTION_IRQ) != 0;
+
+	Xil_ExceptionDisableMask(XIL_EXCEPTION_IRQ);
+	return wasMasked;
+}
+
+static inline void bench_unmask(bool wasMasked) {
+	if (!wasMasked)
+		Xil_ExceptionEnableMask(XIL_EXCEPTION_IRQ);
+}
+
+/*
+ * Clean and invalidate every cache level before a cold call.
+ * Inputs: None.
+ * Outputs: None.
+ */
+static void bench_evict(void) {
+	Xil_DCacheFlush();
+	Xil_ICacheInvalidate();
+}
+#endif
+
+/*
+ * The cases.
+ * Inputs: None.
+ * Outputs: None.
+ */
+static void prepare_led_set(void) {
+	ledState = led_get(0);
+}
+
+static void run_led_set(void) {
+	// Rewrite the current state so nothing visible changes.
+	led_set(0, ledState);
+}
+
+static void run_gpio_read(void) {
+	gpioVal = XGpio_DiscreteRead(&gpio, CHANNEL1);
+}
+
+static void run_adc_get_pot(void) {
+	potVal = adc_get_pot();
+}
+
+static void prepare_servo_set(void) {
+	servoDuty = servo_get();
+}
+
+static void run_servo_set(void) {
+	// Rewrite the current duty cycle so the gate does not move.
+	servo_set(servoDuty);
+}
+
+static void prepare_uart_send(void) {
+	// Start every send with an empty fifo.
+	while ((XUartPs_ReadReg(uart.Config.BaseAddress, XUARTPS_SR_OFFSET) & XUARTPS_SR_TXEMPTY) == 0);
+}
+
+static void run_uart_send(void) {
+	// A carriage return leaves the console as it was.
+	XUartPs_Send(&uart, (u8 *)"\r", 1);
+}
+
+static void run_ttc_reprogram(void) {
+	// Variable declarations.
+	XInterval interval;
+	u8 prescaler;
+
+	ttcFreq = (ttcFreq == TTC_FREQ_A) ? TTC_FREQ_B : TTC_FREQ_A;
+	XTtcPs_CalcIntervalFromFreq(&ttc, ttcFreq, &interval, &prescaler);
+	XTtcPs_SetPrescaler(&ttc, prescaler);
+	XTtcPs_SetInterval(&ttc, interval);
+}
+
+#ifndef BENCH_SIM
+static void bench_nop(void *devp) {
+	(void)devp;
+}
+
+static void prepare_gic_connect(void) {
+	gic_disconnect(BENCH_GIC_ID);
+}
+
+static void run_gic_connect(void) {
+	gic_connect(BENCH_GIC_ID, bench_nop, NULL);
+}
+
+/*
+ * The suites not owned by a module.
+ * Inputs: None.
+ * Outputs: None.
+ */
+static void suite_flushcal(void) {
+	// Measure again and print; the new threshold is kept.
+	memmap_calibrate_flush(true);
+}
+
+static void suite_irq_latency(void) {
+	// Worst case with cold caches.
+	printf("[irq latency %lu cycles]\n", (unsigned long)gic_measure_latency(IRQ_LATENCY_TRIALS, true));
+}
+
+static void suite_irq_round_trip(void) {
+	// Variable declarations.
+	u32 streamlined, best, mean;
+
+	// Empty handler through the generic and then the streamlined entry.
+	for (streamlined = 0; streamlined < 2; streamlined++) {
+		if (gic_measure_round_trip(IRQ_ROUND_TRIPS, streamlined == 1, &best, &mean))
+			printf("[irq %s round trip best %lu mean %lu cycles]\n", streamlined ? "streamlined" : "generic",
+					(unsigned long)best, (unsigned long)mean);
+		else
+			printf("Error measuring interrupt round trip.\n");
+	}
+}
+
+static void suite_irq_cost(void) {
+	// Variable declarations.
+	u32 fp, entry, body, leave;
+
+	// Entry, body and exit with and without floating point in the handler.
+	for (fp = 0; fp < 2; fp++) {
+		if (gic_measure_irq_cost(IRQ_COST_TRIALS, fp == 1, &entry, &body, &leave))
+			printf("[irq %s entry %lu body %lu exit %lu cycles]\n", fp ? "fp" : "int",
+					(unsigned long)entry, (unsigned long)body, (unsigned long)leave);
+		else
+			printf("Error measuring interrupt cost.\n");
+	}
+}
+#endif
+
+static const bench_case_t cases[] = {
+	{ "led_set", prepare_led_set, run_led_set },
+	{ "gpio_read", NULL, run_gpio_read },
+	{ "adc_get_pot", NULL, run_adc_get_pot },
+	{ "servo_set", prepare_servo_set, run_servo_set },
+	{ "uart_send", prepare_uart_send, run_uart_send },
+	{ "ttc_reprogram", NULL, run_ttc_reprogram },
+#ifndef BENCH_SIM
+	{ "gic_connect", prepare_gic_connect, run_gic_connect },
+#endif
+};
+
+#define NUM_CASES (sizeof(cases) / sizeof(cases[0]))
+
+#ifndef BENCH_SIM
+static const bench_suite_t suites[] = {
+	{ "memmap", memmap_bench },
+	{ "irq_latency", suite_irq_latency },
+	{ "irq_cost", suite_irq_cost },
+	{ "irq_round_trip", suite_irq_round_trip },
+	{ "l2lock", memmap_lock_bench },
+	{ "flushcal", suite_flushcal },
+	{ "memcpy", memmap_copy_bench },
+	{ "tlsf", tlsf_bench },
+	{ "mpool", mpool_bench },
+};
+
+#define NUM_SUITES (sizeof(suites) / sizeof(suites[0]))
+#else
+static const bench_suite_t *suites = NULL;
+
+#define NUM_SUITES 0U
+#endif
+
+/*
+ * Sort samples in place; small counts, so insertion sort.
+ * Inputs: Samples, count.
+ * Outputs: None.
+ */
+static void bench_sort(u32 *s, u32 n) {
+	// Variable declarations.
+	u32 i, j, v;
+
+	for (i = 1; i < n; i++) {
+		v = s[i];
+		for (j = i; j > 0 && s[j - 1] > v; j--)
+			s[j] = s[j - 1];
+		s[j] = v;
+	}
+}
+
+/*
+ * Time one case and print its line.
+ * Inputs: Case, whether to evict before each call.
+ * Outputs: None.
+ */
+static void bench_measure(const bench_case_t *c, bool cold) {
+	// Variable declarations.
+	u32 calls = cold ? COLD_CALLS : WARM_CALLS;
+	u32 n, c0, c1, t0, t1, d;
+	u64 total;
+	bool masked;
+
+	// One untimed call to fault in the code and data.
+	if (!cold) {
+		if (c->prepare != NULL)
+			c->prepare();
+#ifdef BENCH_SIM
+		// Register traffic is exact on the simulator, so report it too.
+		n = sim_accesses();
+		c->run();
+		printf("[bench %s accesses %lu]\n", c->name, (unsigned long)(sim_accesses() - n));
+#else
+		c->run();
+#endif
+	}
+
+	for (n = 0, total = 0; n < calls; n++) {
+		if (c->prepare != NULL)
+			c->prepare();
+		if (cold)
+			bench_evict();
+
+		masked = bench_mask();
+		t0 = bench_ticks();
+		c0 = bench_cycles();
+		c->run();
+		c1 = bench_cycles();
+		t1 = bench_ticks();
+		bench_unmask(masked);
+
+		d = c1 - c0;
+		samples[n] = (d > overhead) ? d - overhead : 0;
+		gtSamples[n] = (t1 - t0) * GT_SCALE;
+		total += samples[n];
+	}
+
+	bench_sort(samples, calls);
+	bench_sort(gtSamples, calls);
+	printf("[bench %s %s %lu %lu %lu %lu %lu %lu]\n", c->name, cold ? "cold" : "warm", (unsigned long)calls,
+			(unsigned long)samples[0], (unsigned long)samples[calls / 2], (unsigned long)(total / calls),
+			(unsigned long)samples[calls - 1], (unsigned long)gtSamples[calls / 2]);
+}
+
+/*
+ * Set up the devices the suite owns and calibrate the timing overhead.
+ * Inputs: None.
+ * Outputs: XST_SUCCESS or XST_FAILURE.
+ */
+s32 bench_init(void) {
+	// Variable declarations.
+	XTtcPs_Config *ttcConf;
+	XUartPs_Config *uartConf;
+	u32 n, c0, c1;
+
+	if (XGpio_Initialize(&gpio, XPAR_AXI_GPIO_0_DEVICE_ID) != XST_SUCCESS)
+		return XST_FAILURE;
+
+	// Ttc 1 is left stopped; only its registers are rewritten.
+	ttcConf = XTtcPs_LookupConfig(XPAR_XTTCPS_1_DEVICE_ID);
+	if (ttcConf == NULL)
+		return XST_FAILURE;
+	if (XTtcPs_CfgInitialize(&ttc, ttcConf, ttcConf->BaseAddress) != XST_SUCCESS)
+		return XST_FAILURE;
+	ttcFreq = TTC_FREQ_A;
+
+	// A second instance on the console uart, polled.
+	uartConf = XUartPs_LookupConfig(XPAR_XUARTPS_1_DEVICE_ID);
+	if (uartConf == NULL || XUartPs_CfgInitialize(&uart, uartConf, uartConf->BaseAddress) != XST_SUCCESS)
+		return XST_FAILURE;
+
+#ifndef BENCH_SIM
+	// Start the pmu cycle counter, undivided.
+	mtcp(XREG_CP15_PERF_MONITOR_CTRL, (mfcp(XREG_CP15_PERF_MONITOR_CTRL) | 0x1U) & ~0x8U);
+	mtcp(XREG_CP15_COUNT_ENABLE_SET, 0x80000000U);
+	isb();
+#endif
+
+	// The cost of reading the counters back to back comes off every sample.
+	for (n = 0, overhead = 0xFFFFFFFFU; n < CAL_CALLS; n++) {
+		c0 = bench_cycles();
+		c1 = bench_cycles();
+		if (c1 - c0 < overhead)
+			overhead = c1 - c0;
+	}
+
+	initialized = true;
+	return XST_SUCCESS;
+}
+
+/*
+ * Run one case or suite, or all of them.
+ * Inputs: Case or suite name; NULL or "all" for every one.
+ * Outputs: Number of cases run.
+ */
+u32 bench_run(const char *name) {
+	// Variable declarations.
+	u32 n, ran;
+	bool all = (name == NULL || name[0] == '\0' || strcmp(name, "all") == 0);
+
+	if (!initialized) {
+		printf("Error: benchmarks not initialized.\n");
+		return 0;
+	}
+
+#ifdef BENCH_SIM
+	printf("[bench sim ns]\n");
+#else
+	printf("[bench target %lu hz]\n", (unsigned long)XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ);
+#endif
+	printf("[bench case cache calls best median mean max gt]\n");
+
+	for (n = 0, ran = 0; n < NUM_CASES; n++) {
+		if (!all && strcmp(name, cases[n].name) != 0)
+			continue;
+		bench_measure(&cases[n], false);
+		bench_measure(&cases[n], true);
+		ran++;
+	}
+
+	for (n = 0; n < NUM_SUITES; n++) {
+		if (!all && strcmp(name, suites[n].name) != 0)
+			continue;
+		printf("[bench suite %s]\n", suites[n].name);
+		suites[n].run();
+		ran++;
+	}
+
+#ifndef BENCH_SIM
+	gic_disconnect(BENCH_GIC_ID);
+#endif
+
+	if (ran == 0)
+		printf("Error: no benchmark called %s.\n", name);
+
+	return ran;
+}
+
+/*
+ * Print the case and suite names.
+ * Inputs: None.
+ * Outputs: None.
+ */
+void bench_list(void) {
+	// Variable declarations.
+	u32 n;
+
+	for (n = 0; n < NUM_CASES; n++)
+		printf("[bench case %s]\n", cases[n].name);
+	for (n = 0; n < NUM_SUITES; n++)
+		printf("[bench suite %s]\n", suites[n].name);
+}
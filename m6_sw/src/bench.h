@@ -0,0 +1,48 @@
+/*
+ * bench.h -- driver microbenchmark interface
+ *
+ * Each case times a single driver operation. Warm runs repeat it back to
+ * back after one discarded call; cold runs clean and invalidate the caches
+ * before every call. Interrupts are masked around each timed call. Cycles
+ * come from the pmu cycle counter and the global timer is read alongside
+ * as a cross-check.
+ *
+ * Results are printed one line per case and run as
+ *   [bench <case> <warm|cold> <calls> <best> <median> <mean> <max> <gt>]
+ * in cycles, with <gt> the median from the global timer, after a
+ * [bench target <hz> hz] or [bench sim ns] line naming the unit.
+ * tools/bench_compare.py checks a capture against a saved baseline.
+ *
+ * Suites benchmark a whole subsystem (memory map profiles, allocators,
+ * interrupt paths) and print their own lines after a [bench suite <name>]
+ * line. They run after the cases, by name or with all.
+ *
+ * Built with -DBENCH_SIM the suite runs on linux against the simulated
+ * register file in tools/benchsim; times are then nanoseconds, the gic
+ * case is left out, and each case also prints the exact number of
+ * register accesses one call makes as [bench <case> accesses <n>]; the
+ * suites need the hardware and are left out.
+ */
+#pragma once
+
+#include <stdio.h>
+#include "xil_types.h"		/* types used by xilinx */
+
+/*
+ * Set up the devices the suite owns (ttc 1, a console uart instance and a
+ * gpio instance); led, servo, adc and gic must already be initialized
+ * returns XST_SUCCESS on success; otherwise XST_FAILURE
+ */
+s32 bench_init(void);
+
+/*
+ * Run the case or suite called <name>, or all of them if <name> is NULL or
+ * "all"
+ * returns the number of cases and suites run
+ */
+u32 bench_run(const char *name);
+
+/*
+ * Print the case and suite names
+ */
+void bench_list(void);
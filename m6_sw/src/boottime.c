@@ -0,0 +1,107 @@
+/*
+ * boottime.c -- fsbl boot time log implementation
+ *
+ * Author: Joshua M. Meise
+ * Created: 10-19-2026
+ * Version: 1.0
+ *
+ * Description: Copies the boot stage log the fsbl leaves in ocm and prints
+ * it in microseconds.
+ */
+
+// Library inclusions.
+#include "boottime.h"
+#include "xil_cache.h"
+
+// Predefined constants.
+#define NUM_STAGES (sizeof(stageNames) / sizeof(stageNames[0]))
+
+// Global variables.
+static const char *const stageNames[] = {
+	"ps7_init", "ddr_check", "pcap_init", "wdt_init", "device_init", "header",
+	"move", "checksum", "auth", "decrypt", "pcap", "handoff", "decompress",
+	"pcap_start"
+};
+static boottime_log_t bootLog;
+
+/*
+ * Convert global timer counts to microseconds.
+ * Inputs: Counts.
+ * Outputs: Microseconds.
+ */
+static u32 to_us(u32 counts) {
+	return (u32)(((u64)counts * 1000000U) / bootLog.countsPerSecond);
+}
+
+/*
+ * Copy and invalidate the fsbl log.
+ * Inputs: None.
+ * Outputs: True if there was a log.
+ */
+bool boottime_init(void) {
+	// Variable declarations.
+	volatile boottime_log_t *log = (volatile boottime_log_t *)BOOTTIME_ADDR;
+	u32 n;
+
+	bootLog.magic = 0;
+
+	// Read what the fsbl wrote rather than anything cached since.
+	Xil_DCacheInvalidateRange(BOOTTIME_ADDR, sizeof(boottime_log_t));
+
+	if (log->magic != BOOTTIME_MAGIC || log->count > BOOTTIME_MAX_POINTS || log->countsPerSecond == 0)
+		return false;
+
+	bootLog.count = log->count;
+	bootLog.countsPerSecond = log->countsPerSecond;
+	bootLog.dropped = log->dropped;
+	for (n = 0; n < bootLog.count; n++) {
+		bootLog.point[n].stage = log->point[n].stage;
+		bootLog.point[n].partition = log->point[n].partition;
+		bootLog.point[n].time = log->point[n].time;
+	}
+	bootLog.magic = BOOTTIME_MAGIC;
+
+	log->magic = 0;
+	Xil_DCacheFlushRange(BOOTTIME_ADDR, sizeof(boottime_log_t));
+
+	return true;
+}
+
+/*
+ * Print the log.
+ * Inputs: None.
+ * Outputs: None.
+ */
+void boottime_print(void) {
+	// Variable declarations.
+	boottime_point_t *p;
+	u32 n, prev;
+	char part[8];
+
+	if (bootLog.magic != BOOTTIME_MAGIC) {
+		printf("[boot none]\n");
+		return;
+	}
+
+	printf("[boot hz %lu points %lu dropped %lu]\n", (unsigned long)bootLog.countsPerSecond,
+			(unsigned long)bootLog.count, (unsigned long)bootLog.dropped);
+
+	// Each stage runs from the previous point (fsbl entry for the first).
+	for (n = 0, prev = 0; n < bootLog.count; n++) {
+		p = &bootLog.point[n];
+		if (p->partition == BOOTTIME_NO_PARTITION)
+			snprintf(part, sizeof(part), "-");
+		else
+			snprintf(part, sizeof(part), "%u", (unsigned)p->partition);
+
+		if (p->stage < NUM_STAGES)
+			printf("[boot %s %s %lu %lu]\n", stageNames[p->stage], part,
+					(unsigned long)to_us(p->time), (unsigned long)to_us(p->time - prev));
+		else
+			printf("[boot stage%u %s %lu %lu]\n", (unsigned)p->stage, part,
+					(unsigned long)to_us(p->time), (unsigned long)to_us(p->time - prev));
+		prev = p->time;
+	}
+
+	printf("[boot total %lu]\n", (unsigned long)to_us(prev));
+}
@@ -0,0 +1,55 @@
+/*
+ * boottime.h -- fsbl boot time log interface
+ *
+ * The fsbl records the end of each of its boot stages in a log at a fixed
+ * address in the top of the high ocm (zynq_fsbl/boot_time.h), which
+ * lscript.ld keeps out of ps7_ram_1. Times are global timer counts from
+ * fsbl entry; the ps7_init point is approximate because ps7_init changes
+ * the clock the timer runs from.
+ *
+ * boottime_print prints the log as
+ *   [boot hz <counts per second> points <n> dropped <n>]
+ *   [boot <stage> <partition|-> <end us> <stage us>]
+ *   [boot total <us>]
+ * or [boot none] if the fsbl did not leave one. tools/boot_chart.py
+ * charts a capture of these lines.
+ */
+#pragma once
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "xil_types.h"		/* types used by xilinx */
+
+/* log layout; must match zynq_fsbl/boot_time.h */
+#define BOOTTIME_ADDR 0xFFFFFD00U
+#define BOOTTIME_MAGIC 0x42544D31U									/* "BTM1" */
+#define BOOTTIME_MAX_POINTS 30U
+#define BOOTTIME_NO_PARTITION 0xFFFFU
+
+/* one checkpoint: the end of a stage */
+typedef struct {
+	u16 stage;
+	u16 partition;
+	u32 time;			/* global timer, low word */
+} boottime_point_t;
+
+/* the log */
+typedef struct {
+	u32 magic;
+	u32 count;
+	u32 countsPerSecond;
+	u32 dropped;
+	boottime_point_t point[BOOTTIME_MAX_POINTS];
+} boottime_log_t;
+
+/*
+ * Take a copy of the log the fsbl left and invalidate it, so a restart
+ * without the fsbl (e.g. over jtag) does not report a stale boot
+ * returns true if there was a log
+ */
+bool boottime_init(void);
+
+/*
+ * Print the copy taken by boottime_init
+ */
+void boottime_print(void);
@@ -0,0 +1,23 @@
+/*
+ * fast.h -- placement of interrupt-path code and data in on-chip memory
+ *
+ * Objects marked with these macros are linked into OCM (see lscript.ld)
+ * and copied there from DDR by the startup code before main runs.
+ */
+#pragma once
+
+#ifndef NO_FAST_SECTIONS
+
+/* a function on the interrupt path */
+#define FAST_TEXT __attribute__((section(".fast_text"), noinline))
+
+/* data touched on the interrupt path */
+#define FAST_DATA __attribute__((section(".fast_data")))
+
+#else
+
+/* build with -DNO_FAST_SECTIONS to measure the all-DDR baseline */
+#define FAST_TEXT
+#define FAST_DATA
+
+#endif
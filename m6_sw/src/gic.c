@@ -3,13 +3,67 @@
  *
  * Caroline Vanacore
  */
+#include <stdio.h>
 #include "gic.h"
+#include "fast.h"			/* ocm placement */
+#include "xpseudo_asm.h"	/* mfcp */
+#include "xreg_cortexa9.h"	/* cp15 register names */
+#include "xil_cache.h"		/* cold cache measurements */
+#include "xil_io.h"			/* global timer access */
+#include "xtime_l.h"		/* global timer details */
+
+#define GIC_LATENCY_SGI 15	/* software interrupt used to measure latency */
+#define GIC_OUTER_SGI 14	/* lower priority interrupt preempted in the self-test */
+#define GIC_FIQ_SGI 13		/* secure interrupt delivered as fiq in the self-test */
+#define GIC_PRIO_DEFAULT 0xA0	/* priority given to every id by the driver */
+#define GIC_PRIO_OUTER 0xB0
+#define GIC_PRIO_INNER 0x90
+#define GIC_SGI_SATT 0x8000U	/* raise a non-secure (group 1) sgi */
+#define GIC_D7_FG 0x0123456789ABCDEFULL		/* foreground value held in d7 */
+#define GIC_D7_OUTER 0xFEDCBA9876543210ULL	/* outer handler value held in d7 */
+
+/*
+ * A connected interrupt: the user handler and its device
+ */
+typedef struct {
+	Xil_InterruptHandler handler;
+	void *devp;
+} gic_entry_t;
 
 /*
  * Private Variables hidden by this module
  */
 static XScuGic gic;					/* the gic instance */
 static XScuGic_Config *gic_config;	/* the gic configuration */
+static gic_entry_t entries[XSCUGIC_MAX_NUM_INTR_INPUTS] FAST_DATA;	/* connected handlers */
+static volatile u32 counts[GIC_NUM_CPUS][XSCUGIC_MAX_NUM_INTR_INPUTS] FAST_DATA;	/* per-cpu counts */
+static volatile u32 sgi_stamp FAST_DATA;	/* global timer when the sgi was taken */
+static volatile bool sgi_taken FAST_DATA;	/* set by the sgi handler */
+static volatile u32 sgi_done FAST_DATA;		/* global timer when the handler body finished */
+static volatile float sgi_fp FAST_DATA;		/* touched by the floating point sgi handler */
+static volatile bool inner_taken FAST_DATA;	/* set by the preempting self-test handler */
+static volatile u32 test_seq[4] FAST_DATA;	/* order the self-test handlers ran in */
+static volatile u32 test_len FAST_DATA;
+static volatile bool test_fp FAST_DATA;		/* outer handler holds d7 while preempted */
+static volatile bool test_fiq FAST_DATA;	/* outer handler is preempted by a fiq, not nesting */
+static volatile u64 test_outer_d7 FAST_DATA;	/* d7 as the outer handler saw it */
+
+/*
+ * The cpu we are running on, from the multiprocessor affinity register
+ */
+static inline u8 gic_this_cpu(void) {
+	return (u8)(mfcp(XREG_CP15_MULTI_PROC_AFFINITY) & 0x3U);
+}
+
+/*
+ * Count the interrupt against the cpu taking it, then call the user handler
+ */
+static FAST_TEXT void gic_dispatch(void *ref) {
+	gic_entry_t *entry = (gic_entry_t *)ref;
+
+	counts[gic_this_cpu()][entry - entries]++;
+	entry->handler(entry->devp);
+}
 
 /*
  * Initialize the gic
@@ -20,6 +74,8 @@ s32 gic_init(void) {
 	/* initialize it */
 	if(XScuGic_CfgInitialize(&gic,gic_config,gic_config->CpuBaseAddress) != XST_SUCCESS)
 		return XST_FAILURE;
+	/* start with clean counters */
+	gic_clear_counts();
 	/* register the exception handler */
 	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,(Xil_ExceptionHandler)XScuGic_InterruptHandler,&gic);
 	/* enable exceptions */
@@ -32,8 +88,13 @@ s32 gic_init(void) {
  * Connect an interrupt id to handler and device
  */
 s32 gic_connect(u32 id, Xil_InterruptHandler handler,  void *devp) {
-	/* associate handler with the interrupt id */
-	if(XScuGic_Connect(&gic,id,handler,devp) != XST_SUCCESS)
+	if(id >= XSCUGIC_MAX_NUM_INTR_INPUTS || handler == NULL)
+		return XST_FAILURE;
+	/* remember the user handler so the dispatcher can count it */
+	entries[id].handler = handler;
+	entries[id].devp = devp;
+	/* associate the dispatcher with the interrupt id */
+	if(XScuGic_Connect(&gic,id,gic_dispatch,&entries[id]) != XST_SUCCESS)
 		return XST_FAILURE;
 	/* enable the interrupt at the gic */
 	XScuGic_Enable(&gic, id);
@@ -46,6 +107,427 @@ s32 gic_connect(u32 id, Xil_InterruptHandler handler,  void *devp) {
 void gic_disconnect(u32 id) {
 	XScuGic_Disconnect(&gic,id);
 	XScuGic_Disable(&gic,id);
+	if(id < XSCUGIC_MAX_NUM_INTR_INPUTS)
+		entries[id].handler = NULL;
+}
+
+/*
+ * Add a cpu to the targets of an interrupt id
+ */
+s32 gic_map_cpu(u32 id, u8 cpu) {
+	if(id >= XSCUGIC_MAX_NUM_INTR_INPUTS || cpu >= GIC_NUM_CPUS)
+		return XST_FAILURE;
+	XScuGic_InterruptMaptoCpu(&gic, cpu, id);
+	return XST_SUCCESS;
+}
+
+/*
+ * Remove a cpu from the targets of an interrupt id
+ */
+s32 gic_unmap_cpu(u32 id, u8 cpu) {
+	if(id >= XSCUGIC_MAX_NUM_INTR_INPUTS || cpu >= GIC_NUM_CPUS)
+		return XST_FAILURE;
+	XScuGic_InterruptUnmapFromCpu(&gic, cpu, id);
+	return XST_SUCCESS;
+}
+
+/*
+ * Retarget an interrupt id to a single cpu
+ */
+s32 gic_migrate(u32 id, u8 cpu) {
+	u32 reg;
+	u32 shift;
+
+	/* only shared peripheral interrupts have a writable target */
+	if(id < XSCUGIC_SPI_INT_ID_START || id >= XSCUGIC_MAX_NUM_INTR_INPUTS || cpu >= GIC_NUM_CPUS)
+		return XST_FAILURE;
+	/* rewrite the whole target byte in one store so the id is never untargeted */
+	shift = (id & 0x3U) * 8U;
+	/* the register is shared with three other ids; lock as the driver does */
+	XIL_SPINLOCK();
+	reg = XScuGic_DistReadReg(&gic, XSCUGIC_SPI_TARGET_OFFSET_CALC(id));
+	reg &= ~((u32)0xFFU << shift);
+	reg |= ((u32)0x1U << cpu) << shift;
+	XScuGic_DistWriteReg(&gic, XSCUGIC_SPI_TARGET_OFFSET_CALC(id), reg);
+	XIL_SPINUNLOCK();
+	return XST_SUCCESS;
+}
+
+/*
+ * Get the count for an interrupt id on a cpu
+ */
+u32 gic_get_count(u32 id, u8 cpu) {
+	u32 sum;
+	u8 c;
+
+	if(id >= XSCUGIC_MAX_NUM_INTR_INPUTS)
+		return 0;
+	if(cpu != GIC_CPU_ALL)
+		return (cpu < GIC_NUM_CPUS) ? counts[cpu][id] : 0;
+	for(sum = 0, c = 0; c < GIC_NUM_CPUS; c++)
+		sum += counts[c][id];
+	return sum;
+}
+
+/*
+ * Get the total count for a cpu
+ */
+u32 gic_get_cpu_count(u8 cpu) {
+	u32 sum;
+	u32 id;
+
+	if(cpu >= GIC_NUM_CPUS)
+		return 0;
+	for(sum = 0, id = 0; id < XSCUGIC_MAX_NUM_INTR_INPUTS; id++)
+		sum += counts[cpu][id];
+	return sum;
+}
+
+/*
+ * Reset the counters
+ */
+void gic_clear_counts(void) {
+	u32 id;
+	u8 c;
+
+	for(c = 0; c < GIC_NUM_CPUS; c++)
+		for(id = 0; id < XSCUGIC_MAX_NUM_INTR_INPUTS; id++)
+			counts[c][id] = 0;
+}
+
+/*
+ * Print the counters
+ */
+void gic_print_counts(void) {
+	u32 id;
+	u8 c;
+
+	printf("[irq");
+	for(c = 0; c < GIC_NUM_CPUS; c++)
+		printf(" cpu%d", c);
+	printf("]\n");
+	for(id = 0; id < XSCUGIC_MAX_NUM_INTR_INPUTS; id++) {
+		if(entries[id].handler == NULL)
+			continue;
+		printf("[%3lu", (unsigned long)id);
+		for(c = 0; c < GIC_NUM_CPUS; c++)
+			printf(" %lu", (unsigned long)counts[c][id]);
+		printf("]\n");
+	}
+}
+
+/*
+ * Low word of the global timer, read directly so the handler stays in ocm
+ */
+static inline u32 gic_timer(void) {
+	return Xil_In32(GLOBAL_TMR_BASEADDR + GTIMER_COUNTER_LOWER_OFFSET);
+}
+
+/*
+ * Timestamp the latency test interrupt
+ */
+static FAST_TEXT void gic_sgi_handler(void *devp) {
+	sgi_stamp = gic_timer();
+	sgi_taken = true;
+}
+
+/*
+ * Software interrupt handler that does no floating point
+ */
+static FAST_TEXT void gic_sgi_int_handler(void *devp) {
+	sgi_stamp = gic_timer();
+	sgi_done = gic_timer();
+	sgi_taken = true;
+}
+
+/*
+ * Software interrupt handler whose body uses the vfp
+ */
+static FAST_TEXT void gic_sgi_fp_handler(void *devp) {
+	sgi_stamp = gic_timer();
+	sgi_fp = sgi_fp * 0.5f + 1.0f;
+	sgi_done = gic_timer();
+	sgi_taken = true;
+}
+
+/*
+ * Measure the mean entry, body and exit cost of an interrupt
+ */
+bool gic_measure_irq_cost(u32 iterations, bool fp, u32 *entry, u32 *body, u32 *leave) {
+	u32 start, end;
+	u32 n;
+	float fg;
+
+	*entry = *body = *leave = 0;
+	if(iterations == 0 || gic_connect(GIC_LATENCY_SGI, fp ? gic_sgi_fp_handler : gic_sgi_int_handler, NULL) != XST_SUCCESS)
+		return false;
+	/* keep live values in the foreground vfp registers across the interrupt */
+	fg = 0.0f;
+	for(n = 0; n < iterations; n++) {
+		sgi_taken = false;
+		start = gic_timer();
+		if(XScuGic_SoftwareIntr(&gic, GIC_LATENCY_SGI, 0x1U << gic_this_cpu()) != XST_SUCCESS)
+			break;
+		while(!sgi_taken);
+		end = gic_timer();
+		fg += 1.0f;
+		/* the global timer runs at half the cpu clock */
+		*entry += (sgi_stamp - start) * 2U;
+		*body += (sgi_done - sgi_stamp) * 2U;
+		*leave += (end - sgi_done) * 2U;
+	}
+	gic_disconnect(GIC_LATENCY_SGI);
+	if(n < iterations || fg != (float)iterations)
+		return false;
+	*entry /= iterations;
+	*body /= iterations;
+	*leave /= iterations;
+	return true;
+}
+
+/*
+ * Measure software interrupt latency
+ */
+u32 gic_measure_latency(u32 iterations, bool cold) {
+	u32 worst;
+	u32 start;
+	u32 n;
+
+	if(gic_connect(GIC_LATENCY_SGI, gic_sgi_handler, NULL) != XST_SUCCESS)
+		return 0;
+	for(worst = 0, n = 0; n < iterations; n++) {
+		/* write back and drop every cached line, instructions included */
+		if(cold) {
+			Xil_DCacheFlush();
+			Xil_ICacheInvalidate();
+		}
+		sgi_taken = false;
+		start = gic_timer();
+		if(XScuGic_SoftwareIntr(&gic, GIC_LATENCY_SGI, 0x1U << gic_this_cpu()) != XST_SUCCESS)
+			break;
+		while(!sgi_taken);
+		/* the global timer runs at half the cpu clock */
+		if((sgi_stamp - start) * 2U > worst)
+			worst = (sgi_stamp - start) * 2U;
+	}
+	gic_disconnect(GIC_LATENCY_SGI);
+	return worst;
+}
+
+/*
+ * Start the pmu cycle counter, undivided
+ */
+static void gic_cycles_start(void) {
+	mtcp(XREG_CP15_PERF_MONITOR_CTRL, (mfcp(XREG_CP15_PERF_MONITOR_CTRL) | 0x1U) & ~0x8U);
+	mtcp(XREG_CP15_COUNT_ENABLE_SET, 0x80000000U);
+	isb();
+}
+
+/*
+ * Read the pmu cycle counter
+ */
+static inline u32 gic_cycles(void) {
+	return mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+}
+
+/*
+ * Software interrupt trigger value raising <id> on this cpu
+ */
+static inline u32 gic_sgi_word(u32 id) {
+	return ((0x1U << gic_this_cpu()) << 16) | id;
+}
+
+/*
+ * Raise a software interrupt on this cpu
+ */
+static inline void gic_raise(u32 id) {
+	XScuGic_DistWriteReg(&gic, XSCUGIC_SFI_TRIG_OFFSET, gic_sgi_word(id));
+}
+
+/*
+ * Load <pattern> into d7, raise an interrupt by writing <sgi> to the
+ * trigger register, wait for <taken> and return what is in d7 afterwards
+ *
+ * Done in one block so nothing but the interrupt can touch d7.
+ */
+static inline u64 gic_hold_d7(u64 pattern, u32 sgi, volatile bool *taken) {
+	u64 out;
+	u32 tmp;
+
+	__asm__ __volatile__(
+		"vmov	d7, %Q[p], %R[p]\n\t"
+		"str	%[w], [%[r]]\n\t"
+		"1:	ldrb	%[t], [%[f]]\n\t"
+		"cmp	%[t], #0\n\t"
+		"beq	1b\n\t"
+		"vmov	%Q[o], %R[o], d7\n\t"
+		: [o] "=&r" (out), [t] "=&r" (tmp)
+		: [p] "r" (pattern), [w] "r" (sgi),
+		  [r] "r" (gic_config->DistBaseAddress + XSCUGIC_SFI_TRIG_OFFSET), [f] "r" (taken)
+		: "d7", "cc", "memory");
+	return out;
+}
+
+/*
+ * Overwrite d7 as a handler using the vfp would
+ */
+static inline void gic_clobber_d7(void) {
+	__asm__ __volatile__("vmov	d7, %0, %0" :: "r" (0U) : "d7");
+}
+
+/*
+ * Software interrupt handler that does nothing but say it ran
+ */
+static FAST_TEXT void gic_sgi_empty_handler(void *devp) {
+	sgi_taken = true;
+}
+
+/*
+ * Measure the interrupt round trip with an empty handler
+ */
+bool gic_measure_round_trip(u32 iterations, bool streamlined, u32 *best, u32 *mean) {
+	u32 start, c;
+	u32 n;
+
+	*best = 0xFFFFFFFFU;
+	*mean = 0;
+	if(iterations == 0 || gic_connect(GIC_LATENCY_SGI, gic_sgi_empty_handler, NULL) != XST_SUCCESS)
+		return false;
+	Xil_ExceptionSelectIrqEntry(streamlined ? 1U : 0U);
+	gic_cycles_start();
+	/* one untimed pass warms the caches and predictors */
+	for(n = 0; n <= iterations; n++) {
+		sgi_taken = false;
+		start = gic_cycles();
+		gic_raise(GIC_LATENCY_SGI);
+		while(!sgi_taken);
+		c = gic_cycles() - start;
+		if(n == 0)
+			continue;
+		*mean += c;
+		if(c < *best)
+			*best = c;
+	}
+	Xil_ExceptionSelectIrqEntry(1U);
+	gic_disconnect(GIC_LATENCY_SGI);
+	*mean /= iterations;
+	return true;
+}
+
+/*
+ * Self-test handler preempted by the inner interrupt or the fiq
+ */
+static FAST_TEXT void gic_outer_handler(void *devp) {
+	test_seq[test_len++] = GIC_OUTER_SGI;
+	inner_taken = false;
+	if(test_fiq) {
+		/* fiqs are not masked in irq mode */
+		if(test_fp)
+			test_outer_d7 = gic_hold_d7(GIC_D7_OUTER, gic_sgi_word(GIC_FIQ_SGI), &inner_taken);
+		else {
+			gic_raise(GIC_FIQ_SGI);
+			while(!inner_taken);
+		}
+	}
+	else {
+		/* no locals may live on the stack between these two */
+		Xil_EnableNestedInterrupts();
+		if(test_fp)
+			test_outer_d7 = gic_hold_d7(GIC_D7_OUTER, gic_sgi_word(GIC_LATENCY_SGI), &inner_taken);
+		else {
+			gic_raise(GIC_LATENCY_SGI);
+			while(!inner_taken);
+		}
+		Xil_DisableNestedInterrupts();
+	}
+	test_seq[test_len++] = GIC_OUTER_SGI;
+}
+
+/*
+ * Self-test handler for the preempting interrupt; destroys d7
+ */
+static FAST_TEXT void gic_inner_handler(void *devp) {
+	test_seq[test_len++] = (u32)(UINTPTR)devp;
+	gic_clobber_d7();
+	inner_taken = true;
+}
+
+/*
+ * Run one self-test case: the foreground holds d7 while the outer
+ * interrupt is preempted by <inner>
+ */
+static bool gic_selftest_case(u32 inner, bool fp) {
+	u64 fg;
+
+	test_len = 0;
+	test_fp = fp;
+	test_outer_d7 = GIC_D7_OUTER;
+	sgi_taken = false;
+	fg = gic_hold_d7(GIC_D7_FG, gic_sgi_word(GIC_OUTER_SGI) | (test_fiq ? GIC_SGI_SATT : 0U), &sgi_taken);
+	return fg == GIC_D7_FG && test_outer_d7 == GIC_D7_OUTER && test_len == 3 &&
+			test_seq[0] == GIC_OUTER_SGI && test_seq[1] == inner && test_seq[2] == GIC_OUTER_SGI;
+}
+
+/*
+ * Self-test handler wrapper; the foreground waits on sgi_taken
+ */
+static FAST_TEXT void gic_outer_entry(void *devp) {
+	gic_outer_handler(devp);
+	sgi_taken = true;
+}
+
+/*
+ * Check nested interrupts and fiq preemption against both irq entries
+ */
+bool gic_irq_selftest(void) {
+	u32 icdisr, iccicr;
+	u32 entry;
+	bool ok;
+	u32 fp;
+
+	ok = gic_connect(GIC_OUTER_SGI, gic_outer_entry, NULL) == XST_SUCCESS &&
+			gic_connect(GIC_LATENCY_SGI, gic_inner_handler, (void *)(UINTPTR)GIC_LATENCY_SGI) == XST_SUCCESS &&
+			gic_connect(GIC_FIQ_SGI, gic_inner_handler, (void *)(UINTPTR)GIC_FIQ_SGI) == XST_SUCCESS;
+	XScuGic_SetPriorityTriggerType(&gic, GIC_OUTER_SGI, GIC_PRIO_OUTER, 0x3);
+	XScuGic_SetPriorityTriggerType(&gic, GIC_LATENCY_SGI, GIC_PRIO_INNER, 0x3);
+	XScuGic_SetPriorityTriggerType(&gic, GIC_FIQ_SGI, GIC_PRIO_INNER, 0x3);
+
+	for(entry = 0; ok && entry < 2; entry++) {
+		Xil_ExceptionSelectIrqEntry(entry);
+		/* nested irqs, with and without the outer handler using the vfp first */
+		test_fiq = false;
+		for(fp = 0; ok && fp < 2; fp++)
+			ok = gic_selftest_case(GIC_LATENCY_SGI, fp == 1);
+		if(!ok)
+			break;
+		/*
+		 * fiq: the outer sgi moves to group 1 (still an irq) and the
+		 * secure group 0 is signalled on nFIQ
+		 */
+		icdisr = XScuGic_DistReadReg(&gic, XSCUGIC_SECURITY_OFFSET);
+		iccicr = XScuGic_CPUReadReg(&gic, XSCUGIC_CONTROL_OFFSET);
+		XScuGic_DistWriteReg(&gic, XSCUGIC_SECURITY_OFFSET, icdisr | (0x1U << GIC_OUTER_SGI));
+		XScuGic_CPUWriteReg(&gic, XSCUGIC_CONTROL_OFFSET, iccicr | XSCUGIC_CNTR_EN_NS_MASK |
+				XSCUGIC_CNTR_ACKCTL_MASK | XSCUGIC_CNTR_FIQEN_MASK);
+		Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_FIQ_INT, (Xil_ExceptionHandler)XScuGic_InterruptHandler, &gic);
+		Xil_ExceptionEnableMask(XIL_EXCEPTION_FIQ);
+		test_fiq = true;
+		for(fp = 0; ok && fp < 2; fp++)
+			ok = gic_selftest_case(GIC_FIQ_SGI, fp == 1);
+		Xil_ExceptionDisableMask(XIL_EXCEPTION_FIQ);
+		Xil_ExceptionRemoveHandler(XIL_EXCEPTION_ID_FIQ_INT);
+		XScuGic_CPUWriteReg(&gic, XSCUGIC_CONTROL_OFFSET, iccicr);
+		XScuGic_DistWriteReg(&gic, XSCUGIC_SECURITY_OFFSET, icdisr);
+	}
+
+	Xil_ExceptionSelectIrqEntry(1U);
+	XScuGic_SetPriorityTriggerType(&gic, GIC_OUTER_SGI, GIC_PRIO_DEFAULT, 0x3);
+	XScuGic_SetPriorityTriggerType(&gic, GIC_LATENCY_SGI, GIC_PRIO_DEFAULT, 0x3);
+	XScuGic_SetPriorityTriggerType(&gic, GIC_FIQ_SGI, GIC_PRIO_DEFAULT, 0x3);
+	gic_disconnect(GIC_FIQ_SGI);
+	gic_disconnect(GIC_LATENCY_SGI);
+	gic_disconnect(GIC_OUTER_SGI);
+	return ok;
 }
 
 /*
@@ -55,4 +537,3 @@ void gic_close(void) {
 	Xil_ExceptionRemoveHandler(XIL_EXCEPTION_ID_INT);
 	XScuGic_Stop(&gic);
 }
-
@@ -3,6 +3,7 @@
  */
 #pragma once
 
+#include <stdbool.h>
 #include "xparameters.h"    /* device details */
 #include "xil_exception.h"  /* exception handling */
 #include "xil_types.h"		/* types used by xilinx */
@@ -10,6 +11,9 @@
 #include "xgpio.h"			/* axi gpio details */
 #include "xuartps.h"		/* ps uart details */
 
+#define GIC_NUM_CPUS 2		/* cores on the zynq-7000 */
+#define GIC_CPU_ALL 0xFF	/* a value designating ALL cpus */
+
 /*
  * Initialize the gic
  *
@@ -20,6 +24,7 @@ s32 gic_init(void);
 /*
  * Connect an interrupt id to a handler and device
  *
+ * The interrupt is targeted at the cpu calling gic_connect
  * returns XST_SUCCESS on success; otherwise XST_FAILURE
  */
 s32 gic_connect(u32 id, Xil_InterruptHandler handler,  void *devp);
@@ -31,6 +36,97 @@ s32 gic_connect(u32 id, Xil_InterruptHandler handler,  void *devp);
  */
 void gic_disconnect(u32 id);
 
+/*
+ * Add <cpu> to the set of cpus that interrupt <id> is delivered to
+ *
+ * <cpu> is a number < GIC_NUM_CPUS
+ * returns XST_SUCCESS on success; otherwise XST_FAILURE
+ */
+s32 gic_map_cpu(u32 id, u8 cpu);
+
+/*
+ * Remove <cpu> from the set of cpus that interrupt <id> is delivered to
+ *
+ * returns XST_SUCCESS on success; otherwise XST_FAILURE
+ */
+s32 gic_unmap_cpu(u32 id, u8 cpu);
+
+/*
+ * Move interrupt <id> so that it is delivered to <cpu> only
+ *
+ * Safe to call while the interrupt is enabled; a pending interrupt
+ * is delivered to the new cpu.
+ * returns XST_SUCCESS on success; otherwise XST_FAILURE
+ */
+s32 gic_migrate(u32 id, u8 cpu);
+
+/*
+ * Get the number of times interrupt <id> has been handled on <cpu>
+ *
+ * <cpu> may be GIC_CPU_ALL to sum over every cpu
+ * returns 0 if <id> or <cpu> is invalid
+ */
+u32 gic_get_count(u32 id, u8 cpu);
+
+/*
+ * Get the total number of interrupts handled on <cpu>
+ */
+u32 gic_get_cpu_count(u8 cpu);
+
+/*
+ * Reset every interrupt counter to zero
+ */
+void gic_clear_counts(void);
+
+/*
+ * Print the per-cpu interrupt counts for every connected id
+ */
+void gic_print_counts(void);
+
+/*
+ * Measure the worst-case latency, in cpu cycles, from raising a software
+ * interrupt to entering its handler over <iterations> trials
+ *
+ * <cold> flushes and invalidates every cache level before each trial
+ * returns 0 if the measurement could not be made
+ */
+u32 gic_measure_latency(u32 iterations, bool cold);
+
+/*
+ * Measure the mean cost, in cpu cycles, of a software interrupt over
+ * <iterations> trials, split into entry (raise to handler), body and exit
+ * (handler done to back in the foreground)
+ *
+ * With <fp> set the handler body uses the vfp, so the lazy vfp save and
+ * restore land in the body and exit figures
+ * returns false if the measurement could not be made or the foreground
+ * floating point state was corrupted
+ */
+bool gic_measure_irq_cost(u32 iterations, bool fp, u32 *entry, u32 *body, u32 *leave);
+
+/*
+ * Measure the round trip, in cpu cycles from the pmu cycle counter, of a
+ * software interrupt whose handler does nothing, over <iterations> warm
+ * trials
+ *
+ * <streamlined> selects the streamlined irq entry; otherwise the generic
+ * entry through IRQInterrupt is used. The streamlined entry is selected
+ * again afterwards.
+ * returns false if the measurement could not be made
+ */
+bool gic_measure_round_trip(u32 iterations, bool streamlined, u32 *best, u32 *mean);
+
+/*
+ * Check, with both irq entries, that a nested irq and a fiq preempting an
+ * irq handler run in order and leave the vfp registers of the foreground
+ * and of the preempted handler intact
+ *
+ * Uses software interrupts 13-15 and briefly routes secure interrupts to
+ * fiq, so call it before other interrupts are connected
+ * returns true if every case passed
+ */
+bool gic_irq_selftest(void);
+
 /*
  * Close the gic
  */
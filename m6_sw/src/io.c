@@ -11,6 +11,7 @@
 
 // Include files.
 #include "gic.h"
+#include "fast.h"
 #include <stdio.h>
 
 // Global variables.
@@ -45,7 +46,7 @@ static u32 convertToLEDNum(u32 num) {
  * Inputs: Interrupts handler function pointer.
  * Outputs: None.
  */
-static void btn_handler(void *devp) {
+static FAST_TEXT void btn_handler(void *devp) {
 	// Variable declarations.
 	u32 num;
 	XGpio *dev;
@@ -73,7 +74,7 @@ static void btn_handler(void *devp) {
  * Inputs: Interrupts handler function pointer.
  * Outputs: None.
  */
-static void sw_handler(void *devp) {
+static FAST_TEXT void sw_handler(void *devp) {
 	// Variable declarations.
 	u32 num;
 	s32 diff;
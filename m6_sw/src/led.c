@@ -11,6 +11,7 @@
 
 // Header file inclusions.
 #include "led.h"
+#include "xpm_counter.h"
 
 // Predefined constants.
 #define CHANNEL1 1
@@ -20,6 +21,9 @@ static XGpio port;
 static XGpio rgbPort;
 static XGpioPs PSport;
 
+// Profiling region; build with -DXPM_REGIONS to collect it.
+XPM_REGION_DEFINE(led_set);
+
 /*
  * Calculates the exponent of a function.
  * Inputs: base; exponent
@@ -86,6 +90,8 @@ void led_init(void) {
  * Outputs: none.
  */
 void led_set(u32 led, bool tostate) {
+	XPM_REGION_BEGIN(led_set);
+
 	// Checks validity of arguments; does nothing if invalid argument.
 	if (led >= 0 && (tostate == LED_ON || tostate == LED_OFF)) {
 		// Check to see if turning LED on.
@@ -128,13 +134,16 @@ void led_set(u32 led, bool tostate) {
 			XGpio_DiscreteWrite(&port, CHANNEL1, 0b0000);
 		}
 		// If turning all on.
-		else if (led == ALL && tostate == LEF_ON) {
+		else if (led == ALL && tostate == LED_ON) {
 			// Turn on all LEDs.
 			XGpio_DiscreteWrite(&port, CHANNEL1, XGpio_DiscreteRead(&port, CHANNEL1) | power(2, 0));
 			XGpio_DiscreteWrite(&port, CHANNEL1, XGpio_DiscreteRead(&port, CHANNEL1) | power(2, 1));
 			XGpio_DiscreteWrite(&port, CHANNEL1, XGpio_DiscreteRead(&port, CHANNEL1) | power(2, 2));
 			XGpio_DiscreteWrite(&port, CHANNEL1, XGpio_DiscreteRead(&port, CHANNEL1) | power(2, 3));
+		}
 	}
+
+	XPM_REGION_END(led_set);
 }
 
 /*
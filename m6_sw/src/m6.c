@@ -36,6 +36,16 @@
 #include "gic.h"
 #include "adc.h"
 #include "ttc.h"
+#include "fast.h"
+#include "memmap.h"
+#include "tlsf.h"
+#include "mpool.h"
+#include "stack.h"
+#include "xpm_counter.h"
+#include "xil_sample.h"
+#include "bench.h"
+#include "boottime.h"
+#include "pl.h"
 
 // Predefined constants.
 #define SERVO_MIN 2.5
@@ -43,6 +53,13 @@
 #define PING 1
 #define UPDATE 2
 #define ID 17
+#define NUM_MSGS 4
+#define STACK_CHECK_TICKS 100	/* build with -DSTACK_CHECK to check stack margins every 10 s */
+#define STACK_MIN_MARGIN 256
+#define SAMPLE_RATE_HZ 250		/* build with -DXIL_SAMPLE and the bsp with XIL_SAMPLE=1 to stream pc samples */
+#define SAMPLE_DEPTH 6
+#define SAMPLE_DRAIN 4
+#define CMD_LINE 32
 
 // Various states.
 typedef enum {
@@ -64,24 +81,44 @@ typedef struct {
 	int values[30];
 } update_response_t;
 
-// Global ariables.
-static state_t state;
-static s32 ctr;
-static s32 tlCtr;
-static bool on;
-static bool done;
-static float prevVal;
-static update_response_t updateResponse;
-static XUartPs UART0;
-static u8 numBytes;
-static u8 i;
+// Global ariables; the ones the interrupt callbacks touch live in OCM.
+static state_t state FAST_DATA;
+static s32 ctr FAST_DATA;
+static s32 tlCtr FAST_DATA;
+static bool on FAST_DATA;
+static bool done FAST_DATA;
+#ifdef STACK_CHECK
+static volatile bool stackCheckDue FAST_DATA;
+static u32 stackTicks FAST_DATA;
+#endif
+static float prevVal FAST_DATA;
+static update_response_t *updateResponse FAST_DATA;
+static update_t *volatile updateSending FAST_DATA;
+static update_response_t *volatile responseReady FAST_DATA;
+static mpool_t updatePool FAST_DATA;
+static mpool_t responsePool FAST_DATA;
+static MPOOL_STORAGE(updateStore, update_t, NUM_MSGS);
+static MPOOL_STORAGE(responseStore, update_response_t, NUM_MSGS);
+static XUartPs UART0 FAST_DATA;
+static u8 numBytes FAST_DATA;
+static u8 i FAST_DATA;
+static char cmdLine[CMD_LINE];
+static u32 cmdLen;
+static volatile bool plReport;
+static volatile s32 plStatus;
+static volatile u32 plUs;
+static u32 plBytes;
+
+// Profiling regions; build with -DXPM_REGIONS to collect them.
+XPM_REGION_DEFINE(timer_callback);
+XPM_REGION_DEFINE(handler0);
 
 /*
  * Handles interrupts by invoking built-in interrupt handler.
  * Inputs: Pointer to UART instance.
  * Outputs: None.
  */
-void interruptHandler(void *devP) {
+FAST_TEXT void interruptHandler(void *devP) {
 	// Variable declarations and coercion.
 	XUartPs *dev = (XUartPs *)devP;
 
@@ -95,7 +132,7 @@ void interruptHandler(void *devP) {
  * Inputs: Button that was pushed.
  * Outputs: None.
  */
-void btn_callback(u32 btn) {
+FAST_TEXT void btn_callback(u32 btn) {
 	// Pedestrian mode can only be entered from traffic - pedestrians can cross freely during other modes.
 	if (btn == 0 && state == TRAFFIC) {
 		state = PEDESTRIAN;
@@ -110,12 +147,23 @@ void btn_callback(u32 btn) {
 
 }
 
+/*
+ * Keeps the result of a pl load for the foreground to print.
+ * Inputs: Load status and time in microseconds.
+ * Outputs: None.
+ */
+void pl_callback(s32 status, u32 us) {
+	plStatus = status;
+	plUs = us;
+	plReport = true;
+}
+
 /*
  * This function handles interrupts from switch movements appropriately.
  * Inputs: Switch that was toggled that was pushed.
  * Outputs: None.
  */
-void swt_callback(u32 swt) {
+FAST_TEXT void swt_callback(u32 swt) {
 	// Enter maintenance mode from any mode 
 	if (swt == 0 && state != MAINTENANCE) {
 		printf("Entering maintenance mode.\n");
@@ -152,10 +200,12 @@ void swt_callback(u32 swt) {
  * Inputs: none.
  * Outputs: None.
  */
-void timer_callback(void) {
+FAST_TEXT void timer_callback(void) {
 	// Variable declarations.
 	float val;
-	update_t updateStruct;
+	update_t *update;
+
+	XPM_REGION_BEGIN(timer_callback);
 
 	// Flash LED for maintenance mode.
 	if (state == MAINTENANCE && ctr == 10) {
@@ -279,16 +329,28 @@ void timer_callback(void) {
 		tlCtr++;
 	}
 
-	// Fill in the fields of the update message.
-	updateStruct.type = UPDATE;
-	updateStruct.id = 0;
-	updateStruct.value = 0;
+	// Fill in the fields of the update message, unless the last one is still going out.
+	if (updateSending == NULL && (update = mpool_alloc(&updatePool)) != NULL) {
+		update->type = UPDATE;
+		update->id = 0;
+		update->value = 0;
 
-	// Send the message to UART 0;
-	XUartPs_Send(&UART0, (u8 *)&updateStruct, sizeof(update_t));
+		// Send the message to UART 0; the driver reads the block until handler0 hears the send is done.
+		updateSending = update;
+		XUartPs_Send(&UART0, (u8 *)update, sizeof(update_t));
+	}
 
 	ctr++;
 
+#ifdef STACK_CHECK
+	// Leave the scan itself to the main loop.
+	if (++stackTicks >= STACK_CHECK_TICKS) {
+		stackTicks = 0;
+		stackCheckDue = true;
+	}
+#endif
+
+	XPM_REGION_END(timer_callback);
 }
 
 /*
@@ -296,23 +358,36 @@ void timer_callback(void) {
  * Inputs: Pointer to instance of UART0; interrupt event; data from event.
  * Outputs: None.
  */
-void handler0(void *CallBackRef, u32 Event, u32 EventData) {
+FAST_TEXT void handler0(void *CallBackRef, u32 Event, u32 EventData) {
 	// Variable declarations.
 	u8 buff;
-	int val;
 	u32 num;
 
+	XPM_REGION_BEGIN(handler0);
+
+	// The last update message has left the fifo; its block can go back.
+	if (Event == XUARTPS_EVENT_SENT_DATA) {
+		mpool_free(&updatePool, updateSending);
+		updateSending = NULL;
+	}
+
 	// If the interrupt on UART0 was a receive event.
-	if (Event == XUARTPS_EVENT_RECV_DATA) {
-		// Receive the data on UART0, placing into different parts of the ping depending on what was received.
+	else if (Event == XUARTPS_EVENT_RECV_DATA) {
+		// Take a message buffer at the start of each response.
 		if (numBytes == 0)
-			num = XUartPs_Recv((XUartPs *)CallBackRef, (u8 *)(&updateResponse.type), 1);
+			updateResponse = mpool_alloc(&responsePool);
+
+		// Receive the data on UART0, placing into different parts of the ping depending on what was received.
+		if (updateResponse == NULL)
+			num = XUartPs_Recv((XUartPs *)CallBackRef, (u8 *)&buff, 1);
+		else if (numBytes == 0)
+			num = XUartPs_Recv((XUartPs *)CallBackRef, (u8 *)(&updateResponse->type), 1);
 		else if (numBytes == 4)
-			num = XUartPs_Recv((XUartPs *)CallBackRef, (u8 *)(&updateResponse.id), 1);
+			num = XUartPs_Recv((XUartPs *)CallBackRef, (u8 *)(&updateResponse->id), 1);
 		else if (numBytes == 8)
-			num = XUartPs_Recv((XUartPs *)CallBackRef, (u8 *)(&updateResponse.average), 1);
+			num = XUartPs_Recv((XUartPs *)CallBackRef, (u8 *)(&updateResponse->average), 1);
 		else if (numBytes%4 == 0) {
-			num = XUartPs_Recv((XUartPs *)CallBackRef, (u8 *)(&updateResponse.values[i]), 1);
+			num = XUartPs_Recv((XUartPs *)CallBackRef, (u8 *)(&updateResponse->values[i]), 1);
 			i++;
 		}
 		else
@@ -324,36 +399,20 @@ void handler0(void *CallBackRef, u32 Event, u32 EventData) {
 		// Once a full message has been received.
 		if (numBytes == sizeof(update_response_t)) {
 //			// Print messgage to screen.
-//			printf("Type: %d, ID: %d, Average: %d, Values: {", updateResponse.type, updateResponse.id, updateResponse.average);
+//			printf("Type: %d, ID: %d, Average: %d, Values: {", updateResponse->type, updateResponse->id, updateResponse->average);
 //
 //			for (j = 0; j < 30; j++) {
-//				printf("%d ", updateResponse.values[j]);
+//				printf("%d ", updateResponse->values[j]);
 //			}
 //
 //			printf("}\r\n");
 
-			val = updateResponse.values[ID];
-
-			if (val == 0 && state != TRAIN) {
-				printf("Train arriving.\n");
-				state = TRAIN;
-				tlCtr = 0;
-			}
-			else if (val == 1 && state == TRAIN) {
-				printf("Train passed.\n");
-				state = TRANSITION;
-				tlCtr = 0;
-			}
-			else if (val == 2 && state != MAINTENANCE) {
-				printf("Entering maintenance mode.\n");
-				state = MAINTENANCE;
-				ctr = 0;
-			}
-			else if (val == 3 && state == MAINTENANCE) {
-				printf("Exiting maintenance mode.\n");
-				state = TRANSITION;
-				tlCtr = 0;
-			}
+			// Hand the response to the main loop by pointer; one that arrives while the last is pending, or with no buffer free, is dropped.
+			if (updateResponse != NULL && responseReady == NULL)
+				responseReady = updateResponse;
+			else
+				mpool_free(&responsePool, updateResponse);
+			updateResponse = NULL;
 
 			// Reset counters.
 			numBytes = 0;
@@ -361,8 +420,102 @@ void handler0(void *CallBackRef, u32 Event, u32 EventData) {
 		}
 	}
 
+	XPM_REGION_END(handler0);
+}
+
+/*
+ * Act on a response handed over by handler0 and return its block.
+ * Inputs: None.
+ * Outputs: None.
+ */
+static void response_poll(void) {
+	// Variable declarations.
+	update_response_t *response;
+	const char *msg = NULL;
+	int val;
+
+	if ((response = responseReady) == NULL)
+		return;
+	val = response->values[ID];
+	responseReady = NULL;
+	mpool_free(&responsePool, response);
+
+	// The timer and io callbacks move the state too; keep them out while it changes.
+	Xil_ExceptionDisableMask(XIL_EXCEPTION_IRQ);
+	if (val == 0 && state != TRAIN) {
+		msg = "Train arriving.";
+		state = TRAIN;
+		tlCtr = 0;
+	}
+	else if (val == 1 && state == TRAIN) {
+		msg = "Train passed.";
+		state = TRANSITION;
+		tlCtr = 0;
+	}
+	else if (val == 2 && state != MAINTENANCE) {
+		msg = "Entering maintenance mode.";
+		state = MAINTENANCE;
+		ctr = 0;
+	}
+	else if (val == 3 && state == MAINTENANCE) {
+		msg = "Exiting maintenance mode.";
+		state = TRANSITION;
+		tlCtr = 0;
+	}
+	Xil_ExceptionEnableMask(XIL_EXCEPTION_IRQ);
+
+	if (msg != NULL)
+		printf("%s\n", msg);
 }
 
+/*
+ * Collect a console line without blocking and run it as a command:
+ * "bench" runs every driver benchmark and suite, "bench <name>" runs one
+ * and "bench list" names them; "boot" prints the fsbl boot times again;
+ * "pl <addr> <bytes>" loads the partial bitstream at addr in the background.
+ * Inputs: None.
+ * Outputs: None.
+ */
+static void console_poll(void) {
+	// Variable declarations.
+	char c, *arg;
+	u32 addr;
+	s32 status;
+
+	while (XUartPs_IsReceiveData(STDIN_BASEADDRESS)) {
+		c = (char)XUartPs_RecvByte(STDIN_BASEADDRESS);
+
+		// Gather the line.
+		if (c != '\r' && c != '\n') {
+			if (cmdLen < CMD_LINE - 1)
+				cmdLine[cmdLen++] = c;
+			continue;
+		}
+		cmdLine[cmdLen] = '\0';
+		cmdLen = 0;
+
+		if (strncmp(cmdLine, "bench", 5) == 0 && (cmdLine[5] == ' ' || cmdLine[5] == '\0')) {
+			for (arg = cmdLine + 5; *arg == ' '; arg++);
+			if (strcmp(arg, "list") == 0)
+				bench_list();
+			else
+				bench_run(arg);
+		}
+		else if (strcmp(cmdLine, "boot") == 0)
+			boottime_print();
+		else if (strncmp(cmdLine, "pl ", 3) == 0) {
+			addr = (u32)strtoul(cmdLine + 3, &arg, 0);
+			plBytes = (u32)strtoul(arg, NULL, 0);
+			status = pl_load(addr, plBytes, pl_callback);
+			if (status == XST_DEVICE_BUSY)
+				printf("Error: pl load already running.\n");
+			else if (status != XST_SUCCESS)
+				printf("Error starting pl load (%ld).\n", (long)status);
+		}
+		else if (cmdLine[0] != '\0')
+			printf("Error: unknown command %s.\n", cmdLine);
+	}
+}
 
 int main() {
 	// Variable declarations.
@@ -371,6 +524,13 @@ int main() {
 	// Initialize hardware platform.
 	init_platform();
 
+	// Keep the boot stage times the fsbl left in ocm.
+	boottime_init();
+
+	// Set up the ddr and ocm allocator pools.
+	if (tlsf_pools_init() != XST_SUCCESS)
+		printf("Error initializing allocator pools.\n");
+
 	// Set stdin unbuffeRED + 5, forcing getchar to return immediately when a character is typed.
 	setvbuf(stdin,NULL,_IONBF,0);
 
@@ -381,10 +541,24 @@ int main() {
 	done = false;
 	state = TRAFFIC;
 
+	// Set up the message pools.
+	if (mpool_init(&updatePool, updateStore, sizeof(update_t), NUM_MSGS) != XST_SUCCESS ||
+			mpool_init(&responsePool, responseStore, sizeof(update_response_t), NUM_MSGS) != XST_SUCCESS)
+		printf("Error initializing message pools.\n");
+
+	// Set up the profiling counters.
+	XPM_REGION_INIT();
+
 	// Initialize the gic.
 	if (gic_init() != XST_SUCCESS)
 		printf("Error initializing gic.\n");
 
+	// Build with -DGIC_SELFTEST to check nested and fiq preemption before anything else is connected.
+#ifdef GIC_SELFTEST
+	if (!gic_irq_selftest())
+		printf("Error in interrupt self-test.\n");
+#endif
+
 	// Look up the config of the UART.
 	conf = XUartPs_LookupConfig(XPAR_PS7_UART_0_DEVICE_ID);
 
@@ -434,9 +608,30 @@ int main() {
 	// Initialize interrupts on switches.
 	io_sw_init(swt_callback);
 
+	// Set up the driver benchmarks; run them with "bench" on the console.
+	if (bench_init() != XST_SUCCESS)
+		printf("Error initializing benchmarks.\n");
+
+	// Set up runtime pl reconfiguration; load with "pl" on the console.
+	if (pl_init() != XST_SUCCESS)
+		printf("Error initializing pl reconfiguration.\n");
+
+	// Keep the interrupt path resident in the L2.
+	if (memmap_lock_irq() != XST_SUCCESS)
+		printf("Error locking interrupt path in L2.\n");
+
+	// Measure where a whole-cache flush beats flushing ranges, with the L2 as it will run.
+	memmap_calibrate_flush(false);
+
 	// Start the timer.
 	ttc_start();
 
+#ifdef XIL_SAMPLE
+	// Start the pc sampler; fold the stream on the host with tools/sample_fold.py.
+	if (Xil_SampleStart(SAMPLE_RATE_HZ, SAMPLE_DEPTH) != XST_SUCCESS)
+		printf("Error starting pc sampler.\n");
+#endif
+
 	// Set the gate to open.
 	servo_set(SERVO_MIN);
 
@@ -444,11 +639,44 @@ int main() {
 	led_set(GREEN + 5, LED_ON);
 
 	printf("[hello]\n");
+	boottime_print();
+
+	while (!done) {
+		response_poll();
+		console_poll();
+		pl_poll(PL_TIMEOUT_US);
+		if (plReport) {
+			plReport = false;
+			if (plStatus == XST_SUCCESS)
+				printf("[pl loaded %lu bytes in %lu us]\n", (unsigned long)plBytes, (unsigned long)plUs);
+			else
+				printf("Error loading pl (%ld) after %lu us.\n", (long)plStatus, (unsigned long)plUs);
+		}
+#ifdef STACK_CHECK
+		if (stackCheckDue) {
+			stackCheckDue = false;
+			printf("[stack margin %lu]\n", (unsigned long)stack_check(STACK_MIN_MARGIN));
+		}
+#endif
+#ifdef XIL_SAMPLE
+		Xil_SampleDrain(SAMPLE_DRAIN);
+#endif
+	}
 
-	while (!done);
+#ifdef STACK_CHECK
+	stack_print();
+#endif
+#ifdef XIL_SAMPLE
+	Xil_SampleStop();
+	Xil_SampleDrain(XIL_SAMPLE_RING);
+	Xil_SampleReport();
+#endif
 
 	printf("[done]\n");
 
+	// Report where the time went.
+	XPM_REGION_REPORT();
+
 	// Stop the timer.
 	ttc_stop();
 
@@ -459,6 +687,9 @@ int main() {
 	// Close down the timer.
 	ttc_close();
 
+	// Stop any pl load.
+	pl_close();
+
 	// Close the gic.
 	gic_close();
 
@@ -0,0 +1,398 @@
+/*
+ * memmap.c -- memory attribute profile implementation
+ *
+ * Author: Joshua M. Meise
+ * Created: 10-19-2026
+ * Version: 1.0
+ *
+ * Description: Applies a memory attribute profile to the application
+ * memory map through Xil_SetTlbAttributes, and benchmarks each profile.
+ */
+
+// Library inclusions.
+#include <string.h>
+#include "memmap.h"
+#include "xtime_l.h"
+#include "xil_io.h"
+#include "xil_cache.h"
+#include "xil_cache_l.h"
+#include "xil_mem.h"
+#include "xstatus.h"
+#include "gic.h"
+
+// Predefined constants.
+#define SECTION_SIZE 0x100000U
+#define XN (0x1U << 4)			/* execute never */
+#define DDR_END 0x40000000U
+#define OCM_BASE 0xFFF00000U
+#define OCM_DEFAULT 0x4C0EU		/* inner write-back, as in translation_table.S */
+#define BENCH_SIZE 0x10000U
+#define BENCH_REPS 8
+#define LOCK_WAYS 2				/* 128KB of the 512KB L2 */
+#define THRASH_SIZE 0x100000U	/* twice the L2 */
+#define THRASH_TRIALS 200
+#define CAL_MIN 0x1000U			/* smallest flush calibrated */
+#define CAL_RANGES 4			/* ranges per batched flush */
+#define COPY_MAX 0x10000U		/* largest copy benchmarked */
+#define COPY_BYTES 0x100000U	/* bytes moved per measurement */
+
+// Linker symbols (lscript.ld).
+extern u8 __dma_buf_start[];
+extern u8 __dma_buf_end[];
+extern u8 __irq_text_start[];
+extern u8 __irq_text_end[];
+extern u8 __fast_text_start[];
+extern u8 __fast_text_end[];
+extern u8 __fast_data_start[];
+extern u8 __fast_data_end[];
+extern u8 _irq_stack_end[];
+extern u8 __irq_stack[];
+
+// A region of the memory map and its attribute in each profile.
+typedef struct {
+	const char *name;
+	u32 base;
+	u32 size;
+	u32 attr[MEMMAP_NUM_PROFILES];
+} region_t;
+
+// Global variables.
+static memmap_profile_t current = MEMMAP_DEFAULT;
+static u32 benchBuf[BENCH_SIZE/sizeof(u32)];
+static u32 benchDma[BENCH_SIZE/sizeof(u32)] MEMMAP_DMA;
+static u32 thrashBuf[THRASH_SIZE/sizeof(u32)];
+static u8 ocmBuf[COPY_MAX + 32] MEMMAP_OCM;
+
+/*
+ * Apply an attribute to every section touched by [base, base+size).
+ * Inputs: base address, size in bytes, attribute.
+ * Outputs: None.
+ */
+static void set_range(u32 base, u32 size, u32 attr) {
+	// Variable declarations.
+	u32 addr;
+	u32 end;
+
+	// Round out to whole sections.
+	addr = base & ~(SECTION_SIZE - 1U);
+	end = base + size;
+
+	for (; addr < end && addr >= (base & ~(SECTION_SIZE - 1U)); addr += SECTION_SIZE)
+		Xil_SetTlbAttributes(addr, attr);
+}
+
+/*
+ * Apply a profile to the memory map.
+ * Inputs: Profile.
+ * Outputs: None.
+ */
+void memmap_apply(memmap_profile_t profile) {
+	// Variable declarations.
+	region_t regions[] = {
+		// Code, data, heap and stacks of the application image.
+		{ "ddr", XPAR_PS7_DDR_0_S_AXI_BASEADDR, (u32)(UINTPTR)__dma_buf_start - XPAR_PS7_DDR_0_S_AXI_BASEADDR,
+		  { NORM_WB_CACHE, NORM_WB_CACHE, NORM_NONCACHE } },
+		// Buffers shared with dma masters; kept coherent by being uncached.
+		{ "dma", (u32)(UINTPTR)__dma_buf_start, (u32)(__dma_buf_end - __dma_buf_start),
+		  { NORM_WB_CACHE, NORM_NONCACHE, NORM_NONCACHE } },
+		// On-chip memory for interrupt stacks and hot data.
+		{ "ocm", OCM_BASE, SECTION_SIZE,
+		  { OCM_DEFAULT, NORM_WB_CACHE, OCM_DEFAULT } },
+		// AXI gpio, timer and xadc in the pl; device memory allows posted writes.
+		{ "gpio", XPAR_AXI_GPIO_0_BASEADDR, SECTION_SIZE,
+		  { STRONG_ORDERED, DEVICE_MEMORY | XN, STRONG_ORDERED } },
+		{ "timer", XPAR_AXI_TIMER_0_BASEADDR, SECTION_SIZE,
+		  { STRONG_ORDERED, DEVICE_MEMORY | XN, STRONG_ORDERED } },
+		{ "xadc", XPAR_XADC_WIZ_0_BASEADDR, SECTION_SIZE,
+		  { STRONG_ORDERED, DEVICE_MEMORY | XN, STRONG_ORDERED } },
+	};
+	u32 r;
+
+	if (profile >= MEMMAP_NUM_PROFILES)
+		return;
+
+	for (r = 0; r < sizeof(regions)/sizeof(regions[0]); r++) {
+		// Leave regions that do not change alone; each call flushes the cache.
+		if (regions[r].attr[profile] == regions[r].attr[current] && profile != MEMMAP_DEFAULT)
+			continue;
+		set_range(regions[r].base, regions[r].size, regions[r].attr[profile]);
+	}
+
+	current = profile;
+}
+
+/*
+ * Get the current profile.
+ * Inputs: None.
+ * Outputs: Profile.
+ */
+memmap_profile_t memmap_get(void) {
+	return current;
+}
+
+/*
+ * Add a range to a lock list if it lives in DDR.
+ * Inputs: List, number of entries so far, start and end of the range.
+ * Outputs: New number of entries.
+ */
+static u32 add_lock(Xil_CacheRange *regions, u32 n, u8 *start, u8 *end) {
+	if (end > start && (UINTPTR)start < DDR_END) {
+		regions[n].Addr = (INTPTR)start;
+		regions[n].Len = (u32)(end - start);
+		n++;
+	}
+	return n;
+}
+
+/*
+ * Lock the interrupt path in the L2.
+ * Inputs: None.
+ * Outputs: XST_SUCCESS or XST_FAILURE.
+ */
+s32 memmap_lock_irq(void) {
+	// Variable declarations.
+	Xil_CacheRange regions[4];
+	u32 n;
+
+	n = add_lock(regions, 0, __irq_text_start, __irq_text_end);
+	n = add_lock(regions, n, __fast_text_start, __fast_text_end);
+	n = add_lock(regions, n, __fast_data_start, __fast_data_end);
+	n = add_lock(regions, n, _irq_stack_end, __irq_stack);
+
+	return Xil_L2CacheLock(regions, n, LOCK_WAYS);
+}
+
+/*
+ * Unlock the interrupt path.
+ * Inputs: None.
+ * Outputs: None.
+ */
+void memmap_unlock_irq(void) {
+	Xil_L2CacheUnlock();
+}
+
+/*
+ * Benchmark latency jitter with and without the L2 lock.
+ * Inputs: None.
+ * Outputs: None.
+ */
+void memmap_lock_bench(void) {
+	// Variable declarations.
+	bool locked;
+	u32 pass, n, j, lat, best, worst;
+	volatile u32 sum;
+
+	locked = Xil_L2CacheGetLockedWays() != 0U;
+
+	printf("[l2lock locked best worst jitter]\n");
+
+	for (pass = 0; pass < 2; pass++) {
+		if (pass == 0)
+			memmap_unlock_irq();
+		else if (memmap_lock_irq() != XST_SUCCESS) {
+			printf("[l2lock failed]\n");
+			break;
+		}
+
+		for (best = 0xFFFFFFFFU, worst = 0, n = 0; n < THRASH_TRIALS; n++) {
+			// Stream twice the L2 through the cache to evict everything unlocked.
+			for (j = 0, sum = 0; j < THRASH_SIZE/sizeof(u32); j += 8)
+				sum += thrashBuf[j];
+
+			lat = gic_measure_latency(1, false);
+			if (lat < best)
+				best = lat;
+			if (lat > worst)
+				worst = lat;
+		}
+
+		printf("[l2lock %lu %lu %lu %lu]\n", (unsigned long)pass, (unsigned long)best,
+				(unsigned long)worst, (unsigned long)(worst - best));
+	}
+
+	if (locked)
+		memmap_lock_irq();
+	else
+		memmap_unlock_irq();
+}
+
+/*
+ * Convert a global timer interval to cpu cycles.
+ * Inputs: Start and end times.
+ * Outputs: Cycles.
+ */
+static u32 cycles(XTime start, XTime end) {
+	return (u32)((end - start) * (XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / COUNTS_PER_SECOND));
+}
+
+/*
+ * Write every line of the first <size> bytes of the thrash buffer.
+ * Inputs: Size in bytes.
+ * Outputs: None.
+ */
+static void dirty(u32 size) {
+	// Variable declarations.
+	u32 j;
+
+	for (j = 0; j < size/sizeof(u32); j += 8)
+		thrashBuf[j] = j;
+}
+
+/*
+ * Calibrate the whole-cache flush threshold.
+ * Inputs: Whether to print the measurements.
+ * Outputs: Threshold chosen.
+ */
+u32 memmap_calibrate_flush(bool verbose) {
+	// Variable declarations.
+	Xil_CacheRange ranges[CAL_RANGES];
+	XTime start, end;
+	u32 size, r, ranged, full;
+	u32 threshold = 0xFFFFFFFFU;
+
+	if (verbose)
+		printf("[flushcal size ranged full]\n");
+
+	for (size = CAL_MIN; size <= THRASH_SIZE; size <<= 1) {
+		// Line by line over <size> bytes split into a few ranges.
+		dirty(size);
+		for (r = 0; r < CAL_RANGES; r++) {
+			ranges[r].Addr = (INTPTR)((u8 *)thrashBuf + r * (size / CAL_RANGES));
+			ranges[r].Len = size / CAL_RANGES;
+		}
+		Xil_DCacheSetFlushThreshold(0xFFFFFFFFU);
+		XTime_GetTime(&start);
+		Xil_DCacheFlushRanges(ranges, CAL_RANGES);
+		XTime_GetTime(&end);
+		ranged = cycles(start, end);
+
+		// Whole cache by set/way with the same lines dirty.
+		dirty(size);
+		XTime_GetTime(&start);
+		Xil_DCacheFlush();
+		XTime_GetTime(&end);
+		full = cycles(start, end);
+
+		if (verbose)
+			printf("[flushcal %lu %lu %lu]\n", (unsigned long)size, (unsigned long)ranged,
+					(unsigned long)full);
+
+		if (full <= ranged && threshold == 0xFFFFFFFFU)
+			threshold = size;
+	}
+
+	Xil_DCacheSetFlushThreshold(threshold);
+	if (verbose)
+		printf("[flushcal threshold %lu]\n", (unsigned long)threshold);
+
+	return threshold;
+}
+
+/*
+ * Copy bandwidth of one configuration.
+ * Inputs: Destination, source, size of each copy.
+ * Outputs: MB/s.
+ */
+static u32 copy_rate(void *dst, const void *src, u32 size) {
+	// Variable declarations.
+	XTime start, end;
+	u32 n, reps, c;
+
+	reps = COPY_BYTES / size;
+
+	// Warm the caches and branch predictor first.
+	memcpy(dst, src, size);
+
+	XTime_GetTime(&start);
+	for (n = 0; n < reps; n++)
+		memcpy(dst, src, size);
+	XTime_GetTime(&end);
+
+	c = cycles(start, end);
+	if (c == 0)
+		return 0;
+
+	return (u32)((u64)size * reps * (XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / 1000000U) / c);
+}
+
+/*
+ * Benchmark memcpy bandwidth.
+ * Inputs: None.
+ * Outputs: None.
+ */
+void memmap_copy_bench(void) {
+	// Variable declarations.
+	static const u32 aligns[] = { 0, 1, 4, 8 };
+	const u8 *srcs[2];
+	static const char *srcNames[2] = { "ddr", "ocm" };
+	u32 neon, src, size, a, newlibRate, neonRate;
+
+	neon = Xil_MemNeonEnabled();
+	srcs[0] = (const u8 *)thrashBuf;
+	srcs[1] = ocmBuf;
+
+	printf("[memcpy src size align newlib neon]\n");
+
+	for (src = 0; src < 2; src++) {
+		for (size = 64; size <= COPY_MAX; size <<= 2) {
+			for (a = 0; a < sizeof(aligns)/sizeof(aligns[0]); a++) {
+				Xil_MemNeonEnable(0);
+				newlibRate = copy_rate(benchBuf, srcs[src] + aligns[a], size);
+				Xil_MemNeonEnable(1);
+				neonRate = Xil_MemNeonEnabled() ? copy_rate(benchBuf, srcs[src] + aligns[a], size) : 0;
+
+				printf("[memcpy %s %lu %lu %lu %lu]\n", srcNames[src], (unsigned long)size,
+						(unsigned long)aligns[a], (unsigned long)newlibRate, (unsigned long)neonRate);
+			}
+		}
+	}
+
+	Xil_MemNeonEnable(neon);
+}
+
+/*
+ * Benchmark each profile.
+ * Inputs: None.
+ * Outputs: None.
+ */
+void memmap_bench(void) {
+	// Variable declarations.
+	static const char *names[MEMMAP_NUM_PROFILES] = { "default", "app", "uncached" };
+	XTime start, end;
+	u32 p, j, k;
+	volatile u32 sum;
+	u32 walk, copy, gpio;
+
+	printf("[memmap profile walk copy gpio]\n");
+
+	for (p = 0; p < MEMMAP_NUM_PROFILES; p++) {
+		memmap_apply((memmap_profile_t)p);
+
+		// Sequential read of a 64KB ddr buffer.
+		XTime_GetTime(&start);
+		for (k = 0, sum = 0; k < BENCH_REPS; k++)
+			for (j = 0; j < BENCH_SIZE/sizeof(u32); j++)
+				sum += benchBuf[j];
+		XTime_GetTime(&end);
+		walk = cycles(start, end) / BENCH_REPS;
+
+		// Copy from the dma window into ddr.
+		XTime_GetTime(&start);
+		for (k = 0; k < BENCH_REPS; k++)
+			memcpy(benchBuf, benchDma, BENCH_SIZE);
+		XTime_GetTime(&end);
+		copy = cycles(start, end) / BENCH_REPS;
+
+		// Back to back writes to the led gpio.
+		XTime_GetTime(&start);
+		for (j = 0; j < 1000; j++)
+			Xil_Out32(XPAR_AXI_GPIO_0_BASEADDR, 0);
+		XTime_GetTime(&end);
+		gpio = cycles(start, end) / 1000;
+
+		printf("[memmap %s %lu %lu %lu]\n", names[p], (unsigned long)walk,
+				(unsigned long)copy, (unsigned long)gpio);
+	}
+
+	memmap_apply(MEMMAP_APP);
+}
@@ -0,0 +1,84 @@
+/*
+ * memmap.h -- memory attribute profile interface
+ *
+ * The MMU maps memory in 1MB sections; every region below is rounded
+ * out to whole sections before its attributes are changed.
+ */
+#pragma once
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "xparameters.h"  	/* constants used by the hardware */
+#include "xil_types.h"		/* types used by xilinx */
+#include "xil_mmu.h"		/* section attributes */
+
+/* place a buffer in the non-cacheable dma window (see lscript.ld) */
+#define MEMMAP_DMA __attribute__((section(".dma_buf"), aligned(32)))
+
+/* place a buffer in the low on-chip memory (see lscript.ld) */
+#define MEMMAP_OCM __attribute__((section(".ocm_buf"), aligned(32)))
+
+/* memory attribute profiles */
+typedef enum {
+	MEMMAP_DEFAULT,		/* translation_table.S defaults */
+	MEMMAP_APP,			/* tuned map used by the application */
+	MEMMAP_UNCACHED,	/* application image uncached (benchmark baseline) */
+	MEMMAP_NUM_PROFILES
+} memmap_profile_t;
+
+/*
+ * Apply <profile> to the application memory map
+ *
+ * Caches are flushed and the TLB invalidated as each section changes.
+ */
+void memmap_apply(memmap_profile_t profile);
+
+/*
+ * Get the profile currently applied
+ */
+memmap_profile_t memmap_get(void);
+
+/*
+ * Preload the DDR-resident interrupt path into reserved L2 ways and lock it
+ *
+ * OCM is not cached by the L2, so only the parts of the interrupt path
+ * linked into DDR are locked.
+ * returns XST_SUCCESS on success; otherwise XST_FAILURE
+ */
+s32 memmap_lock_irq(void);
+
+/*
+ * Release the L2 ways locked by memmap_lock_irq
+ */
+void memmap_unlock_irq(void);
+
+/*
+ * Measure interrupt latency jitter with a cache-thrashing load between
+ * trials, with and without the interrupt path locked in the L2; the lock
+ * state on entry is restored
+ */
+void memmap_lock_bench(void);
+
+/*
+ * Time batched line-by-line flushes against a whole-cache flush for
+ * sizes from 4KB up to 1MB and set the Xil_DCacheFlushRanges threshold to
+ * the first size where the whole-cache flush wins; the threshold is left
+ * unlimited if it never does
+ *
+ * With <verbose> set each size is printed; otherwise nothing is.
+ * returns the threshold chosen
+ */
+u32 memmap_calibrate_flush(bool verbose);
+
+/*
+ * Measure memcpy bandwidth in MB/s for ddr->ddr and ocm->ddr copies over
+ * a range of sizes and source alignments, with the newlib and the NEON
+ * copy; the copy selection on entry is restored
+ */
+void memmap_copy_bench(void);
+
+/*
+ * Run representative workloads under every profile and print the
+ * cycle count of each; the MEMMAP_APP profile is left applied
+ */
+void memmap_bench(void);
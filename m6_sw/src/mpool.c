@@ -0,0 +1,236 @@
+/*
+ * mpool.c -- fixed-block message pool implementation
+ *
+ * Author: Joshua M. Meise
+ * Created: 10-19-2026
+ * Version: 1.0
+ *
+ * Description: Lock-free fixed-block pool. The free list head and the
+ * occupancy counters are updated with load/store-exclusive loops.
+ */
+
+// Library inclusions.
+#include "mpool.h"
+#include "xtime_l.h"
+#include "xstatus.h"
+#include "xil_cache.h"
+#include "fast.h"
+
+// Predefined constants.
+#define BENCH_BLOCKS 16
+#define BENCH_ITERATIONS 1000
+
+// Free blocks hold the link to the next one.
+typedef struct mpool_node {
+	struct mpool_node *next;
+} mpool_node_t;
+
+// Global variables.
+static MPOOL_STORAGE(benchStore, u32[8], BENCH_BLOCKS);
+static mpool_t benchPool;
+
+/*
+ * Load-exclusive a word.
+ * Inputs: Address.
+ * Outputs: Value.
+ */
+static inline u32 ldrex(volatile void *addr) {
+	// Variable declarations.
+	u32 val;
+
+	__asm__ __volatile__("ldrex %0, [%1]" : "=&r"(val) : "r"(addr) : "memory");
+	return val;
+}
+
+/*
+ * Store-exclusive a word.
+ * Inputs: Address, value.
+ * Outputs: 0 if the store happened; 1 if the reservation was lost.
+ */
+static inline u32 strex(volatile void *addr, u32 val) {
+	// Variable declarations.
+	u32 fail;
+
+	__asm__ __volatile__("strex %0, %2, [%1]" : "=&r"(fail) : "r"(addr), "r"(val) : "memory");
+	return fail;
+}
+
+/*
+ * Drop an exclusive reservation.
+ * Inputs: None.
+ * Outputs: None.
+ */
+static inline void clrex(void) {
+	__asm__ __volatile__("clrex" ::: "memory");
+}
+
+/*
+ * Order the block contents against the list update.
+ * Inputs: None.
+ * Outputs: None.
+ */
+static inline void barrier(void) {
+	__asm__ __volatile__("dmb ish" ::: "memory");
+}
+
+/*
+ * Atomically add to a counter.
+ * Inputs: Counter, amount.
+ * Outputs: New value.
+ */
+static inline u32 atomic_add(volatile u32 *ctr, u32 n) {
+	// Variable declarations.
+	u32 val;
+
+	do {
+		val = ldrex(ctr) + n;
+	} while (strex(ctr, val));
+
+	return val;
+}
+
+/*
+ * Create a pool.
+ * Inputs: Pool, aligned storage, block size, number of blocks.
+ * Outputs: XST_SUCCESS or XST_FAILURE.
+ */
+s32 mpool_init(mpool_t *pool, void *mem, u32 blockSize, u32 count) {
+	// Variable declarations.
+	u8 *block;
+	u32 n;
+
+	if (mem == NULL || count == 0 || ((UINTPTR)mem & (MPOOL_LINE - 1U)) != 0)
+		return XST_FAILURE;
+
+	blockSize = MPOOL_BLOCK_SIZE(blockSize < sizeof(mpool_node_t) ? sizeof(mpool_node_t) : blockSize);
+
+	pool->start = mem;
+	pool->end = (u8 *)mem + blockSize * count;
+	pool->blockSize = blockSize;
+	pool->count = count;
+	pool->inUse = 0;
+	pool->highWater = 0;
+	pool->failures = 0;
+
+	// Thread every block onto the free list in address order.
+	for (n = 0, block = mem; n < count; n++, block += blockSize)
+		((mpool_node_t *)block)->next = (n + 1 < count) ? (mpool_node_t *)(block + blockSize) : NULL;
+
+	barrier();
+	pool->head = mem;
+
+	return XST_SUCCESS;
+}
+
+/*
+ * Take a block.
+ * Inputs: Pool.
+ * Outputs: Block or NULL.
+ */
+FAST_TEXT void *mpool_alloc(mpool_t *pool) {
+	// Variable declarations.
+	mpool_node_t *head;
+	u32 used, high;
+
+	do {
+		head = (mpool_node_t *)(UINTPTR)ldrex(&pool->head);
+		if (head == NULL) {
+			clrex();
+			atomic_add(&pool->failures, 1);
+			return NULL;
+		}
+	} while (strex(&pool->head, (u32)(UINTPTR)head->next));
+	barrier();
+
+	// Occupancy; the high-water mark only ever rises.
+	used = atomic_add(&pool->inUse, 1);
+	do {
+		high = ldrex(&pool->highWater);
+		if (used <= high) {
+			clrex();
+			break;
+		}
+	} while (strex(&pool->highWater, used));
+
+	return head;
+}
+
+/*
+ * Return a block.
+ * Inputs: Pool, block.
+ * Outputs: None.
+ */
+FAST_TEXT void mpool_free(mpool_t *pool, void *block) {
+	// Variable declarations.
+	mpool_node_t *node = block;
+
+	if (block == NULL)
+		return;
+
+	// Writes to the block, and the link itself, must be visible before the strex publishes it.
+	do {
+		node->next = (mpool_node_t *)(UINTPTR)ldrex(&pool->head);
+		barrier();
+	} while (strex(&pool->head, (u32)(UINTPTR)node));
+
+	atomic_add(&pool->inUse, (u32)-1);
+}
+
+/*
+ * Print occupancy counters.
+ * Inputs: Name, pool.
+ * Outputs: None.
+ */
+void mpool_print(const char *name, mpool_t *pool) {
+	printf("[mpool %s block %lu count %lu used %lu high %lu failed %lu]\n", name,
+			(unsigned long)pool->blockSize, (unsigned long)pool->count, (unsigned long)pool->inUse,
+			(unsigned long)pool->highWater, (unsigned long)pool->failures);
+}
+
+/*
+ * Benchmark alloc+free.
+ * Inputs: None.
+ * Outputs: None.
+ */
+void mpool_bench(void) {
+	// Variable declarations.
+	XTime start, end;
+	u32 n, c, best, total;
+	void *block;
+
+	if (mpool_init(&benchPool, benchStore, sizeof(u32[8]), BENCH_BLOCKS) != XST_SUCCESS) {
+		printf("Error initializing benchmark pool.\n");
+		return;
+	}
+
+	printf("[mpool case mean best]\n");
+
+	// Hot: the list head and block stay in the L1.
+	for (n = 0, total = 0, best = 0xFFFFFFFFU; n < BENCH_ITERATIONS; n++) {
+		XTime_GetTime(&start);
+		block = mpool_alloc(&benchPool);
+		mpool_free(&benchPool, block);
+		XTime_GetTime(&end);
+		c = (u32)((end - start) * (XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / COUNTS_PER_SECOND));
+		total += c;
+		if (c < best)
+			best = c;
+	}
+	printf("[mpool hot %lu %lu]\n", (unsigned long)(total / BENCH_ITERATIONS), (unsigned long)best);
+
+	// Cold: pool and counters evicted before each pair.
+	for (n = 0, total = 0, best = 0xFFFFFFFFU; n < BENCH_ITERATIONS / 10; n++) {
+		Xil_DCacheFlush();
+		XTime_GetTime(&start);
+		block = mpool_alloc(&benchPool);
+		mpool_free(&benchPool, block);
+		XTime_GetTime(&end);
+		c = (u32)((end - start) * (XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / COUNTS_PER_SECOND));
+		total += c;
+		if (c < best)
+			best = c;
+	}
+	printf("[mpool cold %lu %lu]\n", (unsigned long)(total / (BENCH_ITERATIONS / 10)), (unsigned long)best);
+
+	mpool_print("bench", &benchPool);
+}
@@ -0,0 +1,65 @@
+/*
+ * mpool.h -- fixed-block message pool interface
+ *
+ * Blocks are handed out from a singly linked free list updated with
+ * ldrex/strex, so alloc and free never mask interrupts and may be called
+ * from any interrupt level (or the other core). An interrupted update
+ * simply retries; the exclusive monitor rules out the ABA problem.
+ *
+ * Blocks are rounded up to whole cache lines and the storage is
+ * cache-line aligned, so cache maintenance on one block never touches
+ * its neighbours.
+ */
+#pragma once
+
+#include <stdio.h>
+#include "xil_types.h"		/* types used by xilinx */
+
+#define MPOOL_LINE 32U												/* cortex-a9 cache line */
+#define MPOOL_BLOCK_SIZE(size) (((size) + MPOOL_LINE - 1U) & ~(MPOOL_LINE - 1U))
+
+/* storage for <count> blocks of <type>, suitably aligned */
+#define MPOOL_STORAGE(name, type, count) \
+	u8 name[(count) * MPOOL_BLOCK_SIZE(sizeof(type))] __attribute__((aligned(MPOOL_LINE)))
+
+/* a pool of equal-sized blocks */
+typedef struct {
+	void *volatile head;		/* first free block */
+	u8 *start;
+	u8 *end;
+	u32 blockSize;
+	u32 count;
+	volatile u32 inUse;
+	volatile u32 highWater;
+	volatile u32 failures;
+} mpool_t;
+
+/*
+ * Create a pool of <count> blocks of <blockSize> bytes (rounded up to a
+ * cache line) over <mem>, which must be cache-line aligned and hold
+ * count * MPOOL_BLOCK_SIZE(blockSize) bytes
+ * returns XST_SUCCESS on success; otherwise XST_FAILURE
+ */
+s32 mpool_init(mpool_t *pool, void *mem, u32 blockSize, u32 count);
+
+/*
+ * Take a block from <pool>
+ * returns the block, or NULL if the pool is empty
+ */
+void *mpool_alloc(mpool_t *pool);
+
+/*
+ * Return a block to <pool>; NULL is ignored
+ */
+void mpool_free(mpool_t *pool, void *block);
+
+/*
+ * Print the occupancy counters of <pool> under <name>
+ */
+void mpool_print(const char *name, mpool_t *pool);
+
+/*
+ * Measure the cost of an alloc+free pair in cycles, uncontended and with
+ * a cold free list
+ */
+void mpool_bench(void);
@@ -0,0 +1,143 @@
+/*
+ * pl.c -- runtime reconfiguration of the programmable logic
+ *
+ * Author: Joshua M. Meise
+ * Created: 10-19-2026
+ * Version: 1.0
+ *
+ * Description: Implementation of functions listed in pl.h. The load is a
+ * single pcap dma command started with XDcfg_TransferAsync; the devcfg
+ * interrupt reports it done, or failed, through pl_done.
+ */
+
+// Library inclusions.
+#include "pl.h"
+#include "gic.h"
+#include "xdevcfg.h"
+#include "xil_cache.h"
+#include "xtime_l.h"
+#include "xparameters.h"
+
+// Predefined constants.
+#define PL_LAST_TRANSFER 1U		/* marks the last dma command of the load */
+#define PL_ERRORS (XDCFG_IXR_ERROR_FLAGS_MASK & ~XDCFG_IXR_AXI_WTO_MASK)	/* as the fsbl */
+
+// Global variables.
+static XDcfg dcfg;
+static pl_callback_t plCallback;
+static XTime plStarted;
+
+/*
+ * Convert global timer counts to microseconds.
+ * Inputs: Counts.
+ * Outputs: Microseconds.
+ */
+static u32 to_us(XTime counts) {
+	return (u32)((counts * 1000000U) / COUNTS_PER_SECOND);
+}
+
+/*
+ * Completion handler of the devcfg transfer; runs in the devcfg interrupt,
+ * or in pl_poll when a load is cancelled.
+ * Inputs: Unused reference, transfer status, interrupt events seen.
+ * Outputs: None.
+ */
+static void pl_done(void *ref, u32 status, u32 events) {
+	// Variable declarations.
+	XTime now;
+
+	XTime_GetTime(&now);
+	if (plCallback != NULL)
+		plCallback((s32)status, to_us(now - plStarted));
+}
+
+/*
+ * Initialize the devcfg driver and connect its interrupt.
+ * Inputs: None.
+ * Outputs: XST_SUCCESS or XST_FAILURE.
+ */
+s32 pl_init(void) {
+	// Variable declarations.
+	XDcfg_Config *conf;
+
+	// Look up and initialize the devcfg.
+	conf = XDcfg_LookupConfig(XPAR_XDCFG_0_DEVICE_ID);
+	if (conf == NULL || XDcfg_CfgInitialize(&dcfg, conf, conf->BaseAddr) != XST_SUCCESS)
+		return XST_FAILURE;
+
+	// Fail a load on the same errors the fsbl checks.
+	XDcfg_SetAsyncErrorMask(&dcfg, PL_ERRORS);
+	XDcfg_SetDoneHandler(&dcfg, (void *)pl_done, NULL);
+
+	// Devcfg events reach the gic only while a load runs.
+	XDcfg_IntrDisable(&dcfg, XDCFG_IXR_ALL_MASK);
+	XDcfg_IntrClear(&dcfg, XDCFG_IXR_ALL_MASK);
+
+	return gic_connect(XPAR_XDCFG_0_INTR, (Xil_InterruptHandler)XDcfg_InterruptHandler, &dcfg);
+}
+
+/*
+ * Start a partial bitstream load.
+ * Inputs: Address and length in bytes of the bitstream, completion callback.
+ * Outputs: XST_SUCCESS once started, XST_DEVICE_BUSY, XST_INVALID_PARAM or XST_FAILURE.
+ */
+s32 pl_load(u32 addr, u32 bytes, pl_callback_t callback) {
+	// Variable declarations.
+	u32 status;
+
+	if (bytes == 0 || ((addr | bytes) & 0x3U) != 0)
+		return XST_INVALID_PARAM;
+	if (XDcfg_IsTransferPending(&dcfg))
+		return XST_DEVICE_BUSY;
+
+	// The dma reads ddr, not the cache.
+	Xil_DCacheFlushRange(addr, bytes);
+
+	// Configure the pl through the pcap rather than the icap.
+	XDcfg_EnablePCAP(&dcfg);
+	XDcfg_SelectPcapInterface(&dcfg);
+
+	plCallback = callback;
+	XTime_GetTime(&plStarted);
+
+	// A partial bitstream does not raise pl done again; wait for the dma and pcap.
+	status = XDcfg_TransferAsync(&dcfg, (void *)(addr | PL_LAST_TRANSFER), bytes >> 2,
+			(void *)XDCFG_DMA_INVALID_ADDRESS, 0, XDCFG_NON_SECURE_PCAP_WRITE, XDCFG_ASYNC_D_P_DONE);
+	return (s32)status;
+}
+
+/*
+ * Is a load running.
+ * Inputs: None.
+ * Outputs: True while the dma or pcap is busy with a load.
+ */
+bool pl_busy(void) {
+	return XDcfg_IsTransferPending(&dcfg) != 0;
+}
+
+/*
+ * Cancel a load that has run too long.
+ * Inputs: Timeout in microseconds.
+ * Outputs: None.
+ */
+void pl_poll(u32 timeoutUs) {
+	// Variable declarations.
+	XTime now;
+
+	if (!XDcfg_IsTransferPending(&dcfg))
+		return;
+
+	XTime_GetTime(&now);
+	if (to_us(now - plStarted) > timeoutUs)
+		(void)XDcfg_TransferCancel(&dcfg);
+}
+
+/*
+ * Cancel any load and disconnect the interrupt.
+ * Inputs: None.
+ * Outputs: None.
+ */
+void pl_close(void) {
+	(void)XDcfg_TransferCancel(&dcfg);
+	gic_disconnect(XPAR_XDCFG_0_INTR);
+}
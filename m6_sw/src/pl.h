@@ -0,0 +1,55 @@
+/*
+ * pl.h -- runtime reconfiguration of the programmable logic
+ *
+ * A partial bitstream already in ddr (bootgen -process_bitstream bin, so
+ * word aligned and byte swapped for the pcap) is sent to the pl through the
+ * pcap with the devcfg asynchronous transfer API. pl_load returns as soon
+ * as the dma is started; the devcfg interrupt completes the load and calls
+ * the callback. The pl keeps running and is not reset, so only partial
+ * bitstreams for a reconfigurable region may be loaded this way.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include "xil_types.h"		/* types used by xilinx */
+
+#define PL_TIMEOUT_US 1000000U	/* a load still running after this is cancelled */
+
+/*
+ * Called once per load, in interrupt context, with XST_SUCCESS,
+ * XST_FAILURE on a pcap error or XST_TIMEOUT, and the time the load took
+ */
+typedef void (*pl_callback_t)(s32 status, u32 us);
+
+/*
+ * Initialize the devcfg driver and connect its interrupt
+ *
+ * Call after gic_init
+ * returns XST_SUCCESS on success; otherwise XST_FAILURE
+ */
+s32 pl_init(void);
+
+/*
+ * Start loading the partial bitstream of <bytes> bytes at <addr>
+ *
+ * returns XST_SUCCESS once the dma is started, XST_DEVICE_BUSY while an
+ * earlier load runs, XST_INVALID_PARAM for an unaligned or empty
+ * bitstream; otherwise XST_FAILURE
+ */
+s32 pl_load(u32 addr, u32 bytes, pl_callback_t callback);
+
+/*
+ * Is a load running
+ */
+bool pl_busy(void);
+
+/*
+ * Cancel a load that has run longer than <timeoutUs>; call it from the
+ * foreground loop
+ */
+void pl_poll(u32 timeoutUs);
+
+/*
+ * Cancel any load and disconnect the interrupt
+ */
+void pl_close(void);
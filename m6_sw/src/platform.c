@@ -34,6 +34,7 @@
 #include "xil_cache.h"
 
 #include "platform_config.h"
+#include "memmap.h"
 
 /*
  * Uncomment one of the following two lines, depending on the target,
@@ -62,6 +63,8 @@ enable_caches()
 #ifdef XPAR_MICROBLAZE_USE_DCACHE
     Xil_DCacheEnable();
 #endif
+#elif __arm__
+    memmap_apply(MEMMAP_APP);
 #endif
 }
 
@@ -13,6 +13,7 @@
 
 // Global variables.
 static XTmrCtr servoTimer;
+static double servoDuty;
 
 /*
  * Initialize the servo, setting the duty cycle to 7.5%.
@@ -33,6 +34,7 @@ void servo_init(void) {
 
 	// Set a duty cycle of 7.5% -> 1ms.
 	XTmrCtr_SetResetValue(&servoTimer, 1, 75000);
+	servoDuty = 7.5;
 
 	// Enable PWM on the timers.
 	XTmrCtr_SetOptions(&servoTimer, 0, XTC_PWM_ENABLE_OPTION | XTC_EXT_COMPARE_OPTION | XTC_DOWN_COUNT_OPTION);
@@ -51,4 +53,14 @@ void servo_init(void) {
 void servo_set(double dutycycle) {
 	// Set a duty cycle.
 	XTmrCtr_SetResetValue(&servoTimer, 1, 1000000*dutycycle/100);
+	servoDuty = dutycycle;
+}
+
+/*
+ * Get the dutycycle last set.
+ * Inputs: none.
+ * Outputs: percentage of total period.
+ */
+double servo_get(void) {
+	return servoDuty;
 }
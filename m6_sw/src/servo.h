@@ -18,5 +18,10 @@ void servo_init(void);
  */
 void servo_set(double dutycycle);
 
+/*
+ * Get the dutycycle last set
+ */
+double servo_get(void);
+
 
 
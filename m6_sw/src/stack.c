@@ -0,0 +1,126 @@
+/*
+ * stack.c -- mode stack usage implementation
+ *
+ * Author: Joshua M. Meise
+ * Created: 10-19-2026
+ * Version: 1.0
+ *
+ * Description: Reads back the stack paint laid down by xil-crt0.S to find
+ * how deep each mode stack has been used.
+ */
+
+// Library inclusions.
+#include "stack.h"
+
+// Linker symbols (lscript.ld); stacks grow down from top to limit.
+extern u32 _stack_end[];
+extern u32 __stack[];
+extern u32 _irq_stack_end[];
+extern u32 __irq_stack[];
+extern u32 _supervisor_stack_end[];
+extern u32 __supervisor_stack[];
+extern u32 _abort_stack_end[];
+extern u32 __abort_stack[];
+extern u32 _fiq_stack_end[];
+extern u32 __fiq_stack[];
+extern u32 _undef_stack_end[];
+extern u32 __undef_stack[];
+
+// A mode stack.
+typedef struct {
+	const char *name;
+	u32 *limit;
+	u32 *top;
+} mode_stack_t;
+
+// Global variables.
+static const mode_stack_t stacks[STACK_NUM] = {
+	{ "sys", _stack_end, __stack },
+	{ "irq", _irq_stack_end, __irq_stack },
+	{ "svc", _supervisor_stack_end, __supervisor_stack },
+	{ "abt", _abort_stack_end, __abort_stack },
+	{ "fiq", _fiq_stack_end, __fiq_stack },
+	{ "und", _undef_stack_end, __undef_stack },
+};
+
+/*
+ * Get the size of a stack.
+ * Inputs: Stack.
+ * Outputs: Size in bytes.
+ */
+u32 stack_size(stack_id_t id) {
+	if (id >= STACK_NUM)
+		return 0;
+	return (u32)((stacks[id].top - stacks[id].limit) * sizeof(u32));
+}
+
+/*
+ * Get the untouched part of a stack.
+ * Inputs: Stack.
+ * Outputs: Margin in bytes.
+ */
+u32 stack_margin(stack_id_t id) {
+	// Variable declarations.
+	const u32 *p;
+
+	if (id >= STACK_NUM)
+		return 0;
+
+	// Scan up from the limit until the paint stops.
+	for (p = stacks[id].limit; p < stacks[id].top && *p == STACK_PAINT; p++)
+		;
+
+	return (u32)((p - stacks[id].limit) * sizeof(u32));
+}
+
+/*
+ * Get the high-water mark of a stack.
+ * Inputs: Stack.
+ * Outputs: Bytes used.
+ */
+u32 stack_high_water(stack_id_t id) {
+	return stack_size(id) - stack_margin(id);
+}
+
+/*
+ * Print every stack.
+ * Inputs: None.
+ * Outputs: None.
+ */
+void stack_print(void) {
+	// Variable declarations.
+	u32 id, margin;
+
+	printf("[stack mode size used margin]\n");
+
+	for (id = 0; id < STACK_NUM; id++) {
+		margin = stack_margin((stack_id_t)id);
+		printf("[stack %s %lu %lu %lu]\n", stacks[id].name, (unsigned long)stack_size((stack_id_t)id),
+				(unsigned long)(stack_size((stack_id_t)id) - margin), (unsigned long)margin);
+	}
+}
+
+/*
+ * Check every stack against a minimum margin.
+ * Inputs: Minimum margin in bytes.
+ * Outputs: Smallest margin.
+ */
+u32 stack_check(u32 minMargin) {
+	// Variable declarations.
+	u32 id, margin;
+	u32 smallest = 0xFFFFFFFFU;
+
+	for (id = 0; id < STACK_NUM; id++) {
+		// Skip stacks the linker script does not provide.
+		if (stack_size((stack_id_t)id) == 0)
+			continue;
+
+		margin = stack_margin((stack_id_t)id);
+		if (margin < minMargin)
+			printf("[stack %s margin %lu low]\n", stacks[id].name, (unsigned long)margin);
+		if (margin < smallest)
+			smallest = margin;
+	}
+
+	return smallest;
+}
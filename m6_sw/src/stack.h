@@ -0,0 +1,52 @@
+/*
+ * stack.h -- mode stack usage interface
+ *
+ * xil-crt0.S paints every mode stack with STACK_PAINT before first use;
+ * the deepest word that no longer holds the pattern gives the high-water
+ * mark. Usage that skips over words without writing them (large unused
+ * locals) is not seen.
+ */
+#pragma once
+
+#include <stdio.h>
+#include "xil_types.h"		/* types used by xilinx */
+
+#define STACK_PAINT 0xA5A5A5A5U		/* must match xil-crt0.S */
+
+/* processor mode stacks */
+typedef enum {
+	STACK_SYS,			/* main and everything it calls */
+	STACK_IRQ,			/* interrupt handlers */
+	STACK_SVC,
+	STACK_ABT,
+	STACK_FIQ,
+	STACK_UND,
+	STACK_NUM
+} stack_id_t;
+
+/*
+ * Size of stack <id> in bytes
+ */
+u32 stack_size(stack_id_t id);
+
+/*
+ * Deepest use of stack <id> since boot in bytes
+ */
+u32 stack_high_water(stack_id_t id);
+
+/*
+ * Bytes of stack <id> never touched since boot
+ */
+u32 stack_margin(stack_id_t id);
+
+/*
+ * Print size, high-water mark and margin of every stack
+ */
+void stack_print(void);
+
+/*
+ * Check every stack against <minMargin> bytes and print the ones that are
+ * below it
+ * returns the smallest margin found
+ */
+u32 stack_check(u32 minMargin);
@@ -0,0 +1,646 @@
+/*
+ * tlsf.c -- two-level segregated-fit allocator implementation
+ *
+ * Author: Joshua M. Meise
+ * Created: 10-19-2026
+ * Version: 1.0
+ *
+ * Description: Constant-time allocator after Masmano et al. Each pool keeps
+ * its free blocks in lists indexed by the position of the most significant
+ * bit of the size (first level) and the next four bits (second level).
+ * Neighbouring free blocks are merged on free.
+ */
+
+// Library inclusions.
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tlsf.h"
+#include "memmap.h"
+#include "xtime_l.h"
+#include "xstatus.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+
+// Predefined constants.
+#define ALIGN 8U
+#define HDR_SIZE ((u32)offsetof(block_t, nextFree))	/* size word and physical back link */
+#define MIN_PAYLOAD ((u32)(2*sizeof(block_t *)))		/* room for the free list links */
+#define FL_SHIFT (TLSF_SL_LOG2 + 3)			/* first row holding power-of-two classes */
+#define SMALL_BLOCK (1U << FL_SHIFT)		/* 128; below this lists are linear */
+#define BLOCK_FREE 0x1U
+#define SIZE_MASK (~(ALIGN - 1U))
+#define IRQ_FIQ_MASK 0xC0U
+#define DDR_POOL_SIZE 0x20000U				/* ddr pool when malloc is not routed here; _HEAP_SIZE matches */
+#define OCM_POOL_SIZE 0x10000U
+#define BENCH_SLOTS 64
+#define BENCH_OPS 10000
+
+// Block header; the free list links overlay the payload of free blocks.
+typedef struct tlsf_block {
+	u32 size;								/* payload bytes | BLOCK_FREE */
+	struct tlsf_block *prevPhys;			/* NULL for the first block */
+	struct tlsf_block *nextFree;
+	struct tlsf_block *prevFree;
+} block_t;
+
+// Global variables.
+tlsf_pool_t tlsfDdr;
+tlsf_pool_t tlsfOcm;
+static bool poolsReady = false;
+#ifndef TLSF_MALLOC
+static u8 ddrPool[DDR_POOL_SIZE] __attribute__((aligned(ALIGN)));
+#endif
+static u8 ocmPool[OCM_POOL_SIZE] MEMMAP_OCM;
+static void *benchSlots[BENCH_SLOTS];
+
+/*
+ * Index of the most significant set bit.
+ * Inputs: Nonzero word.
+ * Outputs: Bit index.
+ */
+static inline u32 fls(u32 x) {
+	return 31U - (u32)__builtin_clz(x);
+}
+
+/*
+ * Index of the least significant set bit.
+ * Inputs: Nonzero word.
+ * Outputs: Bit index.
+ */
+static inline u32 ffs_bit(u32 x) {
+	return (u32)__builtin_ctz(x);
+}
+
+/*
+ * Size class of a block.
+ * Inputs: Payload size, list indices to fill in.
+ * Outputs: None.
+ */
+static inline void mapping(u32 size, u32 *fl, u32 *sl) {
+	// Variable declarations.
+	u32 f;
+
+	if (size < SMALL_BLOCK) {
+		*fl = 0;
+		*sl = size / (SMALL_BLOCK / TLSF_SL_COUNT);
+	}
+	else {
+		f = fls(size);
+		*sl = (size >> (f - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+		*fl = f - (FL_SHIFT - 1);
+	}
+}
+
+/*
+ * Size class to search so that any block found is large enough.
+ * Inputs: Payload size, list indices to fill in.
+ * Outputs: None.
+ */
+static inline void mapping_search(u32 size, u32 *fl, u32 *sl) {
+	if (size >= SMALL_BLOCK)
+		size += (1U << (fls(size) - TLSF_SL_LOG2)) - 1U;
+	mapping(size, fl, sl);
+}
+
+/*
+ * Payload size of a block.
+ * Inputs: Block.
+ * Outputs: Size in bytes.
+ */
+static inline u32 block_size(const block_t *b) {
+	return b->size & SIZE_MASK;
+}
+
+/*
+ * Physically next block.
+ * Inputs: Block.
+ * Outputs: Next block (the end sentinel for the last one).
+ */
+static inline block_t *block_next(const block_t *b) {
+	return (block_t *)((u8 *)b + HDR_SIZE + block_size(b));
+}
+
+/*
+ * Put a free block on its list.
+ * Inputs: Pool, block.
+ * Outputs: None.
+ */
+static void insert_block(tlsf_pool_t *pool, block_t *b) {
+	// Variable declarations.
+	u32 fl, sl;
+	block_t *head;
+
+	mapping(block_size(b), &fl, &sl);
+	head = pool->blocks[fl][sl];
+	b->nextFree = head;
+	b->prevFree = NULL;
+	if (head != NULL)
+		head->prevFree = b;
+	pool->blocks[fl][sl] = b;
+	pool->flBitmap |= 1U << fl;
+	pool->slBitmap[fl] |= 1U << sl;
+}
+
+/*
+ * Take a free block off its list.
+ * Inputs: Pool, block.
+ * Outputs: None.
+ */
+static void remove_block(tlsf_pool_t *pool, block_t *b) {
+	// Variable declarations.
+	u32 fl, sl;
+
+	mapping(block_size(b), &fl, &sl);
+	if (b->prevFree != NULL)
+		b->prevFree->nextFree = b->nextFree;
+	else
+		pool->blocks[fl][sl] = b->nextFree;
+	if (b->nextFree != NULL)
+		b->nextFree->prevFree = b->prevFree;
+
+	if (pool->blocks[fl][sl] == NULL) {
+		pool->slBitmap[fl] &= ~(1U << sl);
+		if (pool->slBitmap[fl] == 0)
+			pool->flBitmap &= ~(1U << fl);
+	}
+}
+
+/*
+ * Find a free block at least as large as the class searched.
+ * Inputs: Pool, list indices from mapping_search.
+ * Outputs: Block, or NULL.
+ */
+static block_t *find_block(tlsf_pool_t *pool, u32 fl, u32 sl) {
+	// Variable declarations.
+	u32 map;
+
+	if (fl >= TLSF_FL_COUNT)
+		return NULL;
+
+	map = pool->slBitmap[fl] & (~0U << sl);
+	if (map == 0) {
+		// Nothing left in this row; take the smallest non-empty row above.
+		map = pool->flBitmap & (~0U << (fl + 1));
+		if (map == 0)
+			return NULL;
+		fl = ffs_bit(map);
+		map = pool->slBitmap[fl];
+	}
+
+	return pool->blocks[fl][ffs_bit(map)];
+}
+
+/*
+ * Mask interrupts if the pool needs it.
+ * Inputs: Pool.
+ * Outputs: Previous cpsr.
+ */
+static inline u32 pool_lock(const tlsf_pool_t *pool) {
+	// Variable declarations.
+	u32 cpsr = 0;
+
+	if (pool->irqSafe) {
+		cpsr = mfcpsr();
+		mtcpsr(cpsr | IRQ_FIQ_MASK);
+	}
+	return cpsr;
+}
+
+/*
+ * Restore the interrupt mask.
+ * Inputs: Pool, cpsr from pool_lock.
+ * Outputs: None.
+ */
+static inline void pool_unlock(const tlsf_pool_t *pool, u32 cpsr) {
+	if (pool->irqSafe)
+		mtcpsr(cpsr);
+}
+
+/*
+ * Create a pool.
+ * Inputs: Pool, memory, size, interrupt safety.
+ * Outputs: XST_SUCCESS or XST_FAILURE.
+ */
+s32 tlsf_init(tlsf_pool_t *pool, void *mem, u32 size, bool irqSafe) {
+	// Variable declarations.
+	u8 *start;
+	block_t *b, *end;
+
+	start = (u8 *)(((UINTPTR)mem + ALIGN - 1U) & ~(UINTPTR)(ALIGN - 1U));
+	if (mem == NULL || size < (u32)(start - (u8 *)mem) + 2*HDR_SIZE + MIN_PAYLOAD)
+		return XST_FAILURE;
+	size = (size - (u32)(start - (u8 *)mem)) & SIZE_MASK;
+
+	memset(pool, 0, sizeof(*pool));
+	pool->start = start;
+	pool->size = size;
+	pool->irqSafe = irqSafe;
+
+	// One free block followed by a zero-sized, allocated end sentinel.
+	b = (block_t *)start;
+	b->size = (size - 2*HDR_SIZE) | BLOCK_FREE;
+	b->prevPhys = NULL;
+	end = block_next(b);
+	end->size = 0;
+	end->prevPhys = b;
+	insert_block(pool, b);
+
+	return XST_SUCCESS;
+}
+
+/*
+ * Set up the ddr and ocm pools.
+ * Inputs: None.
+ * Outputs: XST_SUCCESS or XST_FAILURE.
+ */
+s32 tlsf_pools_init(void) {
+	// Variable declarations.
+#ifdef TLSF_MALLOC
+	extern u8 _heap_end[];
+	extern char *_sbrk(int incr);
+	u8 *mem;
+	u32 size;
+#endif
+
+	if (poolsReady)
+		return XST_SUCCESS;
+
+#ifdef TLSF_MALLOC
+	// Every allocation comes through here; take the whole heap from the break newlib would have used.
+	mem = (u8 *)_sbrk(0);
+	size = (u32)(_heap_end - mem);
+	mem = (u8 *)_sbrk((int)size);
+	if (mem == (u8 *)-1) {
+		printf("Error carving the tlsf ddr pool.\n");
+		return XST_FAILURE;
+	}
+
+	if (tlsf_init(&tlsfDdr, mem, size, true) != XST_SUCCESS)
+		return XST_FAILURE;
+#else
+	// Newlib's malloc owns the heap; keep the pool out of it.
+	if (tlsf_init(&tlsfDdr, ddrPool, sizeof(ddrPool), false) != XST_SUCCESS)
+		return XST_FAILURE;
+#endif
+	if (tlsf_init(&tlsfOcm, ocmPool, sizeof(ocmPool), true) != XST_SUCCESS)
+		return XST_FAILURE;
+
+	poolsReady = true;
+
+	return XST_SUCCESS;
+}
+
+/*
+ * Allocate from a pool.
+ * Inputs: Pool, size.
+ * Outputs: Payload or NULL.
+ */
+void *tlsf_malloc(tlsf_pool_t *pool, u32 size) {
+	// Variable declarations.
+	u32 fl, sl, cpsr, bsize;
+	block_t *b, *rest;
+
+	if (size > pool->size)
+		return NULL;
+	size = size < MIN_PAYLOAD ? MIN_PAYLOAD : (size + ALIGN - 1U) & SIZE_MASK;
+
+	cpsr = pool_lock(pool);
+
+	mapping_search(size, &fl, &sl);
+	b = find_block(pool, fl, sl);
+	if (b == NULL) {
+		pool->failures++;
+		pool_unlock(pool, cpsr);
+		return NULL;
+	}
+	remove_block(pool, b);
+
+	// Split off the tail if it can hold a block of its own.
+	bsize = block_size(b);
+	if (bsize >= size + HDR_SIZE + MIN_PAYLOAD) {
+		rest = (block_t *)((u8 *)b + HDR_SIZE + size);
+		rest->size = (bsize - size - HDR_SIZE) | BLOCK_FREE;
+		rest->prevPhys = b;
+		block_next(rest)->prevPhys = rest;
+		insert_block(pool, rest);
+		bsize = size;
+	}
+	b->size = bsize;
+
+	pool->used += bsize;
+	if (pool->used > pool->highWater)
+		pool->highWater = pool->used;
+	pool->allocs++;
+
+	pool_unlock(pool, cpsr);
+
+	return (u8 *)b + HDR_SIZE;
+}
+
+/*
+ * Allocate an aligned block from a pool.
+ * Inputs: Pool, alignment, size.
+ * Outputs: Payload or NULL.
+ */
+void *tlsf_memalign(tlsf_pool_t *pool, u32 align, u32 size) {
+	// Variable declarations.
+	u8 *ptr, *aligned;
+	u32 cpsr, gap;
+	block_t *b, *nb;
+
+	if (align <= ALIGN)
+		return tlsf_malloc(pool, size);
+	if ((align & (align - 1U)) != 0 || size > pool->size)
+		return NULL;
+
+	// Room to move the payload up to the boundary and leave a free block in front of it.
+	if ((ptr = tlsf_malloc(pool, size + align + HDR_SIZE + MIN_PAYLOAD)) == NULL)
+		return NULL;
+	if (((UINTPTR)ptr & (align - 1U)) == 0)
+		return ptr;
+	aligned = (u8 *)(((UINTPTR)ptr + HDR_SIZE + MIN_PAYLOAD + align - 1U) & ~(UINTPTR)(align - 1U));
+	gap = (u32)(aligned - ptr);
+
+	// Split the block at the boundary, then free the front part.
+	cpsr = pool_lock(pool);
+	b = (block_t *)(ptr - HDR_SIZE);
+	nb = (block_t *)(aligned - HDR_SIZE);
+	nb->size = block_size(b) - gap;
+	nb->prevPhys = b;
+	block_next(nb)->prevPhys = nb;
+	b->size = gap - HDR_SIZE;
+	pool->used -= HDR_SIZE;
+	pool_unlock(pool, cpsr);
+
+	tlsf_free(pool, ptr);
+
+	return aligned;
+}
+
+/*
+ * Free into a pool.
+ * Inputs: Pool, payload.
+ * Outputs: None.
+ */
+void tlsf_free(tlsf_pool_t *pool, void *ptr) {
+	// Variable declarations.
+	u32 cpsr;
+	block_t *b, *next;
+
+	if (ptr == NULL)
+		return;
+
+	b = (block_t *)((u8 *)ptr - HDR_SIZE);
+
+	cpsr = pool_lock(pool);
+
+	pool->used -= block_size(b);
+	pool->frees++;
+
+	// Merge with the free neighbours on either side.
+	if (b->prevPhys != NULL && (b->prevPhys->size & BLOCK_FREE)) {
+		remove_block(pool, b->prevPhys);
+		b->prevPhys->size += HDR_SIZE + block_size(b);
+		b = b->prevPhys;
+	}
+	next = block_next(b);
+	if (next->size & BLOCK_FREE) {
+		remove_block(pool, next);
+		b->size += HDR_SIZE + block_size(next);
+	}
+
+	b->size |= BLOCK_FREE;
+	block_next(b)->prevPhys = b;
+	insert_block(pool, b);
+
+	pool_unlock(pool, cpsr);
+}
+
+/*
+ * Resize a block.
+ * Inputs: Pool, payload, new size.
+ * Outputs: Payload (possibly moved) or NULL.
+ */
+void *tlsf_realloc(tlsf_pool_t *pool, void *ptr, u32 size) {
+	// Variable declarations.
+	void *moved;
+	u32 old;
+
+	if (ptr == NULL)
+		return tlsf_malloc(pool, size);
+	if (size == 0) {
+		tlsf_free(pool, ptr);
+		return NULL;
+	}
+
+	old = block_size((block_t *)((u8 *)ptr - HDR_SIZE));
+	if (size <= old)
+		return ptr;
+
+	moved = tlsf_malloc(pool, size);
+	if (moved != NULL) {
+		memcpy(moved, ptr, old);
+		tlsf_free(pool, ptr);
+	}
+
+	return moved;
+}
+
+/*
+ * Collect pool statistics.
+ * Inputs: Pool, statistics to fill in.
+ * Outputs: None.
+ */
+void tlsf_stats(tlsf_pool_t *pool, tlsf_stats_t *stats) {
+	// Variable declarations.
+	u32 fl, sl, cpsr, size;
+	block_t *b;
+
+	memset(stats, 0, sizeof(*stats));
+
+	cpsr = pool_lock(pool);
+
+	for (fl = 0; fl < TLSF_FL_COUNT; fl++) {
+		for (sl = 0; sl < TLSF_SL_COUNT; sl++) {
+			for (b = pool->blocks[fl][sl]; b != NULL; b = b->nextFree) {
+				size = block_size(b);
+				stats->free += size;
+				stats->freeBlocks++;
+				if (size > stats->largestFree)
+					stats->largestFree = size;
+			}
+		}
+	}
+
+	stats->total = pool->size - 2*HDR_SIZE;
+	stats->used = pool->used;
+	stats->highWater = pool->highWater;
+	stats->allocs = pool->allocs;
+	stats->frees = pool->frees;
+	stats->failures = pool->failures;
+
+	pool_unlock(pool, cpsr);
+
+	if (stats->free != 0)
+		stats->fragmentation = 1000U - (u32)((u64)stats->largestFree * 1000U / stats->free);
+}
+
+/*
+ * Print pool statistics.
+ * Inputs: Name, pool.
+ * Outputs: None.
+ */
+void tlsf_print(const char *name, tlsf_pool_t *pool) {
+	// Variable declarations.
+	tlsf_stats_t s;
+
+	tlsf_stats(pool, &s);
+	printf("[tlsf %s total %lu used %lu high %lu free %lu blocks %lu largest %lu frag %lu allocs %lu frees %lu failed %lu]\n",
+			name, (unsigned long)s.total, (unsigned long)s.used, (unsigned long)s.highWater,
+			(unsigned long)s.free, (unsigned long)s.freeBlocks, (unsigned long)s.largestFree,
+			(unsigned long)s.fragmentation, (unsigned long)s.allocs, (unsigned long)s.frees,
+			(unsigned long)s.failures);
+}
+
+/*
+ * Run the churn pattern against one allocator.
+ * Inputs: Pool (NULL for newlib), mean and worst cycles to fill in.
+ * Outputs: None.
+ */
+static void churn(tlsf_pool_t *pool, u32 *mean, u32 *worst) {
+	// Variable declarations.
+	XTime start, end;
+	u32 seed = 12345;
+	u32 n, slot, size, c;
+	u64 total = 0;
+
+	*worst = 0;
+	for (n = 0; n < BENCH_OPS; n++) {
+		seed = seed * 1103515245U + 12345U;
+		slot = (seed >> 16) % BENCH_SLOTS;
+		size = 16 + ((seed >> 8) & 0x3FF);
+
+		XTime_GetTime(&start);
+		if (benchSlots[slot] != NULL) {
+			if (pool != NULL)
+				tlsf_free(pool, benchSlots[slot]);
+			else
+				free(benchSlots[slot]);
+			benchSlots[slot] = NULL;
+		}
+		else
+			benchSlots[slot] = pool != NULL ? tlsf_malloc(pool, size) : malloc(size);
+		XTime_GetTime(&end);
+
+		c = (u32)((end - start) * (XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / COUNTS_PER_SECOND));
+		total += c;
+		if (c > *worst)
+			*worst = c;
+	}
+
+	// Release whatever is left.
+	for (slot = 0; slot < BENCH_SLOTS; slot++) {
+		if (pool != NULL)
+			tlsf_free(pool, benchSlots[slot]);
+		else
+			free(benchSlots[slot]);
+		benchSlots[slot] = NULL;
+	}
+
+	*mean = (u32)(total / BENCH_OPS);
+}
+
+/*
+ * Benchmark tlsf against newlib.
+ * Inputs: None.
+ * Outputs: None.
+ */
+void tlsf_bench(void) {
+	// Variable declarations.
+	u32 mean, worst;
+
+	if (tlsf_pools_init() != XST_SUCCESS)
+		return;
+
+	printf("[alloc allocator mean worst]\n");
+
+	churn(&tlsfDdr, &mean, &worst);
+	printf("[alloc tlsf %lu %lu]\n", (unsigned long)mean, (unsigned long)worst);
+
+#ifndef TLSF_MALLOC
+	churn(NULL, &mean, &worst);
+	printf("[alloc newlib %lu %lu]\n", (unsigned long)mean, (unsigned long)worst);
+#endif
+
+	tlsf_print("ddr", &tlsfDdr);
+	tlsf_print("ocm", &tlsfOcm);
+}
+
+#ifdef TLSF_MALLOC
+/*
+ * Newlib hooks. The application is linked ahead of libc, so these replace
+ * newlib's allocator for printf, the drivers and the application alike.
+ */
+struct _reent;
+
+void *malloc(size_t size) {
+	if (tlsf_pools_init() != XST_SUCCESS)
+		return NULL;
+	return tlsf_malloc(&tlsfDdr, (u32)size);
+}
+
+void free(void *ptr) {
+	tlsf_free(&tlsfDdr, ptr);
+}
+
+void *realloc(void *ptr, size_t size) {
+	if (tlsf_pools_init() != XST_SUCCESS)
+		return NULL;
+	return tlsf_realloc(&tlsfDdr, ptr, (u32)size);
+}
+
+void *calloc(size_t n, size_t size) {
+	// Variable declarations.
+	void *ptr;
+	u64 total = (u64)n * size;
+
+	if (total > 0xFFFFFFFFU)
+		return NULL;
+	ptr = malloc((size_t)total);
+	if (ptr != NULL)
+		memset(ptr, 0, (size_t)total);
+	return ptr;
+}
+
+void *_malloc_r(struct _reent *r, size_t size) {
+	(void)r;
+	return malloc(size);
+}
+
+void _free_r(struct _reent *r, void *ptr) {
+	(void)r;
+	free(ptr);
+}
+
+void *_realloc_r(struct _reent *r, void *ptr, size_t size) {
+	(void)r;
+	return realloc(ptr, size);
+}
+
+void *_calloc_r(struct _reent *r, size_t n, size_t size) {
+	(void)r;
+	return calloc(n, size);
+}
+
+void *memalign(size_t align, size_t size) {
+	if (tlsf_pools_init() != XST_SUCCESS)
+		return NULL;
+	return tlsf_memalign(&tlsfDdr, (u32)align, (u32)size);
+}
+
+void *_memalign_r(struct _reent *r, size_t align, size_t size) {
+	(void)r;
+	return memalign(align, size);
+}
+#endif
@@ -0,0 +1,112 @@
+/*
+ * tlsf.h -- two-level segregated-fit allocator interface
+ *
+ * malloc and free run in constant time: free blocks are kept in lists
+ * indexed by (power of two, 1/16th subdivision) and found with two
+ * bitmap scans. Every block carries an 8-byte header; payloads are
+ * 8-byte aligned.
+ *
+ * Building with -DTLSF_MALLOC routes malloc, free, calloc, realloc and
+ * memalign (including the reentrant versions newlib uses internally, which
+ * valloc goes through) to the ddr pool, which then takes the whole heap.
+ * Newlib allocator entry points beyond these are not routed and must not
+ * be used in that build.
+ */
+#pragma once
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "xil_types.h"		/* types used by xilinx */
+
+#define TLSF_SL_LOG2 4									/* 16 lists per power of two */
+#define TLSF_SL_COUNT (1 << TLSF_SL_LOG2)
+#define TLSF_FL_COUNT 25								/* blocks up to 1GB */
+
+struct tlsf_block;
+
+/* a pool of memory managed by the allocator */
+typedef struct {
+	u32 flBitmap;										/* non-empty first-level rows */
+	u32 slBitmap[TLSF_FL_COUNT];						/* non-empty lists in each row */
+	struct tlsf_block *blocks[TLSF_FL_COUNT][TLSF_SL_COUNT];
+	u8 *start;
+	u32 size;
+	bool irqSafe;										/* mask interrupts around updates */
+	u32 used;											/* payload bytes allocated */
+	u32 highWater;
+	u32 allocs;
+	u32 frees;
+	u32 failures;
+} tlsf_pool_t;
+
+/* pool statistics */
+typedef struct {
+	u32 total;			/* bytes available for payloads when empty */
+	u32 used;
+	u32 highWater;
+	u32 free;
+	u32 freeBlocks;
+	u32 largestFree;
+	u32 fragmentation;	/* 1000 * (1 - largestFree/free) */
+	u32 allocs;
+	u32 frees;
+	u32 failures;
+} tlsf_stats_t;
+
+/* pools set up by tlsf_pools_init */
+extern tlsf_pool_t tlsfDdr;		/* the whole heap with TLSF_MALLOC; else a static buffer */
+extern tlsf_pool_t tlsfOcm;		/* low on-chip memory; interrupt-safe */
+
+/*
+ * Create a pool over [mem, mem+size)
+ *
+ * With <irqSafe> set, interrupts are masked while the pool is updated so
+ * it may be used from interrupt handlers.
+ * returns XST_SUCCESS on success; otherwise XST_FAILURE
+ */
+s32 tlsf_init(tlsf_pool_t *pool, void *mem, u32 size, bool irqSafe);
+
+/*
+ * Set up the ddr and ocm pools; safe to call more than once
+ * returns XST_SUCCESS on success; otherwise XST_FAILURE
+ */
+s32 tlsf_pools_init(void);
+
+/*
+ * Allocate <size> bytes from <pool>
+ * returns the payload, or NULL if no block is large enough
+ */
+void *tlsf_malloc(tlsf_pool_t *pool, u32 size);
+
+/*
+ * Allocate <size> bytes from <pool> at a multiple of <align>, a power of
+ * two; the block is returned with tlsf_free as usual
+ * returns the payload, or NULL if no block is large enough
+ */
+void *tlsf_memalign(tlsf_pool_t *pool, u32 align, u32 size);
+
+/*
+ * Return a block to <pool>; NULL is ignored
+ */
+void tlsf_free(tlsf_pool_t *pool, void *ptr);
+
+/*
+ * Resize a block, moving it if it cannot grow in place
+ */
+void *tlsf_realloc(tlsf_pool_t *pool, void *ptr, u32 size);
+
+/*
+ * Collect statistics for <pool>; walks the free lists
+ */
+void tlsf_stats(tlsf_pool_t *pool, tlsf_stats_t *stats);
+
+/*
+ * Print the statistics of <pool> under <name>
+ */
+void tlsf_print(const char *name, tlsf_pool_t *pool);
+
+/*
+ * Run the same allocation churn against the tlsf ddr pool and newlib
+ * malloc and print the mean and worst cycles per operation
+ */
+void tlsf_bench(void);
@@ -12,6 +12,7 @@
 // Header file inclusions.
 #include "ttc.h"
 #include "gic.h"
+#include "fast.h"
 #include "xparameters.h"
 
 // Global variables.
@@ -23,7 +24,7 @@ static void (*ttc_callback_saved)(void);
  * Inputs: pointer to device.
  * Outputs: none.
  */
-void ttc_handler(void *devp) {
+FAST_TEXT void ttc_handler(void *devp) {
 	// Variable declarations.
 	XTtcPs *device;
 
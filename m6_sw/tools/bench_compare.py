@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+#
+# bench_compare.py -- check driver benchmark results against a baseline
+#
+# Author: Joshua M. Meise
+# Created: 10-19-2026
+# Version: 1.0
+#
+# Description: Reads the [bench ...] lines bench_run prints (from a
+# console capture, or benchsim output) and compares the median of every
+# case against a saved baseline. A case regresses when its median grows
+# by more than --threshold percent and by more than --floor units, which
+# keeps single-digit cases from tripping on noise. The register access
+# counts benchsim reports are exact, so any increase is a regression.
+# Exits 1 on any
+# regression so it can gate a build. Other console output is ignored.
+#
+# usage: bench_compare.py capture.txt --save bench.baseline
+#        bench_compare.py capture.txt --baseline bench.baseline
+#        benchsim/benchsim | bench_compare.py - --baseline sim.baseline
+#
+import argparse
+import json
+import re
+import sys
+
+LINE = re.compile(r"\[bench (\S+) (warm|cold) (\d+) (\d+) (\d+) (\d+) (\d+) (\d+)\]")
+ACCESSES = re.compile(r"\[bench (\S+) accesses (\d+)\]")
+UNIT = re.compile(r"\[bench (target \d+ hz|sim ns)\]")
+FIELDS = ("calls", "best", "median", "mean", "max", "gt")
+
+
+def parse(text):
+    """Unit string and {(case, cache): {field: value}} from console text."""
+    unit, results = None, {}
+    for line in text.splitlines():
+        m = UNIT.search(line)
+        if m:
+            unit = m.group(1)
+            continue
+        m = ACCESSES.search(line)
+        if m:
+            results[(m.group(1), "regs")] = {"accesses": int(m.group(2))}
+            continue
+        m = LINE.search(line)
+        if m:
+            results[(m.group(1), m.group(2))] = dict(zip(FIELDS, map(int, m.groups()[2:])))
+    return unit, results
+
+
+def read(path):
+    if path == "-":
+        return sys.stdin.read()
+    with open(path, errors="replace") as f:
+        return f.read()
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Compare driver benchmark results against a baseline.")
+    ap.add_argument("capture", help="console capture or benchsim output; - for stdin")
+    ap.add_argument("--baseline", help="baseline to compare against")
+    ap.add_argument("--save", help="write the results as a new baseline")
+    ap.add_argument("--json", action="store_true", help="print the results as json")
+    ap.add_argument("--threshold", type=float, default=10.0, help="allowed median growth in percent")
+    ap.add_argument("--floor", type=int, default=20, help="ignore growth below this many units")
+    args = ap.parse_args()
+
+    unit, results = parse(read(args.capture))
+    if not results:
+        sys.exit("no [bench ...] lines in %s" % args.capture)
+
+    if args.save:
+        with open(args.save, "w") as f:
+            f.write("[bench %s]\n" % unit)
+            for (case, cache), r in sorted(results.items()):
+                if cache == "regs":
+                    f.write("[bench %s accesses %d]\n" % (case, r["accesses"]))
+                else:
+                    f.write("[bench %s %s %s]\n" % (case, cache, " ".join(str(r[k]) for k in FIELDS)))
+
+    if args.json:
+        json.dump({"unit": unit,
+                   "results": [dict(case=c, cache=k, **r) for (c, k), r in sorted(results.items())]},
+                  sys.stdout, indent=1)
+        print()
+
+    if not args.baseline:
+        return 0
+
+    base_unit, base = parse(read(args.baseline))
+    if base_unit != unit:
+        sys.exit("baseline is in '%s' but the capture is in '%s'" % (base_unit, unit))
+
+    regressed = 0
+    print("%-16s %-5s %10s %10s %8s" % ("case", "cache", "baseline", "now", "change"))
+    for key in sorted(set(base) | set(results)):
+        case, cache = key
+        if key not in results:
+            print("%-16s %-5s %10s %8s" % (case, cache, "-", "missing"))
+            continue
+        if key not in base:
+            print("%-16s %-5s %10s %10s %8s" % (case, cache, "-", "", "new"))
+            continue
+        if cache == "regs":
+            old, new = base[key]["accesses"], results[key]["accesses"]
+            bad = new > old
+        else:
+            old, new = base[key]["median"], results[key]["median"]
+            bad = None
+        change = 100.0 * (new - old) / old if old else 0.0
+        if bad is None:
+            bad = new - old > args.floor and change > args.threshold
+        regressed += bad
+        print("%-16s %-5s %10d %10d %+7.1f%%%s" % (case, cache, old, new, change, "  REGRESSED" if bad else ""))
+
+    if regressed:
+        print("%d case(s) regressed" % regressed, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,44 @@
+/*
+ * main.c -- host driver for the microbenchmark suite
+ *
+ * Author: Joshua M. Meise
+ * Created: 10-19-2026
+ * Version: 1.0
+ *
+ * Description: Brings up the led, servo and adc modules against the
+ * simulated register backend and runs the suite in bench.c.
+ * Usage: benchsim [-l | case | all]
+ */
+
+// Library inclusions.
+#include <stdio.h>
+#include <string.h>
+#include "simio.h"
+#include "bench.h"
+#include "led.h"
+#include "servo.h"
+#include "adc.h"
+
+int main(int argc, char *argv[]) {
+	// Variable declarations.
+	u32 ran;
+
+	led_init();
+	servo_init();
+	adc_init();
+
+	if (bench_init() != XST_SUCCESS) {
+		printf("Error initializing benchmarks.\n");
+		return 1;
+	}
+
+	if (argc > 1 && strcmp(argv[1], "-l") == 0) {
+		bench_list();
+		return 0;
+	}
+
+	ran = bench_run(argc > 1 ? argv[1] : NULL);
+	printf("[sim accesses %lu]\n", (unsigned long)sim_accesses());
+
+	return ran == 0;
+}
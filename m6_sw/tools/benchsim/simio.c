@@ -0,0 +1,127 @@
+/*
+ * simio.c -- simulated register backend implementation
+ *
+ * Author: Joshua M. Meise
+ * Created: 10-19-2026
+ * Version: 1.0
+ *
+ * Description: An open-addressed register file keyed on address. Status
+ * registers the drivers poll start at values that let them proceed: the
+ * uart fifos read as empty and the ttcs as stopped.
+ */
+
+// Library inclusions.
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "simio.h"
+#include "xparameters.h"
+#include "xuartps_hw.h"
+#include "xttcps_hw.h"
+
+// Predefined constants.
+#define SIM_SLOTS 4096U
+
+// A register that has been written.
+typedef struct {
+	UINTPTR addr;
+	u32 val;
+	bool used;
+} sim_reg_t;
+
+// A register whose reset value is not zero.
+typedef struct {
+	UINTPTR addr;
+	u32 val;
+	bool status;		/* read-only as far as the drivers are concerned */
+} sim_reset_t;
+
+// Global variables.
+static sim_reg_t regs[SIM_SLOTS];
+static u32 accesses;
+
+static const sim_reset_t resets[] = {
+	{ XPAR_PS7_UART_0_BASEADDR + XUARTPS_SR_OFFSET, XUARTPS_SR_TXEMPTY | XUARTPS_SR_RXEMPTY, true },
+	{ XPAR_PS7_UART_1_BASEADDR + XUARTPS_SR_OFFSET, XUARTPS_SR_TXEMPTY | XUARTPS_SR_RXEMPTY, true },
+	{ XPAR_XTTCPS_0_BASEADDR + XTTCPS_CNT_CNTRL_OFFSET, XTTCPS_CNT_CNTRL_RESET_VALUE, false },
+	{ XPAR_XTTCPS_1_BASEADDR + XTTCPS_CNT_CNTRL_OFFSET, XTTCPS_CNT_CNTRL_RESET_VALUE, false },
+	{ XPAR_XTTCPS_2_BASEADDR + XTTCPS_CNT_CNTRL_OFFSET, XTTCPS_CNT_CNTRL_RESET_VALUE, false },
+};
+
+/*
+ * Find the slot for a register.
+ * Inputs: Address, whether to claim a free slot.
+ * Outputs: Slot, or NULL if absent and not claimed.
+ */
+static sim_reg_t *sim_slot(UINTPTR addr, bool claim) {
+	// Variable declarations.
+	u32 h, n;
+	sim_reg_t *r;
+
+	h = (u32)((addr >> 2) * 0x9E3779B1U) % SIM_SLOTS;
+	for (n = 0; n < SIM_SLOTS; n++) {
+		r = &regs[(h + n) % SIM_SLOTS];
+		if (r->used && r->addr == addr)
+			return r;
+		if (!r->used) {
+			if (!claim)
+				return NULL;
+			r->used = true;
+			r->addr = addr;
+			return r;
+		}
+	}
+
+	fprintf(stderr, "Error: simulated register file full.\n");
+	exit(1);
+}
+
+/*
+ * Read a register.
+ * Inputs: Address.
+ * Outputs: Value last written, else the reset value.
+ */
+u32 sim_read32(UINTPTR addr) {
+	// Variable declarations.
+	sim_reg_t *r;
+	u32 n;
+
+	accesses++;
+	r = sim_slot(addr, false);
+	if (r != NULL)
+		return r->val;
+
+	for (n = 0; n < sizeof(resets) / sizeof(resets[0]); n++)
+		if (resets[n].addr == addr)
+			return resets[n].val;
+
+	return 0;
+}
+
+/*
+ * Write a register.
+ * Inputs: Address, value.
+ * Outputs: None.
+ */
+void sim_write32(UINTPTR addr, u32 val) {
+	// Variable declarations.
+	u32 n;
+
+	accesses++;
+
+	// Status registers keep their reset value; writes to them clear bits in hardware.
+	for (n = 0; n < sizeof(resets) / sizeof(resets[0]); n++)
+		if (resets[n].addr == addr && resets[n].status)
+			return;
+
+	sim_slot(addr, true)->val = val;
+}
+
+/*
+ * Count register accesses.
+ * Inputs: None.
+ * Outputs: Reads plus writes so far.
+ */
+u32 sim_accesses(void) {
+	return accesses;
+}
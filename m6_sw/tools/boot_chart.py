@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+#
+# boot_chart.py -- chart the fsbl boot stage times
+#
+# Author: Joshua M. Meise
+# Created: 10-19-2026
+# Version: 1.0
+#
+# Description: Reads the [boot ...] lines boottime_print writes at start-up
+# (or on the "boot" console command) and charts where the fsbl spent its
+# time. One boot prints a bar per stage; several boots (one capture of
+# repeated resets, or several captures) are summarised per stage with the
+# minimum, mean and maximum, so a change to the boot path can be checked
+# against the spread. --svg also draws each boot as a stacked bar. Other
+# console output is ignored.
+#
+# usage: boot_chart.py capture.txt
+#        boot_chart.py before.txt after.txt --svg boot.svg
+#        boot_chart.py - --csv < capture.txt
+#
+import argparse
+import re
+import sys
+
+HEADER = re.compile(r"\[boot hz (\d+) points (\d+) dropped (\d+)\]")
+POINT = re.compile(r"\[boot (\S+) (\S+) (\d+) (\d+)\]")
+TOTAL = re.compile(r"\[boot total (\d+)\]")
+COLOURS = ("#4e79a7", "#f28e2b", "#e15759", "#76b7b2", "#59a14f", "#edc948",
+           "#b07aa1", "#ff9da7", "#9c755f", "#bab0ac")
+
+
+def parse(text, source):
+    """List of boots, each {source, dropped, stages: [(label, end_us, us)], total}."""
+    boots, boot = [], None
+    for line in text.splitlines():
+        m = HEADER.search(line)
+        if m:
+            boot = {"source": source, "dropped": int(m.group(3)), "stages": [], "total": None}
+            boots.append(boot)
+            continue
+        if boot is None:
+            continue
+        m = TOTAL.search(line)
+        if m:
+            boot["total"] = int(m.group(1))
+            boot = None
+            continue
+        m = POINT.search(line)
+        if m:
+            stage, part = m.group(1), m.group(2)
+            label = stage if part == "-" else "%s.%s" % (stage, part)
+            boot["stages"].append((label, int(m.group(3)), int(m.group(4))))
+    for b in boots:
+        if b["total"] is None:
+            b["total"] = b["stages"][-1][1] if b["stages"] else 0
+    return [b for b in boots if b["stages"]]
+
+
+def read(path):
+    if path == "-":
+        return sys.stdin.read()
+    with open(path, errors="replace") as f:
+        return f.read()
+
+
+def bar(us, widest, width):
+    return "#" * (int(round(width * us / widest)) if widest else 0)
+
+
+def chart_one(boot, width):
+    widest = max(us for _, _, us in boot["stages"])
+    print("%-16s %10s %10s %6s" % ("stage", "end ms", "ms", "share"))
+    for label, end, us in boot["stages"]:
+        share = 100.0 * us / boot["total"] if boot["total"] else 0.0
+        print("%-16s %10.3f %10.3f %5.1f%% %s" % (label, end / 1000.0, us / 1000.0, share, bar(us, widest, width)))
+    print("%-16s %10.3f" % ("total", boot["total"] / 1000.0))
+    if boot["dropped"]:
+        print("(%d points did not fit in the log)" % boot["dropped"])
+
+
+def summarise(boots, width):
+    """Per-stage min/mean/max across boots, stages in first-seen order."""
+    order, times = [], {}
+    for b in boots:
+        for label, _, us in b["stages"]:
+            if label not in times:
+                order.append(label)
+                times[label] = []
+            times[label].append(us)
+    totals = [b["total"] for b in boots]
+    widest = max(max(v) for v in times.values())
+    print("%d boots" % len(boots))
+    print("%-16s %5s %10s %10s %10s" % ("stage", "boots", "min ms", "mean ms", "max ms"))
+    for label in order:
+        v = times[label]
+        mean = sum(v) / float(len(v))
+        print("%-16s %5d %10.3f %10.3f %10.3f %s" % (label, len(v), min(v) / 1000.0, mean / 1000.0,
+                                                    max(v) / 1000.0, bar(mean, widest, width)))
+    print("%-16s %5d %10.3f %10.3f %10.3f" % ("total", len(totals), min(totals) / 1000.0,
+                                             sum(totals) / 1000.0 / len(totals), max(totals) / 1000.0))
+
+
+def write_csv(boots):
+    print("boot,source,stage,end_us,us")
+    for n, b in enumerate(boots):
+        for label, end, us in b["stages"]:
+            print("%d,%s,%s,%d,%d" % (n, b["source"], label, end, us))
+
+
+def write_svg(boots, path):
+    """One stacked horizontal bar per boot, a colour per stage kind."""
+    row, left, scale_w = 28, 160, 800
+    longest = max(b["total"] for b in boots) or 1
+    kinds = []
+    for b in boots:
+        for label, _, _ in b["stages"]:
+            kind = label.split(".")[0]
+            if kind not in kinds:
+                kinds.append(kind)
+    height = row * (len(boots) + 2) + 20 * len(kinds)
+    out = ['<svg xmlns="http://www.w3.org/2000/svg" width="%d" height="%d" font-family="monospace" font-size="11">'
+           % (left + scale_w + 100, height)]
+    for n, b in enumerate(boots):
+        y = row * n + 10
+        out.append('<text x="4" y="%d">%s #%d</text>' % (y + 14, b["source"][-14:], n))
+        x = left
+        for label, _, us in b["stages"]:
+            w = scale_w * us / float(longest)
+            colour = COLOURS[kinds.index(label.split(".")[0]) % len(COLOURS)]
+            out.append('<rect x="%.1f" y="%d" width="%.1f" height="%d" fill="%s"><title>%s %.3f ms</title></rect>'
+                       % (x, y, w, row - 8, colour, label, us / 1000.0))
+            x += w
+        out.append('<text x="%.1f" y="%d">%.1f ms</text>' % (x + 4, y + 14, b["total"] / 1000.0))
+    y = row * len(boots) + 20
+    for n, kind in enumerate(kinds):
+        out.append('<rect x="%d" y="%d" width="12" height="12" fill="%s"/><text x="%d" y="%d">%s</text>'
+                   % (left, y + 20 * n, COLOURS[n % len(COLOURS)], left + 18, y + 20 * n + 10, kind))
+    out.append("</svg>")
+    with open(path, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Chart the fsbl boot stage times.")
+    ap.add_argument("captures", nargs="+", help="console captures; - for stdin")
+    ap.add_argument("--width", type=int, default=40, help="width of the longest text bar")
+    ap.add_argument("--csv", action="store_true", help="print every point as csv instead")
+    ap.add_argument("--svg", help="also draw the boots as stacked bars in this file")
+    args = ap.parse_args()
+
+    boots = []
+    for path in args.captures:
+        boots += parse(read(path), path)
+    if not boots:
+        sys.exit("no [boot ...] lines in %s" % " ".join(args.captures))
+
+    if args.csv:
+        write_csv(boots)
+    elif len(boots) == 1:
+        chart_one(boots[0], args.width)
+    else:
+        summarise(boots, args.width)
+
+    if args.svg:
+        write_svg(boots, args.svg)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,503 @@
+/*
+ * main.c -- compress the partitions of a boot image for the fsbl
+ *
+ * Author: Joshua M. Meise
+ * Created: 10-19-2026
+ * Version: 1.0
+ *
+ * Description: Rewrites a bootgen BOOT.BIN so the fsbl reads its PS and PL
+ * partitions as LZ4 frames (zynq_fsbl/lz4.h). Each partition is
+ * compressed in place: it keeps its start, the frame is padded to a word
+ * and the rest of the old partition is filled with 0xFF, so the image
+ * layout, the multiboot offsets and the checksum locations are unchanged
+ * and only the bytes the fsbl reads shrink. The word lengths and the
+ * compressed attribute go into the partition header, whose checksum is
+ * redone, and the MD5 of a checksummed partition is recomputed over the
+ * compressed bytes. Partitions that do not shrink are left alone;
+ * encrypted partitions do not compress and signed ones would need signing
+ * again, so images with either are refused.
+ *
+ * Every frame is decoded again with the fsbl decoder and compared before
+ * the image is written, and the decode is timed on the host.
+ * Usage: lz4part [-p partition]... in.bin out.bin
+ */
+
+// Library inclusions.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "lz4.h"
+#include "md5.h"
+#include "xstatus.h"
+
+// Predefined constants.
+#define PHDR_TABLE_OFFSET 0x9C		/* boot header word: partition headers */
+#define PHDR_SIZE 64
+#define PHDR_WORDS 16
+#define MAX_PARTITIONS 14
+#define W_IMAGE_LEN 0
+#define W_DATA_LEN 1
+#define W_PART_LEN 2
+#define W_LOAD 3
+#define W_START 5
+#define W_ATTR 6
+#define W_CHECKSUM_OFFSET 8
+#define W_HDR_CHECKSUM 15
+
+#define ATTR_PS 0x10
+#define ATTR_PL 0x20
+#define ATTR_CHECKSUM 0x7000
+#define ATTR_RSA 0x8000
+#define ATTR_OWNER 0x30000
+#define ATTR_COMPRESSED 0x40000		/* ATTRIBUTE_COMPRESSED_MASK */
+
+#define BLOCK_SIZE LZ4_MAX_BLOCK_SIZE
+#define HASH_LOG 16
+#define MIN_MATCH 4
+#define MF_LIMIT 12					/* a match starts at least this far from the end */
+#define LAST_LITERALS 5				/* a block ends with at least this many literals */
+#define MAX_OFFSET 65535
+#define BENCH_SECONDS 0.2
+
+// Global variables.
+static int hashTable[1 << HASH_LOG];
+
+/*
+ * Little-endian word access.
+ * Inputs: Buffer, byte offset (and value).
+ * Outputs: Word.
+ */
+static u32 get32(const u8 *p) {
+	return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) | ((u32)p[3] << 24);
+}
+
+static void put32(u8 *p, u32 v) {
+	p[0] = (u8)v;
+	p[1] = (u8)(v >> 8);
+	p[2] = (u8)(v >> 16);
+	p[3] = (u8)(v >> 24);
+}
+
+/*
+ * Seconds on the monotonic clock.
+ * Inputs: None.
+ * Outputs: Seconds.
+ */
+static double now(void) {
+	// Variable declarations.
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * xxHash32 of fewer than 16 bytes, for the frame header checksum.
+ * Inputs: Data, length.
+ * Outputs: Hash with seed 0.
+ */
+static u32 xxh32_short(const u8 *p, u32 len) {
+	// Predefined constants.
+	const u32 p1 = 2654435761U, p2 = 2246822519U, p3 = 3266489917U;
+	const u32 p4 = 668265263U, p5 = 374761393U;
+	// Variable declarations.
+	u32 h = p5 + len;
+
+	for (; len >= 4; p += 4, len -= 4) {
+		h += get32(p) * p3;
+		h = ((h << 17) | (h >> 15)) * p4;
+	}
+	for (; len > 0; p++, len--) {
+		h += *p * p5;
+		h = ((h << 11) | (h >> 21)) * p1;
+	}
+	h ^= h >> 15;
+	h *= p2;
+	h ^= h >> 13;
+	h *= p3;
+	h ^= h >> 16;
+	return h;
+}
+
+/*
+ * Write an LZ4 length extension.
+ * Inputs: Output position, remaining length.
+ * Outputs: New output position.
+ */
+static u8 *put_length(u8 *op, u32 len) {
+	for (; len >= 255; len -= 255)
+		*op++ = 255;
+	*op++ = (u8)len;
+	return op;
+}
+
+/*
+ * Write one sequence: literals, then a match unless <mlen> is 0.
+ * Inputs: Output position, output end, literals, literal count, offset, match length.
+ * Outputs: New output position, or NULL if it does not fit.
+ */
+static u8 *put_sequence(u8 *op, u8 *oend, const u8 *lit, u32 nlit, u32 offset, u32 mlen) {
+	// Variable declarations.
+	u8 *token = op++;
+
+	// Worst case for the extensions, the offset and the literals.
+	if ((u32)(oend - op) < nlit + nlit / 255 + mlen / 255 + 8)
+		return NULL;
+
+	*token = (u8)((nlit >= 15 ? 15 : nlit) << 4);
+	if (nlit >= 15)
+		op = put_length(op, nlit - 15);
+	memcpy(op, lit, nlit);
+	op += nlit;
+	if (mlen == 0)
+		return op;
+
+	*op++ = (u8)offset;
+	*op++ = (u8)(offset >> 8);
+	mlen -= MIN_MATCH;
+	*token |= (u8)(mlen >= 15 ? 15 : mlen);
+	if (mlen >= 15)
+		op = put_length(op, mlen - 15);
+	return op;
+}
+
+/*
+ * Greedy LZ4 compression of one independent block.
+ * Inputs: Source, length, destination, capacity.
+ * Outputs: Compressed length, or 0 if it does not shrink.
+ */
+static u32 compress_block(const u8 *src, u32 len, u8 *dst, u32 cap) {
+	// Variable declarations.
+	u8 *op = dst, *oend = dst + (cap < len ? cap : len);
+	u32 ip = 0, anchor = 0, ref, seq, h, mlen;
+
+	memset(hashTable, 0xFF, sizeof(hashTable));
+
+	while (len > MF_LIMIT && ip < len - MF_LIMIT) {
+		seq = get32(src + ip);
+		h = (seq * 2654435761U) >> (32 - HASH_LOG);
+		ref = (u32)hashTable[h];
+		hashTable[h] = (int)ip;
+		if (ref == 0xFFFFFFFFU || ip - ref > MAX_OFFSET || get32(src + ref) != seq) {
+			ip++;
+			continue;
+		}
+
+		for (mlen = MIN_MATCH; ip + mlen < len - LAST_LITERALS && src[ref + mlen] == src[ip + mlen]; mlen++)
+			;
+		op = put_sequence(op, oend, src + anchor, ip - anchor, ip - ref, mlen);
+		if (op == NULL)
+			return 0;
+		ip += mlen;
+		anchor = ip;
+	}
+
+	op = put_sequence(op, oend, src + anchor, len - anchor, 0, 0);
+	if (op == NULL || (u32)(op - dst) >= len)
+		return 0;
+	return (u32)(op - dst);
+}
+
+/*
+ * Build a frame: 64 KB independent blocks, content size, no checksums,
+ * padded with zeros to a word.
+ * Inputs: Source, length, output of at least frame_bound(len) bytes.
+ * Outputs: Frame length.
+ */
+static u32 frame_bound(u32 len) {
+	return LZ4_FRAME_HEADER_SIZE + (len / BLOCK_SIZE + 1) * 4 + len + 8;
+}
+
+static u32 compress_frame(const u8 *src, u32 len, u8 *dst) {
+	// Variable declarations.
+	u8 *op = dst;
+	u32 off, n, c;
+
+	put32(op, LZ4_FRAME_MAGIC);
+	op[4] = LZ4_FLG_VERSION | LZ4_FLG_BLOCK_INDEP | LZ4_FLG_CONTENT_SIZE;
+	op[5] = 4 << LZ4_BD_MAX_SIZE_SHIFT;
+	put32(op + 6, len);
+	put32(op + 10, 0);
+	op[14] = (u8)(xxh32_short(op + 4, 10) >> 8);
+	op += LZ4_FRAME_HEADER_SIZE;
+
+	for (off = 0; off < len; off += n) {
+		n = (len - off < BLOCK_SIZE) ? len - off : BLOCK_SIZE;
+		c = compress_block(src + off, n, op + 4, n);
+		if (c == 0) {
+			put32(op, n | LZ4_BLOCK_UNCOMPRESSED);
+			memcpy(op + 4, src + off, n);
+			c = n;
+		} else {
+			put32(op, c);
+		}
+		op += 4 + c;
+	}
+	put32(op, 0);
+	op += 4;
+
+	while ((op - dst) & 3)
+		*op++ = 0;
+	return (u32)(op - dst);
+}
+
+/*
+ * Decode a frame the way the fsbl does, a block at a time through
+ * Lz4DecodeBlock, with the buffer rules of a bitstream if <pl> is set.
+ * Inputs: Frame, length, output, output capacity, pl flag.
+ * Outputs: Decoded length, or -1 on error.
+ */
+static long decode_frame(const u8 *src, u32 len, u8 *dst, u32 cap, int pl) {
+	// Variable declarations.
+	Lz4FrameInfo frame;
+	u32 off, word, blen, tail, room, produced, done = 0;
+
+	if (len < LZ4_FRAME_HEADER_SIZE + 4 || Lz4ParseFrame(src, len, &frame) != XST_SUCCESS ||
+			frame.BlockMax > LZ4_MAX_BLOCK_SIZE || frame.ContentSize > cap ||
+			(pl && (!frame.Independent || (frame.ContentSize & 3))))
+		return -1;
+
+	tail = frame.BlockChecksum ? 4 : 0;
+	word = get32(src + LZ4_FRAME_HEADER_SIZE);
+	for (off = LZ4_FRAME_HEADER_SIZE + 4; word != 0; off += blen + tail + 4) {
+		blen = word & LZ4_BLOCK_SIZE_MASK;
+		if (blen == 0 || blen > frame.BlockMax || blen + tail + 4 > len - off)
+			return -1;
+		room = frame.ContentSize - done;
+		if (room > frame.BlockMax)
+			room = frame.BlockMax;
+		if (word & LZ4_BLOCK_UNCOMPRESSED) {
+			if (blen > room)
+				return -1;
+			memcpy(dst + done, src + off, blen);
+			produced = blen;
+		} else if (Lz4DecodeBlock(src + off, blen, dst + done, room,
+				frame.Independent ? dst + done : dst, &produced) != XST_SUCCESS) {
+			return -1;
+		}
+		if (produced == 0 || (pl && (produced & 3)))
+			return -1;
+		done += produced;
+		word = get32(src + off + blen + tail);
+	}
+	return done == frame.ContentSize ? (long)done : -1;
+}
+
+/*
+ * Check the decoder against hand-built frames: the shortest sequences,
+ * an overlapping match, bad offsets and lengths, and truncation.
+ * Inputs: None.
+ * Outputs: Number of failures.
+ */
+static int check(void) {
+	// Variable declarations.
+	static const u8 good[] = { 0x11, 'a', 1, 0, 0x30, 'x', 'y', 'z' };	/* "aaaaaa" + "xyz" */
+	static const u8 far[] = { 0x10, 'a', 2, 0, 0x10, 'b' };				/* offset before the output */
+	static const u8 longer[] = { 0x10, 'a', 1, 0 };						/* ends on a match */
+	static const u8 runon[] = { 0xF0, 0xFF };							/* length runs off the end */
+	static const u8 *bad[] = { far, longer, runon };
+	static const u32 badLen[] = { sizeof(far), sizeof(longer), sizeof(runon) };
+	static u8 src[3 * BLOCK_SIZE + 77], frame[3 * BLOCK_SIZE + 4096], out[3 * BLOCK_SIZE + 77];
+	u8 tiny[16];
+	u32 produced, i, len, n;
+	int fail = 0;
+
+	if (Lz4DecodeBlock(good, sizeof(good), tiny, sizeof(tiny), tiny, &produced) != XST_SUCCESS ||
+			produced != 9 || memcmp(tiny, "aaaaaaxyz", 9) != 0) {
+		printf("Error decoding the overlapping match.\n");
+		fail++;
+	}
+	if (Lz4DecodeBlock(good, sizeof(good), tiny, 8, tiny, &produced) == XST_SUCCESS) {
+		printf("Error overrun not caught.\n");
+		fail++;
+	}
+	for (i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+		if (Lz4DecodeBlock(bad[i], badLen[i], tiny, sizeof(tiny), tiny, &produced) == XST_SUCCESS) {
+			printf("Error bad block %lu decoded.\n", (unsigned long)i);
+			fail++;
+		}
+	}
+
+	// Round trips of text-like, random and constant data at awkward lengths.
+	srand(1);
+	for (i = 0; i < sizeof(src); i++)
+		src[i] = (i < BLOCK_SIZE) ? "the quick brown fox "[(i * 7 / 5) % 20] :
+			(i < 2 * BLOCK_SIZE) ? (u8)rand() : 0;
+	for (len = 1; len <= sizeof(src); len = len * 3 + 1) {
+		n = compress_frame(src, len, frame);
+		if (decode_frame(frame, n, out, sizeof(out), 0) != (long)len || memcmp(src, out, len) != 0) {
+			printf("Error round trip of %lu bytes.\n", (unsigned long)len);
+			fail++;
+		}
+		// Any truncation must fail cleanly.
+		if (len > 1000 && decode_frame(frame, n / 2, out, sizeof(out), 0) >= 0) {
+			printf("Error truncated frame of %lu bytes decoded.\n", (unsigned long)len);
+			fail++;
+		}
+	}
+
+	return fail;
+}
+
+/*
+ * Print the usage.
+ * Inputs: None.
+ * Outputs: None.
+ */
+static void usage(void) {
+	printf("Usage: lz4part [-p partition]... in.bin out.bin\n");
+	printf("  -p n   compress partition n only (repeatable; default all PS and PL)\n");
+}
+
+int main(int argc, char *argv[]) {
+	// Variable declarations.
+	FILE *f;
+	u8 *image, *frame, *out, *ph;
+	long size, decoded;
+	u32 table, n, count, start, len, flen, words, attr, sum, w, reps, saved = 0;
+	u32 chosen = 0;
+	double t;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "p:h")) != -1) {
+		if (opt == 'p' && atoi(optarg) > 0 && atoi(optarg) < MAX_PARTITIONS) {
+			chosen |= 1U << atoi(optarg);
+		} else {
+			usage();
+			return 2;
+		}
+	}
+	if (argc - optind != 2) {
+		usage();
+		return 2;
+	}
+
+	if (check() != 0)
+		return 1;
+	printf("[lz4part check ok]\n");
+
+	// Read the image.
+	if ((f = fopen(argv[optind], "rb")) == NULL) {
+		printf("Error opening %s.\n", argv[optind]);
+		return 1;
+	}
+	fseek(f, 0, SEEK_END);
+	size = ftell(f);
+	rewind(f);
+	image = malloc(size);
+	if (image == NULL || size < PHDR_TABLE_OFFSET + 4 || fread(image, 1, size, f) != (size_t)size) {
+		printf("Error reading %s.\n", argv[optind]);
+		return 1;
+	}
+	fclose(f);
+
+	table = get32(image + PHDR_TABLE_OFFSET);
+
+	// Headers up to the terminating one (all zero with a checksum of ones).
+	for (count = 0; count < MAX_PARTITIONS; count++) {
+		if (table + (count + 1) * PHDR_SIZE > (u32)size) {
+			printf("Error partition header table runs off the image.\n");
+			return 1;
+		}
+		ph = image + table + count * PHDR_SIZE;
+		for (w = 0; w < W_HDR_CHECKSUM && get32(ph + 4 * w) == 0; w++)
+			;
+		if (w == W_HDR_CHECKSUM && get32(ph + 4 * W_HDR_CHECKSUM) == 0xFFFFFFFFU)
+			break;
+		attr = get32(ph + 4 * W_ATTR);
+		if (attr & ATTR_RSA) {
+			printf("Error partition %lu is signed; compress the image before signing.\n", (unsigned long)count);
+			return 1;
+		}
+		if (get32(ph + 4 * W_IMAGE_LEN) != get32(ph + 4 * W_DATA_LEN)) {
+			printf("Error partition %lu is encrypted and will not compress.\n", (unsigned long)count);
+			return 1;
+		}
+	}
+
+	printf("[lz4part partition type bytes compressed percent decode_MB/s]\n");
+
+	// Partition 0 is the fsbl, which the boot rom loads.
+	for (n = 1; n < count; n++) {
+		ph = image + table + n * PHDR_SIZE;
+		attr = get32(ph + 4 * W_ATTR);
+		start = get32(ph + 4 * W_START) * 4;
+		len = get32(ph + 4 * W_IMAGE_LEN) * 4;
+
+		if ((chosen && !(chosen & (1U << n))) || !(attr & (ATTR_PS | ATTR_PL)) ||
+				(attr & (ATTR_OWNER | ATTR_COMPRESSED)) || len == 0)
+			continue;
+		if (start + len > (u32)size || get32(ph + 4 * W_PART_LEN) * 4 < len) {
+			printf("Error partition %lu runs off the image.\n", (unsigned long)n);
+			return 1;
+		}
+
+		frame = malloc(frame_bound(len));
+		out = malloc(len);
+		if (frame == NULL || out == NULL) {
+			printf("Error allocating %lu bytes.\n", (unsigned long)len);
+			return 1;
+		}
+		flen = compress_frame(image + start, len, frame);
+		if (flen >= len) {
+			printf("[lz4part %lu %s %lu - - -]\n", (unsigned long)n, (attr & ATTR_PL) ? "pl" : "ps",
+					(unsigned long)len);
+			free(frame);
+			free(out);
+			continue;
+		}
+
+		// Decode it as the fsbl will, and time that.
+		reps = 0;
+		t = now();
+		do {
+			decoded = decode_frame(frame, flen, out, len, (attr & ATTR_PL) != 0);
+			reps++;
+		} while (decoded == (long)len && now() - t < BENCH_SECONDS);
+		t = (now() - t) / reps;
+		if (decoded != (long)len || memcmp(out, image + start, len) != 0) {
+			printf("Error partition %lu does not decode to the original.\n", (unsigned long)n);
+			return 1;
+		}
+
+		// Frame in place, the rest of the old partition erased flash.
+		memcpy(image + start, frame, flen);
+		memset(image + start + flen, 0xFF, get32(ph + 4 * W_PART_LEN) * 4 - flen);
+		words = flen / 4;
+		put32(ph + 4 * W_IMAGE_LEN, words);
+		put32(ph + 4 * W_DATA_LEN, words);
+		put32(ph + 4 * W_PART_LEN, words);
+		put32(ph + 4 * W_ATTR, attr | ATTR_COMPRESSED);
+
+		if (attr & ATTR_CHECKSUM) {
+			w = get32(ph + 4 * W_CHECKSUM_OFFSET) * 4;
+			if (w + 16 > (u32)size) {
+				printf("Error partition %lu checksum is off the image.\n", (unsigned long)n);
+				return 1;
+			}
+			md5(image + start, flen, image + w, FALSE);
+		}
+
+		for (sum = 0, w = 0; w < W_HDR_CHECKSUM; w++)
+			sum += get32(ph + 4 * w);
+		put32(ph + 4 * W_HDR_CHECKSUM, ~sum);
+
+		printf("[lz4part %lu %s %lu %lu %.1f %.0f]\n", (unsigned long)n, (attr & ATTR_PL) ? "pl" : "ps",
+				(unsigned long)len, (unsigned long)flen, 100.0 * flen / len, len / t / 1e6);
+		saved += len - flen;
+		free(frame);
+		free(out);
+	}
+
+	if ((f = fopen(argv[optind + 1], "wb")) == NULL || fwrite(image, 1, size, f) != (size_t)size) {
+		printf("Error writing %s.\n", argv[optind + 1]);
+		return 1;
+	}
+	fclose(f);
+	printf("[lz4part saves %lu bytes of flash reads]\n", (unsigned long)saved);
+
+	free(image);
+	return 0;
+}
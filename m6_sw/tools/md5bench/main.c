@@ -0,0 +1,279 @@
+/*
+ * main.c -- host benchmark for the fsbl md5
+ *
+ * Author: Joshua M. Meise
+ * Created: 10-19-2026
+ * Version: 1.0
+ *
+ * Description: Checks the fsbl md5 against the rfc 1321 vectors and the
+ * original byte-copy update, then times four ways of getting a partition
+ * into memory and hashed: the original update, the in-place update, a
+ * memcpy followed by md5, and the fused copy-and-hash. The source starts
+ * five bytes into its buffer as in the qspi read path. Prints MB/s and the
+ * time each takes on a bitstream of the given size.
+ * Usage: md5bench [megabytes]
+ */
+
+// Library inclusions.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "md5.h"
+
+// Predefined constants.
+#define DEFAULT_MB 4
+#define REPEATS 5
+#define CHUNK 4096			/* qspi non-linear read size */
+#define SKEW 5				/* data offset in the qspi read buffer */
+
+typedef enum { LEGACY, INPLACE, COPYHASH, FUSED, METHODS } method_t;
+
+static const char *names[METHODS] = { "legacy", "inplace", "memcpy+md5", "fused" };
+
+/*
+ * The update as shipped before: every block is copied byte by byte into
+ * the context before the transform.
+ * Inputs: Context, data, length, byte swap.
+ * Outputs: None.
+ */
+static void legacy_update(MD5Context *context, u8 *buffer, u32 len, boolean doByteSwap) {
+	// Variable declarations.
+	u32 temp;
+	u8 *p;
+
+	temp = context->bits[0];
+	if ((context->bits[0] = temp + (len << 3)) < temp)
+		context->bits[1]++;
+	context->bits[1] += len >> 29;
+	temp = (temp >> 3) & 0x3f;
+
+	if (temp) {
+		p = (u8 *)context->intermediate + temp;
+		temp = 64 - temp;
+		if (len < temp) {
+			MD5Memcpy(p, buffer, len, doByteSwap);
+			return;
+		}
+		MD5Memcpy(p, buffer, temp, doByteSwap);
+		MD5Transform(context->buffer, (u32 *)context->intermediate);
+		buffer += temp;
+		len -= temp;
+	}
+
+	while (len >= 64) {
+		if (doByteSwap) {
+			MD5Memcpy(context->intermediate, buffer, 64, doByteSwap);
+		} else {
+			u8 *d = (u8 *)context->intermediate;
+			u32 n;
+			for (n = 0; n < 64; n++)
+				d[n] = buffer[n];
+		}
+		MD5Transform(context->buffer, (u32 *)context->intermediate);
+		buffer += 64;
+		len -= 64;
+	}
+
+	MD5Memcpy(context->intermediate, buffer, len, doByteSwap);
+}
+
+/*
+ * Seconds on the monotonic clock.
+ * Inputs: None.
+ * Outputs: Seconds.
+ */
+static double now(void) {
+	// Variable declarations.
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Move <len> bytes from <src> to <dst> in qspi-sized chunks and hash them.
+ * Inputs: Method, destination, source, length, digest.
+ * Outputs: None.
+ */
+static void run(method_t m, u8 *dst, u8 *src, u32 len, u8 *digest) {
+	// Variable declarations.
+	MD5Context ctx;
+	u32 off, n;
+
+	MD5Init(&ctx);
+	switch (m) {
+	case LEGACY:
+		for (off = 0; off < len; off += n) {
+			n = (len - off < CHUNK) ? len - off : CHUNK;
+			memcpy(dst + off, src + off, n);
+		}
+		legacy_update(&ctx, dst, len, FALSE);
+		break;
+	case INPLACE:
+		for (off = 0; off < len; off += n) {
+			n = (len - off < CHUNK) ? len - off : CHUNK;
+			memcpy(dst + off, src + off, n);
+		}
+		MD5Update(&ctx, dst, len, FALSE);
+		break;
+	case COPYHASH:
+		for (off = 0; off < len; off += n) {
+			n = (len - off < CHUNK) ? len - off : CHUNK;
+			memcpy(dst + off, src + off, n);
+			MD5Update(&ctx, dst + off, n, FALSE);
+		}
+		break;
+	case FUSED:
+		for (off = 0; off < len; off += n) {
+			n = (len - off < CHUNK) ? len - off : CHUNK;
+			MD5CopyUpdate(&ctx, dst + off, src + off, n, FALSE);
+		}
+		break;
+	default:
+		break;
+	}
+	MD5Final(&ctx, digest, FALSE);
+}
+
+/*
+ * Format a digest as hex.
+ * Inputs: Digest, output of at least 33 bytes.
+ * Outputs: Output.
+ */
+static char *hex(const u8 *digest, char *out) {
+	// Variable declarations.
+	int i;
+
+	for (i = 0; i < 16; i++)
+		sprintf(out + 2 * i, "%02x", digest[i]);
+	return out;
+}
+
+/*
+ * Check the rfc 1321 test suite, odd lengths, unaligned input and byte
+ * swapping against the original update.
+ * Inputs: None.
+ * Outputs: Number of failures.
+ */
+static int check(void) {
+	// Variable declarations.
+	static const char *vec[][2] = {
+		{ "", "d41d8cd98f00b204e9800998ecf8427e" },
+		{ "a", "0cc175b9c0f1b6a831c399e269772661" },
+		{ "abc", "900150983cd24fb0d6963f7d28e17f72" },
+		{ "message digest", "f96b697d7cb7938d525a2f31aaf161d0" },
+		{ "abcdefghijklmnopqrstuvwxyz", "c3fcd3d76192e4007dfb496cca67e13b" },
+		{ "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", "d174ab98d277d9f5a5611c2c9f419d9f" },
+		{ "12345678901234567890123456789012345678901234567890123456789012345678901234567890", "57edf4a22be3c955ac49da2e2107b67a" },
+	};
+	static u8 src[4096 + 8], dst[4096 + 8];
+	u8 d1[16], d2[16];
+	char h[33];
+	MD5Context ctx;
+	u32 i, len, off, step;
+	int fail = 0;
+	boolean swap;
+
+	for (i = 0; i < sizeof(vec) / sizeof(vec[0]); i++) {
+		md5((u8 *)vec[i][0], strlen(vec[i][0]), d1, FALSE);
+		if (strcmp(hex(d1, h), vec[i][1]) != 0) {
+			printf("Error md5(\"%s\") = %s\n", vec[i][0], h);
+			fail++;
+		}
+	}
+
+	for (i = 0; i < sizeof(src); i++)
+		src[i] = (u8)(i * 131 + 7);
+
+	for (swap = FALSE; swap <= TRUE; swap++) {
+		for (off = 0; off < 4; off++) {
+			for (len = 0; len < 4096; len += (swap ? 4 : 1) * (len < 200 ? 1 : 61)) {
+				MD5Init(&ctx);
+				legacy_update(&ctx, src + off, len, swap);
+				MD5Final(&ctx, d1, swap);
+
+				// The swap path only supports whole words, as before.
+				md5(src + off, len, d2, swap);
+				if (memcmp(d1, d2, 16) != 0) {
+					printf("Error md5 len %lu offset %lu swap %d\n", (unsigned long)len, (unsigned long)off, swap);
+					fail++;
+				}
+
+				// Fused, fed in uneven pieces so partial blocks are exercised.
+				memset(dst, 0, sizeof(dst));
+				MD5Init(&ctx);
+				for (i = 0, step = 1; i < len; i += step, step = step * 3 + 4) {
+					if (swap)
+						step = (step + 3) & ~3U;
+					if (step > len - i)
+						step = len - i;
+					MD5CopyUpdate(&ctx, dst + off + i, src + off + i, step, swap);
+				}
+				MD5Final(&ctx, d2, swap);
+				if (memcmp(d1, d2, 16) != 0 || memcmp(dst + off, src + off, len) != 0) {
+					printf("Error fused len %lu offset %lu swap %d\n", (unsigned long)len, (unsigned long)off, swap);
+					fail++;
+				}
+			}
+		}
+	}
+
+	return fail;
+}
+
+int main(int argc, char *argv[]) {
+	// Variable declarations.
+	u32 mb = (argc > 1) ? (u32)atoi(argv[1]) : DEFAULT_MB;
+	u32 len, i;
+	u8 *buf, *src, *dst;
+	u8 digest[METHODS][16];
+	double best[METHODS], t;
+	char h[33];
+	int m, r;
+
+	if (mb == 0) {
+		printf("Usage: md5bench [megabytes]\n");
+		return 2;
+	}
+
+	if (check() != 0)
+		return 1;
+	printf("[md5 check ok]\n");
+
+	len = mb << 20;
+	buf = aligned_alloc(64, len + 64);
+	dst = aligned_alloc(64, len);
+	if (buf == NULL || dst == NULL) {
+		printf("Error allocating %lu bytes.\n", (unsigned long)len);
+		return 1;
+	}
+	src = buf + SKEW;
+	for (i = 0; i < len; i++)
+		src[i] = (u8)(i ^ (i >> 9));
+
+	printf("[md5 method MB/s ms digest]\n");
+	for (m = 0; m < METHODS; m++) {
+		best[m] = 1e9;
+		for (r = 0; r < REPEATS; r++) {
+			memset(dst, 0, len);
+			t = now();
+			run((method_t)m, dst, src, len, digest[m]);
+			t = now() - t;
+			if (t < best[m])
+				best[m] = t;
+		}
+		if (memcmp(digest[m], digest[LEGACY], 16) != 0 || memcmp(dst, src, len) != 0) {
+			printf("Error %s disagrees with legacy.\n", names[m]);
+			return 1;
+		}
+		printf("[md5 %s %.1f %.2f %s]\n", names[m], len / best[m] / 1e6, best[m] * 1e3, hex(digest[m], h));
+	}
+
+	printf("[md5 bitstream %lu MB saves %.2f ms of %.2f ms]\n", (unsigned long)mb,
+			(best[LEGACY] - best[FUSED]) * 1e3, best[LEGACY] * 1e3);
+
+	free(buf);
+	free(dst);
+	return 0;
+}
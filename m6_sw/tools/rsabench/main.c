@@ -0,0 +1,600 @@
+/*
+ * main.c -- host benchmark for the fsbl partition authentication
+ *
+ * Author: Joshua M. Meise
+ * Created: 10-19-2026
+ * Version: 1.0
+ *
+ * Description: Checks the fsbl sha256 against the fips 180 vectors and,
+ * fed in uneven pieces, against the library, and the fsbl rsa-2048 public key
+ * operation against a slow schoolbook computation on random keys, then
+ * times both against the library: sha-256 throughput one-shot and in
+ * pipelined load sized chunks, the latency of one signature check, and
+ * the authentication of a partition of the given size. The library is a
+ * reference written like xilrsa, or librsa.a itself when built with
+ * XILRSA=1.
+ * Usage: rsabench [megabytes]
+ */
+
+// Library inclusions.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sha256.h"
+#include "mont.h"
+#include "xstatus.h"
+#ifdef XILRSA
+#include "xilrsa.h"
+#endif
+
+// Predefined constants.
+#define DEFAULT_MB 4
+#define REPEATS 5
+#define VERIFIES 200		/* signature checks per timing */
+#define KEYS 16				/* random keys checked */
+#define CHUNK 0x10000		/* PIPE_CHUNK_SIZE of the pipelined load */
+#define SPK_BYTES 576		/* spk modulus, extension and exponent */
+#define PUBLIC_EXP 65537U
+#define DIGITS MONT_DIGITS
+
+#ifdef XILRSA
+#define LIBRARY "xilrsa"
+
+typedef sha2_context lib_sha_t;
+
+static void lib_sha_init(lib_sha_t *ctx) { sha2_starts(ctx); }
+static void lib_sha_update(lib_sha_t *ctx, const u8 *data, u32 len) { sha2_update(ctx, (u8 *)data, len); }
+static void lib_sha_final(lib_sha_t *ctx, u8 *hash) { sha2_finish(ctx, hash); }
+static void lib_sha(const u8 *data, u32 len, u8 *hash) { sha_256(data, len, hash); }
+
+static void lib_pubexp(u32 *r, const u32 *x, u32 e, const u32 *n, const u32 *rr) {
+	rsa2048_pubexp((RSA_NUMBER)r, (RSA_NUMBER)x, e, (RSA_NUMBER)n, (RSA_NUMBER)rr);
+}
+#else
+#define LIBRARY "reference"
+
+typedef struct {
+	u32 state[8];
+	u8 buffer[64];
+	u64 bytes;
+} lib_sha_t;
+
+static const u32 shaK[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define ROR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+/*
+ * The library block function: the whole 64 word schedule, then a rolled
+ * round loop that moves the working variables.
+ * Inputs: State, block in the context buffer.
+ * Outputs: None.
+ */
+static void lib_sha_block(u32 *state, const u8 *block) {
+	// Variable declarations.
+	u32 w[64], v[8], t1, t2;
+	int i;
+
+	for (i = 0; i < 16; i++)
+		w[i] = ((u32)block[4 * i] << 24) | ((u32)block[4 * i + 1] << 16) | ((u32)block[4 * i + 2] << 8) | block[4 * i + 3];
+	for (i = 16; i < 64; i++)
+		w[i] = (ROR(w[i - 2], 17) ^ ROR(w[i - 2], 19) ^ (w[i - 2] >> 10)) + w[i - 7] +
+			(ROR(w[i - 15], 7) ^ ROR(w[i - 15], 18) ^ (w[i - 15] >> 3)) + w[i - 16];
+
+	memcpy(v, state, sizeof(v));
+	for (i = 0; i < 64; i++) {
+		t1 = v[7] + (ROR(v[4], 6) ^ ROR(v[4], 11) ^ ROR(v[4], 25)) + ((v[4] & v[5]) ^ (~v[4] & v[6])) + shaK[i] + w[i];
+		t2 = (ROR(v[0], 2) ^ ROR(v[0], 13) ^ ROR(v[0], 22)) + ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+		memmove(v + 1, v, 7 * sizeof(u32));
+		v[4] += t1;
+		v[0] = t1 + t2;
+	}
+	for (i = 0; i < 8; i++)
+		state[i] += v[i];
+}
+
+static void lib_sha_init(lib_sha_t *ctx) {
+	static const u32 iv[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+	memcpy(ctx->state, iv, sizeof(iv));
+	ctx->bytes = 0;
+}
+
+/*
+ * The library update: every byte goes through the context buffer.
+ * Inputs: Context, data, length.
+ * Outputs: None.
+ */
+static void lib_sha_update(lib_sha_t *ctx, const u8 *data, u32 len) {
+	// Variable declarations.
+	u32 fill, n;
+
+	while (len > 0) {
+		fill = (u32)(ctx->bytes & 63);
+		n = (64 - fill < len) ? 64 - fill : len;
+		memcpy(ctx->buffer + fill, data, n);
+		ctx->bytes += n;
+		data += n;
+		len -= n;
+		if (((fill + n) & 63) == 0)
+			lib_sha_block(ctx->state, ctx->buffer);
+	}
+}
+
+static void lib_sha_final(lib_sha_t *ctx, u8 *hash) {
+	// Variable declarations.
+	u64 bits = ctx->bytes << 3;
+	u8 pad[72];
+	u32 n = ((ctx->bytes & 63) < 56) ? 56 - (ctx->bytes & 63) : 120 - (ctx->bytes & 63);
+	int i;
+
+	memset(pad, 0, sizeof(pad));
+	pad[0] = 0x80;
+	for (i = 0; i < 8; i++)
+		pad[n + i] = (u8)(bits >> (56 - 8 * i));
+	lib_sha_update(ctx, pad, n + 8);
+	for (i = 0; i < 32; i++)
+		hash[i] = (u8)(ctx->state[i >> 2] >> (24 - 8 * (i & 3)));
+}
+
+static void lib_sha(const u8 *data, u32 len, u8 *hash) {
+	// Variable declarations.
+	lib_sha_t ctx;
+
+	lib_sha_init(&ctx);
+	lib_sha_update(&ctx, data, len);
+	lib_sha_final(&ctx, hash);
+}
+
+/*
+ * The library multiply: the full product first, then a separate
+ * Montgomery reduction pass over it, one digit at a time.
+ * Inputs: Result, factors, modulus, -1/n mod 2^32.
+ * Outputs: None.
+ */
+static void lib_mont(u32 *r, const u32 *a, const u32 *b, const u32 *n, u32 ninv) {
+	// Variable declarations.
+	u32 t[2 * DIGITS + 1], m, c;
+	u64 acc;
+	int i, j;
+
+	memset(t, 0, sizeof(t));
+	for (i = 0; i < DIGITS; i++) {
+		c = 0;
+		for (j = 0; j < DIGITS; j++) {
+			acc = (u64)a[j] * b[i] + t[i + j] + c;
+			t[i + j] = (u32)acc;
+			c = (u32)(acc >> 32);
+		}
+		t[i + DIGITS] = c;
+	}
+
+	for (i = 0; i < DIGITS; i++) {
+		m = t[i] * ninv;
+		c = 0;
+		for (j = 0; j < DIGITS; j++) {
+			acc = (u64)m * n[j] + t[i + j] + c;
+			t[i + j] = (u32)acc;
+			c = (u32)(acc >> 32);
+		}
+		for (j = i + DIGITS; c != 0 && j <= 2 * DIGITS; j++) {
+			acc = (u64)t[j] + c;
+			t[j] = (u32)acc;
+			c = (u32)(acc >> 32);
+		}
+	}
+
+	// Conditional subtract of the upper half.
+	for (i = DIGITS - 1; t[2 * DIGITS] == 0 && i >= 0; i--)
+		if (t[DIGITS + i] != n[i])
+			break;
+	if (t[2 * DIGITS] != 0 || i < 0 || t[DIGITS + i] > n[i]) {
+		c = 0;
+		for (j = 0; j < DIGITS; j++) {
+			acc = (u64)t[DIGITS + j] - n[j] - c;
+			t[DIGITS + j] = (u32)acc;
+			c = (u32)(acc >> 63);
+		}
+	}
+	memcpy(r, t + DIGITS, DIGITS * sizeof(u32));
+}
+
+static void lib_pubexp(u32 *r, const u32 *x, u32 e, const u32 *n, const u32 *rr) {
+	// Variable declarations.
+	u32 ninv = n[0], one[DIGITS], xm[DIGITS];
+	int i, bit;
+
+	for (i = 0; i < 4; i++)
+		ninv *= 2 - n[0] * ninv;
+	ninv = 0 - ninv;
+
+	memset(one, 0, sizeof(one));
+	one[0] = 1;
+	lib_mont(xm, x, rr, n, ninv);
+	memcpy(r, xm, sizeof(xm));
+	for (bit = 31; (e & (1U << bit)) == 0; bit--)
+		;
+	while (--bit >= 0) {
+		lib_mont(r, r, r, n, ninv);
+		if (e & (1U << bit))
+			lib_mont(r, r, xm, n, ninv);
+	}
+	lib_mont(r, r, one, n, ninv);
+}
+#endif
+
+// Global variables.
+static u32 seed = 0x12345678;
+
+/*
+ * Seconds on the monotonic clock.
+ * Inputs: None.
+ * Outputs: Seconds.
+ */
+static double now(void) {
+	// Variable declarations.
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Pseudo random words, the same on every run.
+ * Inputs: None.
+ * Outputs: Next word.
+ */
+static u32 rnd(void) {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+/*
+ * Format a hash as hex.
+ * Inputs: Hash, output of at least 65 bytes.
+ * Outputs: Output.
+ */
+static char *hex(const u8 *hash, char *out) {
+	// Variable declarations.
+	int i;
+
+	for (i = 0; i < SHA256_HASH_SIZE; i++)
+		sprintf(out + 2 * i, "%02x", hash[i]);
+	return out;
+}
+
+/*
+ * r = (r * 2 + bit) mod n, for r below n.
+ * Inputs: Number of DIGITS + 1 digits, bit, modulus.
+ * Outputs: None.
+ */
+static void shift_in(u32 *r, u32 bit, const u32 *n) {
+	// Variable declarations.
+	u32 c, top;
+	u64 acc;
+	int i;
+
+	for (i = DIGITS; i > 0; i--)
+		r[i] = (r[i] << 1) | (r[i - 1] >> 31);
+	r[0] = (r[0] << 1) | bit;
+
+	top = r[DIGITS];
+	for (i = DIGITS - 1; top == 0 && i >= 0; i--)
+		if (r[i] != n[i])
+			break;
+	if (top != 0 || i < 0 || r[i] > n[i]) {
+		c = 0;
+		for (i = 0; i < DIGITS; i++) {
+			acc = (u64)r[i] - n[i] - c;
+			r[i] = (u32)acc;
+			c = (u32)(acc >> 63);
+		}
+		r[DIGITS] -= c;
+	}
+}
+
+/*
+ * a * b mod n by schoolbook multiply and bit at a time reduction; slow
+ * but shares nothing with either Montgomery multiply.
+ * Inputs: Result, factors, modulus.
+ * Outputs: None.
+ */
+static void slow_mulmod(u32 *r, const u32 *a, const u32 *b, const u32 *n) {
+	// Variable declarations.
+	u32 p[2 * DIGITS], acc[DIGITS + 1], c;
+	u64 t;
+	int i, j;
+
+	memset(p, 0, sizeof(p));
+	for (i = 0; i < DIGITS; i++) {
+		c = 0;
+		for (j = 0; j < DIGITS; j++) {
+			t = (u64)a[j] * b[i] + p[i + j] + c;
+			p[i + j] = (u32)t;
+			c = (u32)(t >> 32);
+		}
+		p[i + DIGITS] = c;
+	}
+
+	memset(acc, 0, sizeof(acc));
+	for (i = 2 * DIGITS * 32 - 1; i >= 0; i--)
+		shift_in(acc, (p[i >> 5] >> (i & 31)) & 1, n);
+	memcpy(r, acc, DIGITS * sizeof(u32));
+}
+
+/*
+ * Random modulus with its top bit set, its R * R mod n, and a base below it.
+ * Inputs: Modulus, R * R mod n, base.
+ * Outputs: None.
+ */
+static void make_key(u32 *n, u32 *rr, u32 *x) {
+	// Variable declarations.
+	u32 acc[DIGITS + 1];
+	int i;
+
+	for (i = 0; i < DIGITS; i++) {
+		n[i] = rnd();
+		x[i] = rnd();
+	}
+	n[0] |= 1;
+	n[DIGITS - 1] |= 0x80000000U;
+	x[DIGITS - 1] &= 0x7fffffffU;
+
+	// 2^4096 mod n by doubling one.
+	memset(acc, 0, sizeof(acc));
+	acc[0] = 1;
+	for (i = 0; i < 2 * DIGITS * 32; i++)
+		shift_in(acc, 0, n);
+	memcpy(rr, acc, DIGITS * sizeof(u32));
+}
+
+/*
+ * Check the fips 180 vectors, the streaming interface in uneven pieces and
+ * at odd alignments against the library, and the public key operation on
+ * random keys and edge case bases against the slow computation.
+ * Inputs: None.
+ * Outputs: Number of failures.
+ */
+static int check(void) {
+	// Variable declarations.
+	static const char *vec[][2] = {
+		{ "", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+		{ "abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+		{ "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+		{ "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+			"cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1" },
+	};
+	static const u32 exps[] = { 1, 3, PUBLIC_EXP, 0xffffffffU };
+	static u8 src[4096 + 8];
+	u32 n[DIGITS], rr[DIGITS], x[DIGITS], r1[DIGITS], r2[DIGITS], r3[DIGITS];
+	u8 h1[SHA256_HASH_SIZE], h2[SHA256_HASH_SIZE];
+	char h[65];
+	u8 *million;
+	Sha256Context ctx;
+	u32 i, len, off, step, k, e, bit;
+	int fail = 0;
+
+	for (i = 0; i < sizeof(vec) / sizeof(vec[0]); i++) {
+		Sha256((const u8 *)vec[i][0], strlen(vec[i][0]), h1);
+		if (strcmp(hex(h1, h), vec[i][1]) != 0) {
+			printf("Error sha256(\"%s\") = %s\n", vec[i][0], h);
+			fail++;
+		}
+	}
+
+	million = malloc(1000000);
+	if (million == NULL)
+		return fail + 1;
+	memset(million, 'a', 1000000);
+	Sha256(million, 1000000, h1);
+	if (strcmp(hex(h1, h), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0") != 0) {
+		printf("Error sha256(a * 1000000) = %s\n", h);
+		fail++;
+	}
+	free(million);
+
+	for (i = 0; i < sizeof(src); i++)
+		src[i] = (u8)(i * 131 + 7);
+
+	for (off = 0; off < 4; off++) {
+		for (len = 0; len < 4096; len += (len < 200) ? 1 : 61) {
+			lib_sha(src + off, len, h1);
+
+			// Fed in uneven pieces so partial blocks are exercised.
+			Sha256Init(&ctx);
+			for (i = 0, step = 1; i < len; i += step, step = step * 3 + 4) {
+				if (step > len - i)
+					step = len - i;
+				Sha256Update(&ctx, src + off + i, step);
+			}
+			Sha256Final(&ctx, h2);
+			if (memcmp(h1, h2, SHA256_HASH_SIZE) != 0) {
+				printf("Error sha256 len %lu offset %lu\n", (unsigned long)len, (unsigned long)off);
+				fail++;
+			}
+		}
+	}
+
+	for (k = 0; k < KEYS; k++) {
+		make_key(n, rr, x);
+		if (k == 1)
+			memset(x, 0, sizeof(x));
+		if (k == 2) {
+			memcpy(x, n, sizeof(x));
+			x[0]--;
+		}
+
+		for (i = 0; i < sizeof(exps) / sizeof(exps[0]); i++) {
+			e = exps[i];
+			if (MontPubExp(r1, x, e, n, rr) != XST_SUCCESS) {
+				printf("Error pubexp key %lu failed\n", (unsigned long)k);
+				fail++;
+				continue;
+			}
+
+			// x^e mod n, square and multiply with the slow multiply.
+			memcpy(r3, x, sizeof(r3));
+			for (bit = 31; (e & (1U << bit)) == 0; bit--)
+				;
+			while (bit-- > 0) {
+				slow_mulmod(r3, r3, r3, n);
+				if (e & (1U << bit))
+					slow_mulmod(r3, r3, x, n);
+			}
+			lib_pubexp(r2, x, e, n, rr);
+			if (memcmp(r1, r3, sizeof(r1)) != 0 || memcmp(r2, r3, sizeof(r2)) != 0) {
+				printf("Error pubexp key %lu exponent %lu (%s %s)\n", (unsigned long)k, (unsigned long)e,
+						memcmp(r1, r3, sizeof(r1)) ? "fsbl" : "", memcmp(r2, r3, sizeof(r2)) ? LIBRARY : "");
+				fail++;
+			}
+		}
+	}
+
+	// An even modulus is refused.
+	n[0] &= ~1U;
+	if (MontPubExp(r1, x, PUBLIC_EXP, n, rr) != XST_FAILURE) {
+		printf("Error pubexp accepted an even modulus\n");
+		fail++;
+	}
+
+	return fail;
+}
+
+/*
+ * Best time of REPEATS to hash <len> bytes, one-shot or in CHUNK pieces.
+ * Inputs: Use the fsbl code, chunked, data, length, hash.
+ * Outputs: Seconds.
+ */
+static double time_sha(int fsbl, int chunked, const u8 *data, u32 len, u8 *hash) {
+	// Variable declarations.
+	Sha256Context ctx;
+	lib_sha_t lctx;
+	double best = 1e9, t;
+	u32 off, n;
+	int r;
+
+	for (r = 0; r < REPEATS; r++) {
+		t = now();
+		if (!chunked) {
+			if (fsbl)
+				Sha256(data, len, hash);
+			else
+				lib_sha(data, len, hash);
+		} else if (fsbl) {
+			Sha256Init(&ctx);
+			for (off = 0; off < len; off += n) {
+				n = (len - off < CHUNK) ? len - off : CHUNK;
+				Sha256Update(&ctx, data + off, n);
+			}
+			Sha256Final(&ctx, hash);
+		} else {
+			lib_sha_init(&lctx);
+			for (off = 0; off < len; off += n) {
+				n = (len - off < CHUNK) ? len - off : CHUNK;
+				lib_sha_update(&lctx, data + off, n);
+			}
+			lib_sha_final(&lctx, hash);
+		}
+		t = now() - t;
+		if (t < best)
+			best = t;
+	}
+	return best;
+}
+
+/*
+ * Best time of REPEATS for one signature check with e = 65537.
+ * Inputs: Use the fsbl code, modulus, R * R mod n, signature.
+ * Outputs: Seconds per check.
+ */
+static double time_verify(int fsbl, const u32 *n, const u32 *rr, const u32 *x) {
+	// Variable declarations.
+	u32 out[DIGITS];
+	double best = 1e9, t;
+	int r, i;
+
+	for (r = 0; r < REPEATS; r++) {
+		t = now();
+		for (i = 0; i < VERIFIES; i++) {
+			if (fsbl)
+				MontPubExp(out, x, PUBLIC_EXP, n, rr);
+			else
+				lib_pubexp(out, x, PUBLIC_EXP, n, rr);
+		}
+		t = (now() - t) / VERIFIES;
+		if (t < best)
+			best = t;
+	}
+	return best;
+}
+
+int main(int argc, char *argv[]) {
+	// Variable declarations.
+	u32 mb = (argc > 1) ? (u32)atoi(argv[1]) : DEFAULT_MB;
+	u32 len, i;
+	u32 n[DIGITS], rr[DIGITS], x[DIGITS];
+	u8 *data;
+	u8 hash[4][SHA256_HASH_SIZE];
+	double tLib, tFsbl, tLibChunk, tFsblChunk, vLib, vFsbl, sLib, sFsbl;
+	char h[65];
+
+	if (mb == 0) {
+		printf("Usage: rsabench [megabytes]\n");
+		return 2;
+	}
+
+	if (check() != 0)
+		return 1;
+	printf("[rsa check ok against %s]\n", LIBRARY);
+
+	len = mb << 20;
+	data = aligned_alloc(64, len);
+	if (data == NULL) {
+		printf("Error allocating %lu bytes.\n", (unsigned long)len);
+		return 1;
+	}
+	for (i = 0; i < len; i++)
+		data[i] = (u8)(i ^ (i >> 9));
+
+	tLib = time_sha(0, 0, data, len, hash[0]);
+	tFsbl = time_sha(1, 0, data, len, hash[1]);
+	tLibChunk = time_sha(0, 1, data, len, hash[2]);
+	tFsblChunk = time_sha(1, 1, data, len, hash[3]);
+	for (i = 1; i < 4; i++) {
+		if (memcmp(hash[i], hash[0], SHA256_HASH_SIZE) != 0) {
+			printf("Error sha256 disagrees with %s.\n", LIBRARY);
+			return 1;
+		}
+	}
+
+	printf("[sha256 method MB/s ms hash]\n");
+	printf("[sha256 %s %.1f %.2f %s]\n", LIBRARY, len / tLib / 1e6, tLib * 1e3, hex(hash[0], h));
+	printf("[sha256 fsbl %.1f %.2f %s]\n", len / tFsbl / 1e6, tFsbl * 1e3, h);
+	printf("[sha256 %s-chunked %.1f %.2f %s]\n", LIBRARY, len / tLibChunk / 1e6, tLibChunk * 1e3, h);
+	printf("[sha256 fsbl-chunked %.1f %.2f %s]\n", len / tFsblChunk / 1e6, tFsblChunk * 1e3, h);
+
+	make_key(n, rr, x);
+	vLib = time_verify(0, n, rr, x);
+	vFsbl = time_verify(1, n, rr, x);
+	printf("[rsa2048 verify e=%u %s %.1f us fsbl %.1f us]\n", PUBLIC_EXP, LIBRARY, vLib * 1e6, vFsbl * 1e6);
+
+	// Two signature checks, the spk hash and the partition hash.
+	sLib = time_sha(0, 0, data, SPK_BYTES, hash[0]);
+	sFsbl = time_sha(1, 0, data, SPK_BYTES, hash[1]);
+	printf("[rsa auth %lu MB %s %.2f ms fsbl %.2f ms, %.2f ms after the load]\n", (unsigned long)mb, LIBRARY,
+			(2 * vLib + sLib + tLib) * 1e3, (2 * vFsbl + sFsbl + tFsblChunk) * 1e3, (2 * vFsbl + sFsbl) * 1e3);
+
+	free(data);
+	return 0;
+}
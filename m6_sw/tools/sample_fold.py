@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+#
+# sample_fold.py -- fold PC samples from the board into flame graph stacks
+#
+# Author: Joshua M. Meise
+# Created: 10-19-2026
+# Version: 1.0
+#
+# Description: Reads the sample stream Xil_SampleDrain sends over the
+# stdout UART (from a capture file, or a serial port with pyserial),
+# symbolizes every address against the ELF with nm and prints one folded
+# stack per line, "outer;...;inner count", ready for flamegraph.pl.
+# Text the application prints between samples is skipped.
+#
+# usage: sample_fold.py m6_sw.elf capture.bin > m6.folded
+#        sample_fold.py m6_sw.elf /dev/ttyUSB1 --baud 115200 --seconds 30
+#
+import argparse
+import bisect
+import collections
+import struct
+import subprocess
+import sys
+import time
+
+MAGIC = b"\xa5\x5a"
+MAX_DEPTH = 8
+
+
+def load_symbols(elf, nm):
+    """Sorted (address, name) pairs for the function symbols in <elf>."""
+    out = subprocess.run([nm, "-n", "-C", "--defined-only", elf],
+                         check=True, capture_output=True, text=True).stdout
+    addrs, names = [], []
+    for line in out.splitlines():
+        parts = line.split(None, 2)
+        if len(parts) == 3 and parts[1] in "tTwW":
+            addrs.append(int(parts[0], 16))
+            names.append(parts[2])
+    return addrs, names
+
+
+def symbolize(addrs, names, pc):
+    i = bisect.bisect_right(addrs, pc) - 1
+    return names[i] if i >= 0 else "0x%08x" % pc
+
+
+def parse(data):
+    """Yield (pc, lr, frames) for every well-formed sample frame in <data>."""
+    pos = 0
+    while True:
+        pos = data.find(MAGIC, pos)
+        if pos < 0 or pos + 12 > len(data):
+            return
+        depth, reserved = data[pos + 2], data[pos + 3]
+        end = pos + 12 + 4 * depth
+        if depth > MAX_DEPTH or reserved != 0 or end > len(data):
+            pos += 1
+            continue
+        words = struct.unpack_from("<%dI" % (2 + depth), data, pos + 4)
+        yield words[0], words[1], words[2:]
+        pos = end
+
+
+def read_input(path, baud, seconds):
+    if not path.startswith("/dev/"):
+        with open(path, "rb") as f:
+            return f.read()
+    import serial
+    data = bytearray()
+    with serial.Serial(path, baud, timeout=0.5) as port:
+        stop = time.time() + seconds
+        while time.time() < stop:
+            data += port.read(4096)
+    return bytes(data)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Fold board PC samples into flame graph stacks.")
+    ap.add_argument("elf")
+    ap.add_argument("input", help="capture file or serial device")
+    ap.add_argument("--nm", default="arm-none-eabi-nm")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--seconds", type=float, default=10.0)
+    ap.add_argument("--use-lr", action="store_true",
+                    help="treat lr as the caller when it differs from the first frame "
+                         "(right for leaf functions without a frame)")
+    args = ap.parse_args()
+
+    addrs, names = load_symbols(args.elf, args.nm)
+    stacks = collections.Counter()
+    samples = 0
+    for pc, lr, frames in parse(read_input(args.input, args.baud, args.seconds)):
+        funcs = [symbolize(addrs, names, pc)]
+        callers = [symbolize(addrs, names, a) for a in frames]
+        if args.use_lr and addrs and lr >= addrs[0]:
+            caller = symbolize(addrs, names, lr)
+            if caller != funcs[0] and (not callers or callers[0] != caller):
+                callers.insert(0, caller)
+        stacks[";".join(reversed(funcs + callers))] += 1
+        samples += 1
+
+    for stack, count in sorted(stacks.items()):
+        print("%s %d" % (stack, count))
+    print("%d samples, %d stacks" % (samples, len(stacks)), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
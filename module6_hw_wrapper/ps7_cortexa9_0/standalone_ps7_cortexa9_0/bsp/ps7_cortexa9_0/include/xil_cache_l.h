@@ -21,6 +21,7 @@
 * ----- ---- -------- -----------------------------------------------
 * 1.00a ecm  01/24/10 First release
 * 6.8   aru  09/06/18 Removed compilation warnings for ARMCC toolchain.
+* 7.6   jmm  10/19/26 Added the L2 lockdown by way APIs.
 * </pre>
 *
 ******************************************************************************/
@@ -28,6 +29,7 @@
 #define XIL_CACHE_MACH_H
 
 #include "xil_types.h"
+#include "xil_cache.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -64,6 +66,9 @@ void Xil_L2CacheFlush(void);
 void Xil_L2CacheFlushLine(u32 adr);
 void Xil_L2CacheFlushRange(u32 adr, u32 len);
 void Xil_L2CacheStoreLine(u32 adr);
+s32 Xil_L2CacheLock(const Xil_CacheRange *Regions, u32 NumRegions, u32 NumWays);
+void Xil_L2CacheUnlock(void);
+u32 Xil_L2CacheGetLockedWays(void);
 
 #ifdef __cplusplus
 }
@@ -55,7 +55,8 @@
 *			XDCFG_INT_STS_OFFSET) &
 *			XDCFG_IXR_D_P_DONE_MASK) !=
 *			XDCFG_IXR_D_P_DONE_MASK);
-*
+* 3.8   jmm 10/19/26 XDcfg_CfgInitialize clears the asynchronous transfer
+*		     state and the interrupt handlers.
 *
 * </pre>
 *
@@ -133,6 +134,20 @@ int XDcfg_CfgInitialize(XDcfg *InstancePtr,
 	InstancePtr->Config.BaseAddr = EffectiveAddress;
 	InstancePtr->IsStarted = 0;
 
+	/*
+	 * No asynchronous transfer is running; one fails on any error flag
+	 * until XDcfg_SetAsyncErrorMask says otherwise.
+	 */
+	InstancePtr->StatusHandler = NULL;
+	InstancePtr->CallBackRef = NULL;
+	InstancePtr->DoneHandler = NULL;
+	InstancePtr->DoneRef = NULL;
+	InstancePtr->AsyncErrorMask = XDCFG_IXR_ERROR_FLAGS_MASK;
+	InstancePtr->AsyncDoneMask = 0;
+	InstancePtr->AsyncEvents = 0;
+	InstancePtr->AsyncPending = 0;
+	InstancePtr->AsyncStatus = XST_SUCCESS;
+
 
 	/* Unlock the Device Configuration Interface */
 	XDcfg_Unlock(InstancePtr);
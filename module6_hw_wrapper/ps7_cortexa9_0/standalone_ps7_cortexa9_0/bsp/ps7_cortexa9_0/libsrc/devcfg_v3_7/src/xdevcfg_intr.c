@@ -22,6 +22,13 @@
 * 2.01a nm  07/07/12 Updated the XDcfg_IntrClear function to directly
 *		     set the mask instead of oring it with the
 *		     value read from the interrupt status register
+* 3.8   jmm 10/19/26 Added the asynchronous transfer API: XDcfg_TransferAsync
+*		     starts a transfer and returns, and the completion handler
+*		     set with XDcfg_SetDoneHandler is called from
+*		     XDcfg_InterruptHandler, or from XDcfg_TransferPoll,
+*		     XDcfg_TransferWait or XDcfg_TransferCancel when the
+*		     interrupt is not connected. XDcfg_InterruptHandler no
+*		     longer requires a status handler.
 * </pre>
 *
 ******************************************************************************/
@@ -38,6 +45,10 @@
 
 /************************** Function Prototypes ******************************/
 
+static void XDcfg_TransferCheck(XDcfg *InstancePtr);
+static void XDcfg_TransferService(XDcfg *InstancePtr, u32 IntrStatus);
+static void XDcfg_TransferComplete(XDcfg *InstancePtr, u32 Status);
+
 /************************** Variable Definitions *****************************/
 
 /****************************************************************************/
@@ -242,11 +253,20 @@ void XDcfg_InterruptHandler(XDcfg *InstancePtr)
 	XDcfg_WriteReg(InstancePtr->Config.BaseAddr,
 				XDCFG_INT_STS_OFFSET, IntrStatusReg);
 
+	/*
+	 * Finish an asynchronous transfer whose events have arrived.
+	 */
+	if (InstancePtr->AsyncPending) {
+		XDcfg_TransferService(InstancePtr, IntrStatusReg);
+	}
+
 	/*
 	 * Signal application that there are events to handle.
 	 */
-	InstancePtr->StatusHandler(InstancePtr->CallBackRef,
-					   IntrStatusReg);
+	if (InstancePtr->StatusHandler != NULL) {
+		InstancePtr->StatusHandler(InstancePtr->CallBackRef,
+						   IntrStatusReg);
+	}
 
 }
 
@@ -281,4 +301,335 @@ void XDcfg_SetHandler(XDcfg *InstancePtr, void *CallBackFunc,
 	InstancePtr->StatusHandler = (XDcfg_IntrHandler) CallBackFunc;
 	InstancePtr->CallBackRef = CallBackRef;
 }
+
+/****************************************************************************/
+/**
+*
+* This function sets the handler that is called when an asynchronous
+* transfer completes, fails or is cancelled.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance
+* @param	CallBackFunc is the address of an XDcfg_DoneHandler.
+* @param	CallBackRef is a user data item that will be passed to the
+*		callback function when it is invoked.
+*
+* @return	None.
+*
+* @note		The handler may start the next transfer; the previous one is
+*		no longer pending when it is called.
+*
+*****************************************************************************/
+void XDcfg_SetDoneHandler(XDcfg *InstancePtr, void *CallBackFunc,
+				void *CallBackRef)
+{
+	/*
+	 * Asserts validate the input arguments
+	 * CallBackRef not checked, no way to know what is valid
+	 */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(CallBackFunc != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	InstancePtr->DoneHandler = (XDcfg_DoneHandler) CallBackFunc;
+	InstancePtr->DoneRef = CallBackRef;
+}
+
+/****************************************************************************/
+/**
+*
+* This function starts a PCAP transfer and returns while the DMA runs. The
+* transfer completes when every event in DoneMask has been seen, and fails
+* as soon as one of the error events selected by XDcfg_SetAsyncErrorMask is
+* seen. Either way the completion handler is called once.
+*
+* If the devcfg interrupt is connected to XDcfg_InterruptHandler the
+* handler is called from the interrupt. Otherwise XDcfg_TransferPoll or
+* XDcfg_TransferWait has to be called to notice the events.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+* @param	SourcePtr is a pointer to the source buffer.
+* @param	SrcWordLength is the number of words to transfer from source.
+* @param	DestPtr is a pointer to the destination buffer.
+* @param	DestWordLength is the number of words to transfer to
+*		destination.
+* @param	TransferType is the type of transfer as for XDcfg_Transfer;
+*		XDCFG_PCAP_READBACK is not supported.
+* @param	DoneMask is XDCFG_ASYNC_DMA_DONE, XDCFG_ASYNC_D_P_DONE or, for a
+*		full bitstream, XDCFG_ASYNC_PCFG_DONE.
+*
+* @return
+*		- XST_SUCCESS if the transfer was started.
+*		- XST_DEVICE_BUSY if an asynchronous transfer or the DMA is
+*		  still running.
+*		- XST_INVALID_PARAM or XST_FAILURE as from XDcfg_Transfer.
+*
+* @note		The completion and error events are unmasked for the length
+*		of the transfer and masked again when it completes. The 2 LSBs
+*		of the addresses mark the last DMA command as for
+*		XDcfg_Transfer.
+*
+*****************************************************************************/
+u32 XDcfg_TransferAsync(XDcfg *InstancePtr,
+			void *SourcePtr, u32 SrcWordLength,
+			void *DestPtr, u32 DestWordLength,
+			u32 TransferType, u32 DoneMask)
+{
+	u32 Status;
+	u32 Mask;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(DoneMask != 0U);
+
+	/*
+	 * A readback polls between its two DMA commands inside the driver.
+	 */
+	if (TransferType == XDCFG_PCAP_READBACK) {
+		return XST_INVALID_PARAM;
+	}
+
+	if (InstancePtr->AsyncPending) {
+		return XST_DEVICE_BUSY;
+	}
+
+	/*
+	 * Clear events left from an earlier transfer so that only this one
+	 * can complete or fail it.
+	 */
+	Mask = DoneMask | InstancePtr->AsyncErrorMask;
+	XDcfg_WriteReg(InstancePtr->Config.BaseAddr,
+				XDCFG_INT_STS_OFFSET, Mask);
+
+	InstancePtr->AsyncDoneMask = DoneMask;
+	InstancePtr->AsyncEvents = 0;
+	InstancePtr->AsyncStatus = XST_DEVICE_BUSY;
+	InstancePtr->AsyncPending = 1;
+
+	/*
+	 * Unmask the events before the DMA is started so none is missed.
+	 */
+	XDcfg_IntrEnable(InstancePtr, Mask);
+
+	Status = XDcfg_Transfer(InstancePtr, SourcePtr, SrcWordLength,
+				DestPtr, DestWordLength, TransferType);
+	if (Status != XST_SUCCESS) {
+		XDcfg_IntrDisable(InstancePtr, Mask);
+		InstancePtr->AsyncPending = 0;
+		InstancePtr->AsyncStatus = Status;
+	}
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* This function checks the interrupt status for the events of an
+* asynchronous transfer and completes it if they have arrived. It is the
+* polled equivalent of the interrupt and may be used with or without the
+* interrupt connected.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+*
+* @return
+*		- XST_DEVICE_BUSY while the transfer runs.
+*		- The status passed to the completion handler once it has
+*		  completed.
+*
+* @note		Must be called on the cpu that takes the devcfg interrupt;
+*		the events are masked while the status is read.
+*
+*****************************************************************************/
+u32 XDcfg_TransferPoll(XDcfg *InstancePtr)
+{
+	u32 Mask;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (!InstancePtr->AsyncPending) {
+		return InstancePtr->AsyncStatus;
+	}
+
+	Mask = InstancePtr->AsyncDoneMask | InstancePtr->AsyncErrorMask;
+	XDcfg_IntrDisable(InstancePtr, Mask);
+
+	XDcfg_TransferCheck(InstancePtr);
+
+	/*
+	 * The handler may have started another transfer.
+	 */
+	if (InstancePtr->AsyncPending) {
+		XDcfg_IntrEnable(InstancePtr, InstancePtr->AsyncDoneMask |
+					InstancePtr->AsyncErrorMask);
+	}
+
+	return InstancePtr->AsyncStatus;
+}
+
+/****************************************************************************/
+/**
+*
+* This function waits for an asynchronous transfer to complete, reading the
+* interrupt status at most MaxCount times as the polled transfers do. A
+* transfer still running after that is cancelled with XST_TIMEOUT.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+* @param	MaxCount is the number of times the status is read.
+*
+* @return
+*		- XST_SUCCESS if the transfer completed.
+*		- XST_FAILURE if an error event was seen.
+*		- XST_TIMEOUT if it did not complete in time.
+*		- The status XDcfg_TransferAsync returned if it was not
+*		  started.
+*
+* @note		A timeout does not stop the DMA; the PCAP has to be cleared
+*		before the next transfer, as after a polled timeout.
+*
+*****************************************************************************/
+u32 XDcfg_TransferWait(XDcfg *InstancePtr, u32 MaxCount)
+{
+	u32 Count;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	for (Count = 0; Count < MaxCount; Count++) {
+		(void)XDcfg_TransferPoll(InstancePtr);
+		if (!InstancePtr->AsyncPending) {
+			return InstancePtr->AsyncStatus;
+		}
+	}
+
+	return XDcfg_TransferCancel(InstancePtr);
+}
+
+/****************************************************************************/
+/**
+*
+* This function gives up on an asynchronous transfer: its events are masked
+* and the completion handler is called with XST_TIMEOUT, unless the events
+* have arrived in the meantime.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+*
+* @return	The status passed to the completion handler, or the status of
+*		the last transfer if none was pending.
+*
+* @note		A cancelled transfer is not stopped; the PCAP has to be
+*		cleared before the next transfer.
+*
+*****************************************************************************/
+u32 XDcfg_TransferCancel(XDcfg *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (!InstancePtr->AsyncPending) {
+		return InstancePtr->AsyncStatus;
+	}
+
+	XDcfg_IntrDisable(InstancePtr, InstancePtr->AsyncDoneMask |
+				InstancePtr->AsyncErrorMask);
+
+	/*
+	 * A transfer that finished just now is not reported as timed out.
+	 */
+	XDcfg_TransferCheck(InstancePtr);
+
+	if (InstancePtr->AsyncPending) {
+		XDcfg_TransferComplete(InstancePtr, XST_TIMEOUT);
+	}
+
+	return InstancePtr->AsyncStatus;
+}
+
+/****************************************************************************/
+/**
+*
+* This function reads and clears the events of the pending asynchronous
+* transfer with its interrupts masked.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XDcfg_TransferCheck(XDcfg *InstancePtr)
+{
+	u32 IntrStatusReg;
+
+	if (!InstancePtr->AsyncPending) {
+		return;
+	}
+
+	IntrStatusReg = XDcfg_ReadReg(InstancePtr->Config.BaseAddr,
+					XDCFG_INT_STS_OFFSET) &
+			(InstancePtr->AsyncDoneMask |
+			 InstancePtr->AsyncErrorMask);
+	if (IntrStatusReg != 0U) {
+		XDcfg_WriteReg(InstancePtr->Config.BaseAddr,
+				XDCFG_INT_STS_OFFSET, IntrStatusReg);
+		XDcfg_TransferService(InstancePtr, IntrStatusReg);
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function adds interrupt events to those of the pending asynchronous
+* transfer and completes it on an error or once every completion event has
+* been seen. Completion events may arrive in separate interrupts.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+* @param	IntrStatus is the interrupt status that was cleared.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XDcfg_TransferService(XDcfg *InstancePtr, u32 IntrStatus)
+{
+	InstancePtr->AsyncEvents |= IntrStatus &
+			(InstancePtr->AsyncDoneMask | InstancePtr->AsyncErrorMask);
+
+	if ((InstancePtr->AsyncEvents & InstancePtr->AsyncErrorMask) != 0U) {
+		XDcfg_TransferComplete(InstancePtr, XST_FAILURE);
+	} else if ((InstancePtr->AsyncEvents & InstancePtr->AsyncDoneMask) ==
+			InstancePtr->AsyncDoneMask) {
+		XDcfg_TransferComplete(InstancePtr, XST_SUCCESS);
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function ends the pending asynchronous transfer and calls the
+* completion handler.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+* @param	Status is passed to the completion handler.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XDcfg_TransferComplete(XDcfg *InstancePtr, u32 Status)
+{
+	XDcfg_IntrDisable(InstancePtr, InstancePtr->AsyncDoneMask |
+				InstancePtr->AsyncErrorMask);
+
+	InstancePtr->AsyncStatus = Status;
+	InstancePtr->AsyncPending = 0;
+
+	if (InstancePtr->DoneHandler != NULL) {
+		InstancePtr->DoneHandler(InstancePtr->DoneRef, Status,
+					 InstancePtr->AsyncEvents);
+	}
+}
 /** @} */
@@ -32,6 +32,7 @@
 *                         Xil_GetExceptionRegisterHandler to ignore
 *                         Exception_id, only if its pointing to IRQ.
 *                         It fixes CR#1069524
+* 7.6  jmm       10/19/26 Added Xil_ExceptionSelectIrqEntry for Cortex-A9.
 *
 * </pre>
 *
@@ -219,6 +220,40 @@ void Xil_ExceptionRemoveHandler(u32 Exception_id)
 				       NULL);
 }
 
+#if !defined (__aarch64__) && !defined (ARMR5)
+extern u32 _vector_irq_entry;
+extern u32 _fast_vector_irq_entry __attribute__((weak));
+extern void IRQHandler(void);
+extern void IRQHandlerGeneric(void);
+
+/*****************************************************************************/
+/**
+*
+* @brief	Selects the assembly entry used for IRQs. The streamlined entry
+*			stacks only the caller-saved registers, calls the handler
+*			registered for XIL_EXCEPTION_ID_IRQ_INT directly and
+*			tail-chains while the GIC has more interrupts pending. The
+*			generic entry goes through IRQInterrupt and is kept for
+*			comparison. Both vector tables are updated.
+*
+* @param	Streamlined selects the streamlined entry if non-zero.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_ExceptionSelectIrqEntry(u32 Streamlined)
+{
+	u32 Entry = Streamlined ? (u32)(UINTPTR)IRQHandler :
+					(u32)(UINTPTR)IRQHandlerGeneric;
+
+	_vector_irq_entry = Entry;
+	if (&_fast_vector_irq_entry != NULL) {
+		_fast_vector_irq_entry = Entry;
+	}
+	dsb();
+}
+#endif
+
 #if defined (__aarch64__)
 /*****************************************************************************/
 /**
@@ -17,6 +17,11 @@
 * Ver   Who      Date     Changes
 * ----- -------- -------- -----------------------------------------------
 * 6.1   nsk      11/07/16 First release.
+* 7.6   jmm      10/19/26 Added the XIL_MEM_NEON build variant, which routes
+*                         Xil_MemCpy and the newlib memcpy, memmove and memset
+*                         through the NEON kernels in xil_mem_neon.S, falling
+*                         back to newlib for short copies and when NEON is
+*                         unavailable.
 *
 * </pre>
 *
@@ -24,9 +29,61 @@
 
 /***************************** Include Files ********************************/
 
+#include <stddef.h>
 #include "xil_types.h"
+#include "xil_mem.h"
+#include "bspconfig.h"
+
+/************************** Constant Definitions ****************************/
+
+/* Below this size newlib is as fast as setting up the NEON copy */
+#define XIL_MEM_NEON_MIN	64U
+
+/************************** Variable Definitions ****************************/
+
+#ifdef XIL_MEM_NEON
+static s32 NeonState = -1;	/* -1 not probed, 0 newlib, 1 NEON */
+#endif
+
+/************************** Function Prototypes *****************************/
+
+#ifdef XIL_MEM_NEON
+extern u32 Xil_MemNeonProbe(void);
+extern void *Xil_MemCpyNeon(void *dst, const void *src, u32 cnt);
+extern void *Xil_MemMoveNeon(void *dst, const void *src, u32 cnt);
+extern void *Xil_MemSetNeon(void *dst, s32 c, u32 cnt);
+extern void *__real_memcpy(void *dst, const void *src, size_t cnt);
+extern void *__real_memmove(void *dst, const void *src, size_t cnt);
+extern void *__real_memset(void *dst, int c, size_t cnt);
+#endif
 
 /***************** Inline Functions Definitions ********************/
+
+#ifdef XIL_MEM_NEON
+/*****************************************************************************/
+/**
+* @brief       Check once whether the NEON kernels can run. The FPU registers
+*              are only preserved across interrupts in the hard-float build,
+*              so newlib is kept otherwise. The answer depends only on the
+*              build, CPACR and the core, so it is the same whether the first
+*              call comes from thread or interrupt context.
+*
+* @return      1 if the NEON kernels may be used, 0 otherwise.
+*
+*****************************************************************************/
+static inline s32 Xil_MemNeonReady(void)
+{
+	if (NeonState < 0) {
+#if FPU_HARD_FLOAT_ABI_ENABLED
+		NeonState = (s32)Xil_MemNeonProbe();
+#else
+		NeonState = 0;
+#endif
+	}
+	return NeonState;
+}
+#endif
+
 /*****************************************************************************/
 /**
 * @brief       This  function copies memory from once location to other.
@@ -37,9 +94,20 @@
 *
 * @param       cnt: 32 bit length of bytes to be copied
 *
+* @note        In the XIL_MEM_NEON build copies of 64 bytes or more use the
+*              NEON kernel, which needs dst and src to be Normal memory, and
+*              shorter ones use newlib.
+*
 *****************************************************************************/
 void Xil_MemCpy(void* dst, const void* src, u32 cnt)
 {
+#ifdef XIL_MEM_NEON
+	if ((cnt >= XIL_MEM_NEON_MIN) && (Xil_MemNeonReady() != 0)) {
+		(void)Xil_MemCpyNeon(dst, src, cnt);
+	} else {
+		(void)__real_memcpy(dst, src, (size_t)cnt);
+	}
+#else
 	char *d = (char*)(void *)dst;
 	const char *s = src;
 
@@ -61,4 +129,73 @@ void Xil_MemCpy(void* dst, const void* src, u32 cnt)
 		s += 1U;
 		cnt -= 1U;
 	}
+#endif
+}
+
+/*****************************************************************************/
+/**
+* @brief       Select the copy implementation at run time.
+*
+* @param       Enable: 0 forces the newlib path, nonzero uses NEON when the
+*              core supports it. Has no effect unless the BSP was built with
+*              XIL_MEM_NEON.
+*
+*****************************************************************************/
+void Xil_MemNeonEnable(u32 Enable)
+{
+#ifdef XIL_MEM_NEON
+	NeonState = (Enable != 0U) ? -1 : 0;
+#else
+	(void)Enable;
+#endif
+}
+
+/*****************************************************************************/
+/**
+* @brief       Report which copy implementation is in use.
+*
+* @return      1 if the NEON kernels are in use, 0 for the newlib path.
+*
+*****************************************************************************/
+u32 Xil_MemNeonEnabled(void)
+{
+#ifdef XIL_MEM_NEON
+	return (u32)Xil_MemNeonReady();
+#else
+	return 0U;
+#endif
+}
+
+#ifdef XIL_MEM_NEON
+/*
+ * Newlib hooks. The application is linked with
+ * -Wl,--wrap=memcpy,--wrap=memmove,--wrap=memset, which sends every call,
+ * from the application and from the rest of libc, here; the newlib
+ * routines stay reachable as __real_memcpy and so on for the short and
+ * fallback cases.
+ */
+
+void *__wrap_memcpy(void *dst, const void *src, size_t cnt)
+{
+	if ((cnt >= XIL_MEM_NEON_MIN) && (Xil_MemNeonReady() != 0)) {
+		return Xil_MemCpyNeon(dst, src, (u32)cnt);
+	}
+	return __real_memcpy(dst, src, cnt);
+}
+
+void *__wrap_memmove(void *dst, const void *src, size_t cnt)
+{
+	if ((cnt >= XIL_MEM_NEON_MIN) && (Xil_MemNeonReady() != 0)) {
+		return Xil_MemMoveNeon(dst, src, (u32)cnt);
+	}
+	return __real_memmove(dst, src, cnt);
+}
+
+void *__wrap_memset(void *dst, int c, size_t cnt)
+{
+	if ((cnt >= XIL_MEM_NEON_MIN) && (Xil_MemNeonReady() != 0)) {
+		return Xil_MemSetNeon(dst, (s32)c, (u32)cnt);
+	}
+	return __real_memset(dst, c, cnt);
 }
+#endif
@@ -22,6 +22,8 @@
 * ----- -------- -------- -----------------------------------------------
 * 6.1   nsk      11/07/16 First release.
 * 7.0   mus      01/07/19 Add cpp extern macro
+* 7.6   jmm      10/19/26 Add Xil_MemNeonEnable and Xil_MemNeonEnabled for the
+*                         XIL_MEM_NEON build variant
 *
 * </pre>
 *
@@ -29,6 +31,8 @@
 #ifndef XIL_MEM_H		/* prevent circular inclusions */
 #define XIL_MEM_H		/* by using protection macros */
 
+#include "xil_types.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -36,6 +40,8 @@ extern "C" {
 /************************** Function Prototypes *****************************/
 
 void Xil_MemCpy(void* dst, const void* src, u32 cnt);
+void Xil_MemNeonEnable(u32 Enable);
+u32 Xil_MemNeonEnabled(void);
 
 #ifdef __cplusplus
 }
@@ -18,4 +18,7 @@ void _profile_clean( void )
 {
 	Xil_ExceptionDisable();
 	disable_timer();
+#ifndef PROFILE_NO_GRAPH
+	profile_cg_flush();
+#endif
 }
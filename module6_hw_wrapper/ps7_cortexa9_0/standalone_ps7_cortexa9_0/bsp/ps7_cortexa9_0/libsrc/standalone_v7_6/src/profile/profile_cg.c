@@ -28,6 +28,85 @@ s32 searchpc(const struct fromstruct *froms, s32 fromssize, u32 frompc );
 
 /*extern struct gmonparam *_gmonparam, */
 
+/*
+ * Arcs are counted here by mcount and only copied into the gmonparam lists
+ * by profile_cg_flush. Slots are claimed and counts and statistics bumped
+ * with load/store-exclusive, so mcount never masks the profiling timer and
+ * may be entered from an instrumented interrupt handler while another call
+ * is half way through an update.
+ */
+static struct cgslot cgtable_hash[PROFILE_CG_SLOTS];
+static struct cgstats cgstats;
+static s32 cg_last_section;
+static volatile u32 cg_flushing;	/* a flush is updating the lists */
+
+#define CG_HASH_SHIFT	(32U - (u32)__builtin_ctz(PROFILE_CG_SLOTS))
+
+#if defined(__arm__)
+static inline u32 cg_ldrex(volatile u32 *addr)
+{
+	u32 val;
+
+	__asm__ __volatile__("ldrex %0, [%1]" : "=&r"(val) : "r"(addr) : "memory");
+	return val;
+}
+
+static inline u32 cg_strex(volatile u32 *addr, u32 val)
+{
+	u32 fail;
+
+	__asm__ __volatile__("strex %0, %2, [%1]" : "=&r"(fail) : "r"(addr), "r"(val) : "memory");
+	return fail;
+}
+
+static inline void cg_clrex(void)
+{
+	__asm__ __volatile__("clrex" ::: "memory");
+}
+#else
+/* no exclusive monitor: fall back to plain accesses */
+static inline u32 cg_ldrex(volatile u32 *addr) { return *addr; }
+static inline u32 cg_strex(volatile u32 *addr, u32 val) { *addr = val; return 0U; }
+static inline void cg_clrex(void) { }
+#endif
+
+static inline void cg_add(volatile u32 *ctr, u32 n)
+{
+	while (cg_strex(ctr, cg_ldrex(ctr) + n) != 0U) {
+	}
+}
+
+static inline void cg_max(volatile u32 *ctr, u32 n)
+{
+	do {
+		if (cg_ldrex(ctr) >= n) {
+			cg_clrex();
+			return;
+		}
+	} while (cg_strex(ctr, n) != 0U);
+}
+
+/*
+ * Section containing pc; the last hit is tried first since there is
+ * normally a single text section.
+ */
+static inline struct gmonparam *cg_section(u32 pc)
+{
+	struct gmonparam *p = &_gmonparam[cg_last_section];
+	s32 j;
+
+	if ((pc >= p->lowpc) && (pc < p->highpc)) {
+		return p;
+	}
+	for (j = 0; j < n_gmon_sections; j++) {
+		if ((pc >= _gmonparam[j].lowpc) && (pc < _gmonparam[j].highpc)) {
+			cg_last_section = j;
+			return &_gmonparam[j];
+		}
+	}
+	return NULL;
+}
+
 #ifdef PROFILE_NO_FUNCPTR
 s32 searchpc(const struct fromto_struct *cgtable, s32 cgtable_size, u32 frompc )
 {
@@ -61,84 +140,189 @@ s32 searchpc(const struct fromstruct *froms, s32 fromssize, u32 frompc )
 #endif		/* PROFILE_NO_FUNCPTR */
 
 
+/*
+ * Count one call of selfpc from frompc.
+ *
+ * A slot is claimed by store-exclusive on its frompc word and selfpc is
+ * written afterwards, so a call that interrupts a claim in progress sees
+ * a selfpc that does not match yet and takes the next slot instead of
+ * waiting. The duplicate arc is merged by profile_cg_flush.
+ */
 void mcount( u32 frompc, u32 selfpc )
 {
-	register struct gmonparam *p = NULL;
-	register s32 toindex, fromindex;
-	s32 j;
-
-	disable_timer();
+	volatile struct cgslot *slot;
+	u32 h, n, from;
 
-	/*print("CG: "), putnum(frompc), print("->"), putnum(selfpc), print("\r\n") ,
+	/*
 	 * check that frompcindex is a reasonable pc value.
 	 * for example:	signal catchers get called from the stack,
 	 *		not from text space.  too bad.
-	*/
-	for(j = 0; j < n_gmon_sections; j++ ){
-		if((frompc >= _gmonparam[j].lowpc) && (frompc < _gmonparam[j].highpc)) {
-			p = &_gmonparam[j];
-			break;
+	 */
+	if (cg_section(frompc) == NULL) {
+		cg_add(&cgstats.outside, 1U);
+		return;
+	}
+
+	h = ((frompc ^ (selfpc << 7)) * 0x9E3779B1U) >> CG_HASH_SHIFT;
+	for (n = 0U; n < PROFILE_CG_PROBES; n++) {
+		slot = &cgtable_hash[(h + n) & (PROFILE_CG_SLOTS - 1U)];
+		from = slot->frompc;
+		if (from == 0U) {
+			from = cg_ldrex(&slot->frompc);
+			if (from == 0U) {
+				if (cg_strex(&slot->frompc, frompc) != 0U) {
+					/* lost the slot to an interrupting call; look again */
+					n--;
+					continue;
+				}
+				slot->selfpc = selfpc;
+				cg_add(&slot->count, 1U);
+				cg_add(&cgstats.arcs, 1U);
+				cg_max(&cgstats.maxprobe, n);
+				return;
+			}
+			cg_clrex();
+		}
+		if ((from == frompc) && (slot->selfpc == selfpc)) {
+			cg_add(&slot->count, 1U);
+			return;
 		}
 	}
-	if( j == n_gmon_sections ) {
-		goto done;
+
+	cg_add(&cgstats.overflows, 1U);
+}
+
+
+/*
+ * Move the count of one slot into the froms/tos lists of its section.
+ * The count is taken out of the table, so a slot may be flushed again
+ * without counting an arc twice.
+ */
+static void cg_flush_slot( volatile struct cgslot *slot )
+{
+	register struct gmonparam *p;
+	register s32 toindex, fromindex;
+	u32 count;
+
+	if ((slot->frompc == 0U) || (slot->count == 0U)) {
+		return;
 	}
+	p = cg_section(slot->frompc);
+	if (p == NULL) {
+		return;
+	}
+	do {
+		count = cg_ldrex(&slot->count);
+	} while (cg_strex(&slot->count, 0U) != 0U);
 
 #ifdef PROFILE_NO_FUNCPTR
-	fromindex = searchpc( p->cgtable, p->cgtable_size, frompc ) ;
+	fromindex = searchpc( p->cgtable, p->cgtable_size, slot->frompc ) ;
 	if( fromindex == -1 ) {
 		fromindex = p->cgtable_size ;
 		p->cgtable_size++ ;
-		p->cgtable[fromindex].frompc = frompc ;
-		p->cgtable[fromindex].selfpc = selfpc ;
-		p->cgtable[fromindex].count = 1 ;
-		goto done ;
+		p->cgtable[fromindex].frompc = slot->frompc ;
+		p->cgtable[fromindex].selfpc = slot->selfpc ;
+		p->cgtable[fromindex].count = count ;
+	} else {
+		p->cgtable[fromindex].count += count ;
 	}
-	p->cgtable[fromindex].count++ ;
 #else
-	fromindex = (s32)searchpc( p->froms, ((s32)p->fromssize), frompc ) ;
+	fromindex = (s32)searchpc( p->froms, ((s32)p->fromssize), slot->frompc ) ;
 	if( fromindex == -1 ) {
+		if( p->fromssize >= 0x7FFFU ) {
+			cgstats.tosfull++;
+			return;
+		}
 		fromindex = (s32)p->fromssize ;
 		p->fromssize++ ;
-		/*if( fromindex >= N_FROMS ) {
-		* print("Error : From PC table overflow\r\n")
-		* goto overflow
-		*}*/
-		p->froms[fromindex].frompc = frompc ;
+		p->froms[fromindex].frompc = slot->frompc ;
 		p->froms[fromindex].link = -1 ;
 	}else {
 		toindex = ((s32)(p->froms[fromindex].link));
 		while(toindex != -1) {
 			toindex = (((s32)p->tossize) - toindex)-1 ;
-			if( p->tos[toindex].selfpc == selfpc ) {
-				p->tos[toindex].count++ ;
-				goto done ;
+			if( p->tos[toindex].selfpc == slot->selfpc ) {
+				p->tos[toindex].count += (s32)count ;
+				break ;
 			}
 			toindex = ((s32)(p->tos[toindex].link)) ;
 		}
+		if( toindex != -1 ) {
+			return;
+		}
 	}
 
-	/*if( toindex == -1 ) { */
+	if( p->tossize >= 0x7FFFU ) {
+		cgstats.tosfull++;
+		return;
+	}
 	p->tos-- ;
 	p->tossize++ ;
-	/* if( toindex >= N_TOS ) {
-	* print("Error : To PC table overflow\r\n")
-	* goto overflow
-	*} */
-	p->tos[0].selfpc = selfpc ;
-	p->tos[0].count = 1 ;
+	p->tos[0].selfpc = slot->selfpc ;
+	p->tos[0].count = (s32)count ;
 	p->tos[0].link = p->froms[fromindex].link ;
-	p->froms[fromindex].link = ((s32)(p->tossize))-((s32)1);
+	p->froms[fromindex].link = (s16)(((s32)(p->tossize))-((s32)1));
 #endif
-
- done:
 	p->state = GMON_PROF_ON;
-	goto enable_timer_label ;
- /* overflow: */
-	/*p->state = GMON_PROF_ERROR */
- enable_timer_label:
-	enable_timer();
-	return ;
+}
+
+/*
+ * Claim the froms/tos lists; a flush that finds another one part way
+ * through them returns and leaves the counts for the next.
+ */
+static inline u32 cg_flush_claim( void )
+{
+	do {
+		if (cg_ldrex(&cg_flushing) != 0U) {
+			cg_clrex();
+			return 0U;
+		}
+	} while (cg_strex(&cg_flushing, 1U) != 0U);
+	return 1U;
+}
+
+/*
+ * Move every count collected by mcount into the froms/tos lists. Runs at
+ * exit from _profile_clean and may be called from the foreground at any
+ * time.
+ */
+void profile_cg_flush( void )
+{
+	u32 i;
+
+	if (cg_flush_claim() == 0U) {
+		return;
+	}
+	for (i = 0U; i < PROFILE_CG_SLOTS; i++) {
+		cg_flush_slot(&cgtable_hash[i]);
+	}
+	cg_flushing = 0U;
+}
+
+/*
+ * Flush the next PROFILE_CG_FLUSH_SLOTS slots. The profiling timer calls
+ * this on every tick, so the lists follow the table a whole pass every
+ * PROFILE_CG_SLOTS / PROFILE_CG_FLUSH_SLOTS ticks while the work in the
+ * interrupt stays bounded.
+ */
+void profile_cg_flush_step( void )
+{
+	static u32 cursor;
+	u32 n;
+
+	if (cg_flush_claim() == 0U) {
+		return;
+	}
+	for (n = 0U; n < PROFILE_CG_FLUSH_SLOTS; n++) {
+		cg_flush_slot(&cgtable_hash[cursor]);
+		cursor = (cursor + 1U) & (PROFILE_CG_SLOTS - 1U);
+	}
+	cg_flushing = 0U;
+}
+
+void profile_cg_stats( struct cgstats *stats )
+{
+	*stats = cgstats;
 }
 
 
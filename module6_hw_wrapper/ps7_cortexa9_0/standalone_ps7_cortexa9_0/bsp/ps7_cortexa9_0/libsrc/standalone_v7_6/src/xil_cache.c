@@ -74,6 +74,14 @@
 *					  caches are enabled. This fixes CR-992023.
 * 7.5    mus 01/19/21 Implement workaround for errata#588369 in Xil_DCacheFlushRange.
 *					  It fixes CR#1086022.
+* 7.6    jmm 10/19/26 Added L2 lockdown by way: Xil_L2CacheLock preloads
+*					  address ranges into reserved ways and locks them,
+*					  Xil_L2CacheUnlock releases them. Complete L2 flush and
+*					  invalidate leave the contents of locked ways in place.
+* 7.6    jmm 10/19/26 Added Xil_DCacheFlushRanges and Xil_DCacheInvalidateRanges,
+*					  which sort and coalesce a list of ranges and issue a single
+*					  L2 sync. Flushes larger than a settable threshold clean the
+*					  whole cache by set/way instead.
 *
 * </pre>
 *
@@ -90,6 +98,7 @@
 #include "xl2cc.h"
 #include "xil_errata.h"
 #include "xil_exception.h"
+#include "xstatus.h"
 
 /************************** Function Prototypes ******************************/
 
@@ -97,6 +106,16 @@
 
 #define IRQ_FIQ_MASK 0xC0U	/* Mask IRQ and FIQ interrupts in cpsr */
 
+#ifndef USE_AMP
+#define L2_NUM_WAYS	8U		/* PL310 associativity on zynq */
+#define L2_WAY_MASK	0xFFU
+#define L2_MAX_LOCKED_WAYS	4U	/* leave half the cache for general use */
+
+static u32 L2LockedWays;	/* ways reserved by Xil_L2CacheLock */
+#endif
+
+static u32 DCacheFlushThreshold = XIL_DCACHE_FLUSH_THRESHOLD_DEFAULT;
+
 #ifdef __GNUC__
 	extern s32  _stack_end;
 	extern s32  __undef_stack;
@@ -473,6 +492,265 @@ void Xil_DCacheFlushRange(INTPTR adr, u32 len)
 	dsb();
 	mtcpsr(currmask);
 }
+/****************************************************************************/
+/**
+*
+* Sort a list of ranges by address and merge the ones that overlap or touch
+* once widened to whole cache lines. Empty ranges are dropped.
+*
+* @param	Ranges: list of ranges, rewritten in place.
+* @param	NumRanges: number of entries in Ranges.
+* @param	Total: returns the number of bytes covered by the result.
+*
+* @return	Number of entries left in Ranges.
+*
+****************************************************************************/
+static u32 Xil_DCacheCoalesce(Xil_CacheRange *Ranges, u32 NumRanges, u32 *Total)
+{
+	const u32 cacheline = 32U;
+	Xil_CacheRange Key;
+	u32 Index;
+	u32 Pos;
+	u32 Count = 0U;
+	u32 End;
+	u32 KeyEnd;
+
+	/* Widen to cache lines and insertion sort; lists are short */
+	for (Index = 0U; Index < NumRanges; Index++) {
+		if (Ranges[Index].Len == 0U) {
+			continue;
+		}
+		End = ((u32)Ranges[Index].Addr + Ranges[Index].Len + cacheline - 1U) &
+				~(cacheline - 1U);
+		Key.Addr = (INTPTR)((u32)Ranges[Index].Addr & ~(cacheline - 1U));
+		Key.Len = End - (u32)Key.Addr;
+		Pos = Count;
+		while ((Pos > 0U) && (Ranges[Pos - 1U].Addr > Key.Addr)) {
+			Ranges[Pos] = Ranges[Pos - 1U];
+			Pos--;
+		}
+		Ranges[Pos] = Key;
+		Count++;
+	}
+
+	/* Merge neighbours */
+	*Total = 0U;
+	for (Index = 0U, Pos = 0U; Index < Count; Index++) {
+		if ((Pos > 0U) && ((u32)Ranges[Index].Addr <=
+				((u32)Ranges[Pos - 1U].Addr + Ranges[Pos - 1U].Len))) {
+			End = (u32)Ranges[Pos - 1U].Addr + Ranges[Pos - 1U].Len;
+			KeyEnd = (u32)Ranges[Index].Addr + Ranges[Index].Len;
+			if (KeyEnd > End) {
+				Ranges[Pos - 1U].Len += KeyEnd - End;
+				*Total += KeyEnd - End;
+			}
+		} else {
+			Ranges[Pos] = Ranges[Index];
+			*Total += Ranges[Pos].Len;
+			Pos++;
+		}
+	}
+
+	return Pos;
+}
+
+/****************************************************************************/
+/**
+* @brief	Flush the Data cache for a list of address ranges. The ranges
+*			are sorted and coalesced, each line is cleaned and invalidated in
+*			L1 and then in L2, and a single L2 sync is issued at the end.
+*			When the coalesced ranges cover more than the flush threshold
+*			the entire Data cache is flushed by set/way instead, which is
+*			cheaper than walking that many lines.
+*
+* @param	Ranges: list of ranges to flush. The list is sorted and merged
+*			in place.
+* @param	NumRanges: number of entries in Ranges.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_DCacheFlushRanges(Xil_CacheRange *Ranges, u32 NumRanges)
+{
+	const u32 cacheline = 32U;
+	u32 Count;
+	u32 Total;
+	u32 Index;
+	u32 LocalAddr;
+	u32 end;
+	u32 currmask;
+#ifndef USE_AMP
+	volatile u32 *L2CCOffset = (volatile u32 *)(XPS_L2CC_BASEADDR +
+				    XPS_L2CC_CACHE_INV_CLN_PA_OFFSET);
+#endif
+
+	if ((Ranges == NULL) || (NumRanges == 0U)) {
+		return;
+	}
+
+	Count = Xil_DCacheCoalesce(Ranges, NumRanges, &Total);
+	if (Total >= DCacheFlushThreshold) {
+		Xil_DCacheFlush();
+		return;
+	}
+
+	currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+
+	/* Push every line out of L1 first */
+	for (Index = 0U; Index < Count; Index++) {
+		LocalAddr = (u32)Ranges[Index].Addr;
+		end = LocalAddr + Ranges[Index].Len;
+		while (LocalAddr < end) {
+#if defined (__GNUC__) || defined (__ICCARM__)
+			asm_cp15_clean_inval_dc_line_mva_poc(LocalAddr);
+#else
+			{ volatile register u32 Reg
+				__asm(XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC);
+			  Reg = LocalAddr; }
+#endif
+			LocalAddr += cacheline;
+		}
+	}
+	dsb();
+
+#ifndef USE_AMP
+	/* Then out of L2; by-PA operations are atomic, one sync covers all */
+	Xil_L2WriteDebugCtrl(0x3U);
+	for (Index = 0U; Index < Count; Index++) {
+		LocalAddr = (u32)Ranges[Index].Addr;
+		end = LocalAddr + Ranges[Index].Len;
+		while (LocalAddr < end) {
+			*L2CCOffset = LocalAddr;
+			LocalAddr += cacheline;
+		}
+	}
+	Xil_L2CacheSync();
+	Xil_L2WriteDebugCtrl(0x0U);
+#endif
+
+	dsb();
+	mtcpsr(currmask);
+}
+
+/****************************************************************************/
+/**
+* @brief	Invalidate the Data cache for a list of address ranges. The
+*			ranges are sorted and coalesced, partial lines at either end of
+*			each range are flushed as Xil_DCacheInvalidateRange does, and a
+*			single L2 sync is issued for the whole list.
+*
+* @param	Ranges: list of ranges to invalidate. The list is sorted and
+*			merged in place.
+* @param	NumRanges: number of entries in Ranges.
+*
+* @return	None.
+*
+* @note		There is no whole-cache fallback: invalidating by set/way would
+*			discard dirty lines outside the ranges.
+*
+****************************************************************************/
+void Xil_DCacheInvalidateRanges(Xil_CacheRange *Ranges, u32 NumRanges)
+{
+	const u32 cacheline = 32U;
+	u32 Count;
+	u32 Total;
+	u32 Index;
+	u32 LocalAddr;
+	u32 end;
+	u32 currmask;
+#ifndef USE_AMP
+	volatile u32 *L2CCOffset = (volatile u32 *)(XPS_L2CC_BASEADDR +
+				    XPS_L2CC_CACHE_INVLD_PA_OFFSET);
+#endif
+
+	if ((Ranges == NULL) || (NumRanges == 0U)) {
+		return;
+	}
+
+	/* Remember the unaligned edges before the ranges are widened */
+	currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+	for (Index = 0U; Index < NumRanges; Index++) {
+		if (Ranges[Index].Len == 0U) {
+			continue;
+		}
+		LocalAddr = (u32)Ranges[Index].Addr;
+		end = LocalAddr + Ranges[Index].Len;
+		if ((LocalAddr & (cacheline - 1U)) != 0U) {
+			Xil_DCacheFlushLine(LocalAddr & ~(cacheline - 1U));
+		}
+		if ((end & (cacheline - 1U)) != 0U) {
+			Xil_DCacheFlushLine(end & ~(cacheline - 1U));
+		}
+	}
+
+	Count = Xil_DCacheCoalesce(Ranges, NumRanges, &Total);
+
+#ifndef USE_AMP
+	/* Outer level first so L1 cannot refill from stale L2 lines */
+	Xil_L2WriteDebugCtrl(0x3U);
+	for (Index = 0U; Index < Count; Index++) {
+		LocalAddr = (u32)Ranges[Index].Addr;
+		end = LocalAddr + Ranges[Index].Len;
+		while (LocalAddr < end) {
+			*L2CCOffset = LocalAddr;
+			LocalAddr += cacheline;
+		}
+	}
+	Xil_L2CacheSync();
+	Xil_L2WriteDebugCtrl(0x0U);
+#endif
+
+	for (Index = 0U; Index < Count; Index++) {
+		LocalAddr = (u32)Ranges[Index].Addr;
+		end = LocalAddr + Ranges[Index].Len;
+		while (LocalAddr < end) {
+#if defined (__GNUC__) || defined (__ICCARM__)
+			asm_cp15_inval_dc_line_mva_poc(LocalAddr);
+#else
+			{ volatile register u32 Reg
+				__asm(XREG_CP15_INVAL_DC_LINE_MVA_POC);
+			  Reg = LocalAddr; }
+#endif
+			LocalAddr += cacheline;
+		}
+	}
+
+	dsb();
+	mtcpsr(currmask);
+}
+
+/****************************************************************************/
+/**
+* @brief	Set the size above which Xil_DCacheFlushRanges flushes the
+*			entire Data cache instead of walking the ranges line by line.
+*			The crossover depends on the cache size and memory speed and is
+*			best measured on the target.
+*
+* @param	Bytes: new threshold in bytes; 0xFFFFFFFF never flushes the
+*			whole cache.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_DCacheSetFlushThreshold(u32 Bytes)
+{
+	DCacheFlushThreshold = Bytes;
+}
+
+/****************************************************************************/
+/**
+* @brief	Get the whole-cache flush threshold of Xil_DCacheFlushRanges.
+*
+* @return	Threshold in bytes.
+*
+****************************************************************************/
+u32 Xil_DCacheGetFlushThreshold(void)
+{
+	return DCacheFlushThreshold;
+}
+
 /****************************************************************************/
 /**
 * @brief	Store a Data cache line. If the byte specified by the address (adr)
@@ -1266,6 +1544,9 @@ void Xil_L2CacheDisable(void)
 
     if((L2CCReg & 0x1U) != 0U) {
 
+        /* Release locked ways so that they are flushed as well */
+        Xil_L2CacheUnlock();
+
         /* Clean and Invalidate L2 Cache */
         Xil_L2CacheFlush();
 
@@ -1308,9 +1589,9 @@ void Xil_L2CacheInvalidate(void)
 
 	#endif
 	u32 ResultDCache;
-	/* Invalidate the caches */
+	/* Invalidate the caches, keeping the contents of locked ways */
 	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_INVLD_WAY_OFFSET,
-		  0x0000FFFFU);
+		  0x0000FFFFU & ~L2LockedWays);
 	ResultDCache = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_INVLD_WAY_OFFSET)
 							& 0x0000FFFFU;
 	while(ResultDCache != (u32)0U) {
@@ -1415,8 +1696,18 @@ void Xil_L2CacheFlush(void)
 	/* Disable Write-back and line fills */
 	Xil_L2WriteDebugCtrl(0x3U);
 
+	/* Locked ways are only cleaned so their contents stay resident */
+	if (L2LockedWays != 0U) {
+		Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_CLEAN_WAY_OFFSET,
+			  L2LockedWays);
+		while((Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_CLEAN_WAY_OFFSET)
+				& L2LockedWays) != (u32)0U) {
+			;
+		}
+	}
+
 	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_INV_CLN_WAY_OFFSET,
-		  0x0000FFFFU);
+		  0x0000FFFFU & ~L2LockedWays);
 	ResultL2Cache = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_INV_CLN_WAY_OFFSET)
 							& 0x0000FFFFU;
 
@@ -1531,4 +1822,126 @@ void Xil_L2CacheStoreLine(u32 adr)
 	/* synchronize the processor */
 	dsb();
 }
+/****************************************************************************/
+/**
+* @brief	Preload address ranges into reserved level 2 cache ways and lock
+*			them there. Lines in locked ways still hit for reads and writes
+*			but are never chosen for replacement, so they stay resident
+*			whatever else the system does. The remaining ways are available
+*			for general use. Ranges that are already locked are released
+*			first.
+*
+* @param	Regions: array of address ranges to lock.
+* @param	NumRegions: number of entries in Regions.
+* @param	NumWays: number of ways to reserve, 1 to 4.
+*
+* @return	XST_SUCCESS if the ranges fit in the reserved ways, otherwise
+*			XST_FAILURE and nothing is locked.
+*
+* @note		A way holds one line per set, so ranges whose lines fall in the
+*			same set compete for the reserved ways. Ranges totalling less
+*			than the reserved capacity can still lose lines when more
+*			than NumWays of their lines share a set.
+*
+****************************************************************************/
+s32 Xil_L2CacheLock(const Xil_CacheRange *Regions, u32 NumRegions, u32 NumWays)
+{
+	const u32 cacheline = 32U;
+	u32 WaySize;
+	u32 Total = 0U;
+	u32 WayMask;
+	u32 Index;
+	u32 LocalAddr;
+	u32 end;
+	u32 currmask;
+	volatile u32 Dummy;
+
+	if ((Regions == NULL) || (NumWays == 0U) ||
+			(NumWays > L2_MAX_LOCKED_WAYS)) {
+		return XST_FAILURE;
+	}
+
+	/* Way size is 16KB << (encoding - 1) */
+	WaySize = 0x2000U << ((Xil_In32(XPS_L2CC_BASEADDR +
+			XPS_L2CC_AUX_CNTRL_OFFSET) & XPS_L2CC_AUX_WAY_SIZE_MASK) >> 17U);
+	for (Index = 0U; Index < NumRegions; Index++) {
+		Total += Regions[Index].Len;
+	}
+	if (Total > (WaySize * NumWays)) {
+		return XST_FAILURE;
+	}
+
+	Xil_L2CacheUnlock();
+
+	/* Reserve the top ways so way 0 upwards stay general purpose */
+	WayMask = (L2_WAY_MASK << (L2_NUM_WAYS - NumWays)) & L2_WAY_MASK;
+
+	currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+
+	/* Push the ranges out so every preload misses in both levels */
+	for (Index = 0U; Index < NumRegions; Index++) {
+		Xil_DCacheFlushRange(Regions[Index].Addr, Regions[Index].Len);
+	}
+
+	/* Only the reserved ways may allocate while the ranges are read in */
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_DLCKDWN_0_WAY_OFFSET,
+		  L2_WAY_MASK & ~WayMask);
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_ILCKDWN_0_WAY_OFFSET,
+		  L2_WAY_MASK & ~WayMask);
+	dsb();
+
+	for (Index = 0U; Index < NumRegions; Index++) {
+		LocalAddr = (u32)Regions[Index].Addr & ~(cacheline - 1U);
+		end = (u32)Regions[Index].Addr + Regions[Index].Len;
+		while (LocalAddr < end) {
+			Dummy = *(volatile u32 *)LocalAddr;
+			LocalAddr += cacheline;
+		}
+	}
+	(void)Dummy;
+	dsb();
+
+	/* Lock the reserved ways; everything else allocates in the rest */
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_DLCKDWN_0_WAY_OFFSET,
+		  WayMask);
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_ILCKDWN_0_WAY_OFFSET,
+		  WayMask);
+	Xil_L2CacheSync();
+	dsb();
+
+	L2LockedWays = WayMask;
+	mtcpsr(currmask);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+* @brief	Release every level 2 cache way locked by Xil_L2CacheLock. The
+*			lines stay cached until they are replaced normally.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_L2CacheUnlock(void)
+{
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_DLCKDWN_0_WAY_OFFSET, 0x0U);
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_ILCKDWN_0_WAY_OFFSET, 0x0U);
+	Xil_L2CacheSync();
+	dsb();
+	L2LockedWays = 0U;
+}
+
+/****************************************************************************/
+/**
+* @brief	Get the level 2 cache ways locked by Xil_L2CacheLock.
+*
+* @return	Bit mask of the locked ways, 0 if none.
+*
+****************************************************************************/
+u32 Xil_L2CacheGetLockedWays(void)
+{
+	return L2LockedWays;
+}
 #endif
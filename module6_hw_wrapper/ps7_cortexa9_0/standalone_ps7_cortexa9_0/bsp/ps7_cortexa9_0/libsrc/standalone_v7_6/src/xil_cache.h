@@ -26,6 +26,8 @@
 * 3.04a sdm  01/02/12 Remove redundant dsb/dmb instructions in cache maintenance
 *		      APIs.
 * 6.8   aru  09/06/18 Removed compilation warnings for ARMCC toolchain.
+* 7.6   jmm  10/19/26 Added Xil_CacheRange and the batched range APIs
+*		      Xil_DCacheFlushRanges and Xil_DCacheInvalidateRanges.
 * </pre>
 *
 ******************************************************************************/
@@ -83,12 +85,30 @@ extern "C" {
 *@endcond
 */
 
+/**
+ * Address range for the batched cache maintenance APIs.
+ */
+typedef struct {
+	INTPTR Addr;	/**< Start address of the range */
+	u32 Len;	/**< Length of the range in bytes */
+} Xil_CacheRange;
+
+/**
+ * Default size above which Xil_DCacheFlushRanges flushes the whole cache
+ * by set/way instead of line by line.
+ */
+#define XIL_DCACHE_FLUSH_THRESHOLD_DEFAULT	0x80000U
+
 void Xil_DCacheEnable(void);
 void Xil_DCacheDisable(void);
 void Xil_DCacheInvalidate(void);
 void Xil_DCacheInvalidateRange(INTPTR adr, u32 len);
 void Xil_DCacheFlush(void);
 void Xil_DCacheFlushRange(INTPTR adr, u32 len);
+void Xil_DCacheFlushRanges(Xil_CacheRange *Ranges, u32 NumRanges);
+void Xil_DCacheInvalidateRanges(Xil_CacheRange *Ranges, u32 NumRanges);
+void Xil_DCacheSetFlushThreshold(u32 Bytes);
+u32 Xil_DCacheGetFlushThreshold(void);
 
 void Xil_ICacheEnable(void);
 void Xil_ICacheDisable(void);
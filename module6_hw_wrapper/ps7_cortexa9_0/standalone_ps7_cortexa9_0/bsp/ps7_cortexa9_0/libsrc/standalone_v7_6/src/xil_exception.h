@@ -37,6 +37,7 @@
 *                         triggeres only FIQ at EL3. Fix for CR#1062506
 # 7.6   mus      09/17/21 Updated flag checking to fix warning reported with
 #                         -Wundef compiler option CR#1110261
+* 7.6   jmm      10/19/26 Added Xil_ExceptionSelectIrqEntry.
 * </pre>
 *
 ******************************************************************************/
@@ -368,6 +369,9 @@ extern void Xil_GetExceptionRegisterHandler(u32 Exception_id,
 					Xil_ExceptionHandler *Handler, void **Data);
 
 extern void Xil_ExceptionInit(void);
+#if !defined (__aarch64__) && !defined (ARMR5)
+extern void Xil_ExceptionSelectIrqEntry(u32 Streamlined);
+#endif
 #if defined (__aarch64__)
 void Xil_SyncAbortHandler(void *CallBackRef);
 void Xil_SErrorAbortHandler(void *CallBackRef);
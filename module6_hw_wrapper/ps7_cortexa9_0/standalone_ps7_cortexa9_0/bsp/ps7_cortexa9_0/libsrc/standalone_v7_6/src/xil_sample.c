@@ -0,0 +1,313 @@
+/******************************************************************************
+* Copyright (c) 2026 Joshua M. Meise
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+/*****************************************************************************/
+/**
+* @file xil_sample.c
+*
+* Statistical PC-sampling profiler driven by the SCU private timer. See
+* xil_sample.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------- -------- ---------------------------------------------------
+* 7.6   jmm     10/19/26 First release.
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xil_sample.h"
+#include "xil_printf.h"
+#include "xil_exception.h"
+#include "xparameters.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+#include "xscugic_hw.h"
+#include "xscutimer_hw.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_SAMPLE_TIMER	XPAR_PS7_SCUTIMER_0_BASEADDR
+#define XIL_SAMPLE_INTR		XPS_SCU_TMR_INT_ID
+#define XIL_SAMPLE_PRIORITY	0x80U	/* above the default of every other id */
+
+/**************************** Type Definitions ******************************/
+
+typedef struct {
+	u32 Depth;
+	u32 Pc;
+	u32 Lr;
+	u32 Frames[XIL_SAMPLE_MAX_DEPTH];
+} Xil_Sample;
+
+/************************** Variable Definitions ****************************/
+
+volatile Xil_SampleContext Xil_SampleCtx;
+
+extern u32 _stack_end[];
+extern u32 __stack[];
+
+static Xil_Sample SampleRing[XIL_SAMPLE_RING];
+static volatile u32 SampleHead;		/* written by the handler */
+static volatile u32 SampleTail;		/* written by Xil_SampleDrain */
+static u32 SampleDepth;
+static u32 SampleRate;
+static volatile u32 SampleTaken;
+static volatile u32 SampleDropped;
+static u32 SampleSent;
+static volatile u32 SampleIsrCycles;	/* total, wraps */
+static volatile u32 SampleIsrMax;
+
+/************************** Function Prototypes *****************************/
+
+/****************************************************************************/
+/**
+*
+* @brief	Follows the frame pointer chain of the interrupted code through
+*			the system stack.
+*
+* @param	Frames: Return addresses, innermost first.
+* @param	Max: Most return addresses to record.
+*
+* @return	Number of return addresses recorded.
+*
+*****************************************************************************/
+static u32 Xil_SampleUnwind(u32 *Frames, u32 Max)
+{
+	u32 Fp = Xil_SampleCtx.Fp;
+	u32 Prev;
+	u32 Depth = 0U;
+
+	while (Depth < Max) {
+		/* fp points at the saved lr; the caller's fp is below it */
+		if (((Fp & 0x3U) != 0U) || (Fp < ((UINTPTR)_stack_end + 4U)) ||
+				(Fp >= (UINTPTR)__stack)) {
+			break;
+		}
+		Frames[Depth] = *(u32 *)(UINTPTR)Fp;
+		Depth++;
+		Prev = *(u32 *)(UINTPTR)(Fp - 4U);
+		if (Prev <= Fp) {
+			break;
+		}
+		Fp = Prev;
+	}
+
+	return Depth;
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Sampling timer handler: records one sample, or counts it as
+*			dropped if the ring is full.
+*
+* @param	CallBackRef: Unused.
+*
+* @return	None.
+*
+*****************************************************************************/
+static void Xil_SampleHandler(void *CallBackRef)
+{
+	u32 Start = mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+	Xil_Sample *Sample;
+	u32 Head = SampleHead;
+	u32 Cycles;
+
+	(void)CallBackRef;
+	XScuTimer_SetIntrReg(XIL_SAMPLE_TIMER, XSCUTIMER_ISR_EVENT_FLAG_MASK);
+
+	if ((Head - SampleTail) >= XIL_SAMPLE_RING) {
+		SampleDropped++;
+	} else {
+		Sample = &SampleRing[Head & (XIL_SAMPLE_RING - 1U)];
+		Sample->Pc = Xil_SampleCtx.Pc;
+		Sample->Lr = Xil_SampleCtx.Lr;
+		Sample->Depth = Xil_SampleUnwind(Sample->Frames, SampleDepth);
+		dmb();
+		SampleHead = Head + 1U;
+		SampleTaken++;
+	}
+
+	Cycles = mfcp(XREG_CP15_PERF_CYCLE_COUNTER) - Start;
+	SampleIsrCycles += Cycles;
+	if (Cycles > SampleIsrMax) {
+		SampleIsrMax = Cycles;
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Starts sampling.
+*
+* @param	RateHz: Samples per second.
+* @param	Depth: Return addresses per sample, at most
+*			XIL_SAMPLE_MAX_DEPTH.
+*
+* @return	XST_SUCCESS, or XST_FAILURE if the BSP was built without
+*			XIL_SAMPLE or the rate is out of range.
+*
+*****************************************************************************/
+s32 Xil_SampleStart(u32 RateHz, u32 Depth)
+{
+#ifdef XIL_SAMPLE
+	/* the private timer runs at half the cpu clock */
+	u32 Load;
+
+	if ((RateHz == 0U) || (RateHz > (XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / 2U))) {
+		return XST_FAILURE;
+	}
+	Load = ((XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / 2U) / RateHz) - 1U;
+
+	SampleDepth = (Depth > XIL_SAMPLE_MAX_DEPTH) ? XIL_SAMPLE_MAX_DEPTH : Depth;
+	SampleRate = RateHz;
+	SampleHead = 0U;
+	SampleTail = 0U;
+	SampleTaken = 0U;
+	SampleDropped = 0U;
+	SampleSent = 0U;
+	SampleIsrCycles = 0U;
+	SampleIsrMax = 0U;
+
+	/* The handler times itself with the cycle counter */
+	mtcp(XREG_CP15_PERF_MONITOR_CTRL,
+		(mfcp(XREG_CP15_PERF_MONITOR_CTRL) | 0x1U) & ~0x8U);
+	mtcp(XREG_CP15_COUNT_ENABLE_SET, 0x80000000U);
+
+	XScuTimer_SetControlReg(XIL_SAMPLE_TIMER, 0U);
+	XScuTimer_SetIntrReg(XIL_SAMPLE_TIMER, XSCUTIMER_ISR_EVENT_FLAG_MASK);
+	XScuGic_RegisterHandler(XPAR_SCUGIC_0_CPU_BASEADDR, (s32)XIL_SAMPLE_INTR,
+				(Xil_InterruptHandler)Xil_SampleHandler, NULL);
+	XScuGic_SetPriTrigTypeByDistAddr(XPAR_SCUGIC_0_DIST_BASEADDR,
+				XIL_SAMPLE_INTR, (u8)XIL_SAMPLE_PRIORITY, 0x3U);
+	XScuGic_EnableIntr(XPAR_SCUGIC_0_DIST_BASEADDR, XIL_SAMPLE_INTR);
+	XScuTimer_SetLoadReg(XIL_SAMPLE_TIMER, Load);
+	XScuTimer_SetControlReg(XIL_SAMPLE_TIMER, XSCUTIMER_CONTROL_IRQ_ENABLE_MASK |
+				XSCUTIMER_CONTROL_AUTO_RELOAD_MASK | XSCUTIMER_CONTROL_ENABLE_MASK);
+
+	return XST_SUCCESS;
+#else
+	(void)RateHz;
+	(void)Depth;
+	return XST_FAILURE;
+#endif
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Stops sampling. Samples still in the ring can be drained.
+*
+* @return	None.
+*
+*****************************************************************************/
+void Xil_SampleStop(void)
+{
+	XScuTimer_SetControlReg(XIL_SAMPLE_TIMER, 0U);
+	XScuGic_DisableIntr(XPAR_SCUGIC_0_DIST_BASEADDR, XIL_SAMPLE_INTR);
+	XScuTimer_SetIntrReg(XIL_SAMPLE_TIMER, XSCUTIMER_ISR_EVENT_FLAG_MASK);
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Sends a word over the stdout UART, least significant byte first.
+*
+* @param	Word: The word.
+*
+* @return	None.
+*
+*****************************************************************************/
+static void Xil_SampleSendWord(u32 Word)
+{
+	outbyte((char8)(Word & 0xFFU));
+	outbyte((char8)((Word >> 8U) & 0xFFU));
+	outbyte((char8)((Word >> 16U) & 0xFFU));
+	outbyte((char8)(Word >> 24U));
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Sends buffered samples over the stdout UART. Call from the
+*			foreground; the UART writes block.
+*
+* @param	Max: Most samples to send.
+*
+* @return	Number of samples sent.
+*
+*****************************************************************************/
+u32 Xil_SampleDrain(u32 Max)
+{
+	Xil_Sample *Sample;
+	u32 Sent;
+	u32 Index;
+
+	for (Sent = 0U; (Sent < Max) && (SampleTail != SampleHead); Sent++) {
+		dmb();
+		Sample = &SampleRing[SampleTail & (XIL_SAMPLE_RING - 1U)];
+		outbyte((char8)XIL_SAMPLE_MAGIC0);
+		outbyte((char8)XIL_SAMPLE_MAGIC1);
+		outbyte((char8)Sample->Depth);
+		outbyte((char8)0);
+		Xil_SampleSendWord(Sample->Pc);
+		Xil_SampleSendWord(Sample->Lr);
+		for (Index = 0U; Index < Sample->Depth; Index++) {
+			Xil_SampleSendWord(Sample->Frames[Index]);
+		}
+		dmb();
+		SampleTail++;
+	}
+	SampleSent += Sent;
+
+	return Sent;
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Reads the sampler counters. The overhead covers the handler
+*			body only; the IRQ entry and exit come on top.
+*
+* @param	Stats: Filled in.
+*
+* @return	None.
+*
+*****************************************************************************/
+void Xil_SampleGetStats(Xil_SampleStats *Stats)
+{
+	u32 Calls = SampleTaken + SampleDropped;
+
+	Stats->Taken = SampleTaken;
+	Stats->Dropped = SampleDropped;
+	Stats->Sent = SampleSent;
+	Stats->IsrMean = (Calls != 0U) ? (SampleIsrCycles / Calls) : 0U;
+	Stats->IsrMax = SampleIsrMax;
+	Stats->OverheadPpm = (u32)(((u64)Stats->IsrMean * SampleRate * 1000000U) /
+				XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ);
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Prints the sampler counters as one line on the stdout UART.
+*
+* @return	None.
+*
+*****************************************************************************/
+void Xil_SampleReport(void)
+{
+	Xil_SampleStats Stats;
+
+	Xil_SampleGetStats(&Stats);
+	xil_printf("\r\n[sample rate %u taken %u dropped %u sent %u isr mean %u max %u overhead %u ppm]\r\n",
+		SampleRate, Stats.Taken, Stats.Dropped, Stats.Sent,
+		Stats.IsrMean, Stats.IsrMax, Stats.OverheadPpm);
+}
@@ -0,0 +1,96 @@
+/******************************************************************************
+* Copyright (c) 2026 Joshua M. Meise
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+/*****************************************************************************/
+/**
+* @file xil_sample.h
+*
+* Statistical PC-sampling profiler for the Cortex-A9.
+*
+* The SCU private timer interrupts at a configurable rate. Each interrupt
+* records the interrupted PC and LR and a shallow backtrace, found by
+* following the frame pointer chain through the system stack, into a ring.
+* The foreground drains the ring over the stdout UART with
+* Xil_SampleDrain; m6_sw/tools/sample_fold.py symbolizes the stream
+* against the ELF and prints folded stacks for flame graphs.
+*
+* The interrupted registers are captured by the IRQ entry in
+* asm_vectors.S, so the BSP must be built with XIL_SAMPLE=1 (which defines
+* XIL_SAMPLE); otherwise Xil_SampleStart fails. Backtraces need the
+* application built with -marm -fno-omit-frame-pointer, which gives the
+* frame layout {fp, lr} with fp pointing at the saved lr.
+*
+* Each sample is sent as a frame of little-endian words:
+*	0xA5 0x5A <depth> 0x00, PC, LR, <depth> return addresses
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------- -------- ---------------------------------------------------
+* 7.6   jmm     10/19/26 First release.
+* </pre>
+*
+* @note
+*
+* Interrupt handlers mask the sampling interrupt, so time spent in them
+* is attributed to the code they return to, unless they enable nesting.
+*
+******************************************************************************/
+
+#ifndef XIL_SAMPLE_H /* prevent circular inclusions */
+#define XIL_SAMPLE_H /* by using protection macros */
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files ********************************/
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_SAMPLE_MAX_DEPTH	8U	/* return addresses kept per sample */
+#define XIL_SAMPLE_RING		256U	/* samples buffered, a power of two */
+#define XIL_SAMPLE_MAGIC0	0xA5U
+#define XIL_SAMPLE_MAGIC1	0x5AU
+
+/**************************** Type Definitions ******************************/
+
+/* Registers of the interrupted code, stored by the IRQ entry */
+typedef struct {
+	u32 Pc;
+	u32 Fp;
+	u32 Sp;
+	u32 Lr;
+} Xil_SampleContext;
+
+/* Sampler counters */
+typedef struct {
+	u32 Taken;		/* samples recorded */
+	u32 Dropped;		/* samples lost to a full ring */
+	u32 Sent;		/* samples sent over the UART */
+	u32 IsrMean;		/* cycles in the sampling handler */
+	u32 IsrMax;
+	u32 OverheadPpm;	/* IsrMean * rate / cpu clock, parts per million */
+} Xil_SampleStats;
+
+/************************** Variable Definitions ****************************/
+
+extern volatile Xil_SampleContext Xil_SampleCtx;
+
+/************************** Function Prototypes *****************************/
+
+s32 Xil_SampleStart(u32 RateHz, u32 Depth);
+void Xil_SampleStop(void);
+u32 Xil_SampleDrain(u32 Max);
+void Xil_SampleGetStats(Xil_SampleStats *Stats);
+void Xil_SampleReport(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XIL_SAMPLE_H */
@@ -0,0 +1,106 @@
+/******************************************************************************
+* Copyright (c) 2026 Joshua M. Meise
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file boot_time.c
+*
+* Records the end of each FSBL boot stage in the boot time log in OCM,
+* where the application reads it after handoff. See boot_time.h for the
+* layout.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a jmm	10/19/26	Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "boot_time.h"
+#include "xtime_l.h"
+#include "xil_cache.h"
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define BootTimeLogPtr	((volatile BootTimeLog *)BOOT_TIME_LOG_ADDR)
+
+/************************** Function Prototypes ******************************/
+
+/************************** Variable Definitions *****************************/
+
+/******************************************************************************/
+/**
+*
+* This function empties the boot time log. The magic is written last, so a
+* log left over from an earlier boot is never mistaken for this one.
+*
+* @param	None
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+void BootTimeInit(void)
+{
+	volatile BootTimeLog *Log = BootTimeLogPtr;
+
+	Log->Magic = 0;
+	Log->Count = 0;
+	Log->CountsPerSecond = COUNTS_PER_SECOND;
+	Log->Dropped = 0;
+	Log->Magic = BOOT_TIME_MAGIC;
+
+	Xil_DCacheFlushRange(BOOT_TIME_LOG_ADDR, BOOT_TIME_LOG_SIZE);
+}
+
+/******************************************************************************/
+/**
+*
+* This function records the end of a boot stage
+*
+* @param	Stage is the BOOT_STAGE_* that has just ended
+* @param	Partition is the partition number, or BOOT_TIME_NO_PARTITION
+*
+* @return	None
+*
+* @note		The FSBL runs with the data cache mostly disabled, but the
+*			point is flushed anyway so it reaches OCM however it was written.
+*
+****************************************************************************/
+void BootTimeMark(u32 Stage, u32 Partition)
+{
+	volatile BootTimeLog *Log = BootTimeLogPtr;
+	volatile BootTimePoint *Point;
+	XTime Now;
+	u32 Count;
+
+	XTime_GetTime(&Now);
+
+	Count = Log->Count;
+	if (Count >= BOOT_TIME_MAX_POINTS) {
+		Log->Dropped++;
+	} else {
+		Point = &Log->Point[Count];
+		Point->Stage = (u16)Stage;
+		Point->Partition = (u16)Partition;
+		Point->Time = (u32)Now;
+		Log->Count = Count + 1;
+	}
+
+	Xil_DCacheFlushRange(BOOT_TIME_LOG_ADDR, BOOT_TIME_LOG_SIZE);
+}
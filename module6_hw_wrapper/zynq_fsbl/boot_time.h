@@ -0,0 +1,122 @@
+/******************************************************************************
+* Copyright (c) 2026 Joshua M. Meise
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file boot_time.h
+*
+* Contains the layout of the boot time log and the prototypes required by
+* boot_time.c
+*
+* The FSBL records a checkpoint at the end of each boot stage in a log at a
+* fixed address in the top of the high OCM. Neither the FSBL (whose stacks
+* end well below it) nor the application (whose linker script stops
+* ps7_ram_1 at BOOT_TIME_LOG_ADDR) places anything there, so the log
+* survives the handoff and the application can print it on every boot.
+*
+* Each point holds the low word of the global timer when its stage ended;
+* the timer is reset by the FSBL start-up code, so times count from FSBL
+* entry. The time of a stage is the difference to the point before it.
+* The global timer runs from the CPU clock, which ps7_init switches over,
+* so the ps7_init point is only approximate.
+*
+* The layout is shared with m6_sw/src/boottime.h; change both together and
+* bump BOOT_TIME_MAGIC when it changes.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a jmm	10/19/26	Initial release
+* 2.00a jmm	10/19/26	Added the decompress stage
+* 3.00a jmm	10/19/26	Added the pcap start stage
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#ifndef ___BOOT_TIME_H___
+#define ___BOOT_TIME_H___
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+
+/*
+ * Log location and size; the last 0x200 bytes of the high OCM belong to
+ * the boot ROM
+ */
+#define BOOT_TIME_LOG_ADDR		0xFFFFFD00U
+#define BOOT_TIME_LOG_SIZE		0x100U
+#define BOOT_TIME_MAGIC			0x42544D31U	/* "BTM1" */
+#define BOOT_TIME_MAX_POINTS	30U
+
+/*
+ * Boot stages, each recorded when it ends
+ */
+#define BOOT_STAGE_PS7_INIT		0U	/* MIO, PLL, clock and DDR setup */
+#define BOOT_STAGE_DDR_CHECK	1U	/* DDR read/write test */
+#define BOOT_STAGE_PCAP_INIT	2U	/* devcfg driver */
+#define BOOT_STAGE_WDT_INIT		3U	/* watchdog */
+#define BOOT_STAGE_DEVICE_INIT	4U	/* boot device */
+#define BOOT_STAGE_HEADER		5U	/* image and partition headers */
+#define BOOT_STAGE_MOVE			6U	/* partition copy (and streamed PCAP) */
+#define BOOT_STAGE_CHECKSUM		7U	/* partition MD5 */
+#define BOOT_STAGE_AUTH			8U	/* partition RSA */
+#define BOOT_STAGE_DECRYPT		9U	/* PS partition AES */
+#define BOOT_STAGE_PCAP			10U	/* bitstream download, or the wait for it */
+#define BOOT_STAGE_HANDOFF		11U	/* just before the jump */
+#define BOOT_STAGE_DECOMPRESS	12U	/* checked LZ4 partition */
+#define BOOT_STAGE_PCAP_START	13U	/* fabric init, bitstream DMA started */
+
+#define BOOT_TIME_NO_PARTITION	0xFFFFU
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u16 Stage;		/* BOOT_STAGE_* */
+	u16 Partition;	/* partition number or BOOT_TIME_NO_PARTITION */
+	u32 Time;		/* global timer, low word */
+} BootTimePoint;
+
+typedef struct {
+	u32 Magic;				/* BOOT_TIME_MAGIC once the log is valid */
+	u32 Count;				/* points recorded */
+	u32 CountsPerSecond;	/* global timer rate */
+	u32 Dropped;			/* points that did not fit */
+	BootTimePoint Point[BOOT_TIME_MAX_POINTS];
+} BootTimeLog;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * Checkpoints compile out with FSBL_NO_BOOT_TIME
+ */
+#ifndef FSBL_NO_BOOT_TIME
+#define BOOT_TIME_INIT()				BootTimeInit()
+#define BOOT_TIME_MARK(Stage, Part)		BootTimeMark((Stage), (Part))
+#else
+#define BOOT_TIME_INIT()
+#define BOOT_TIME_MARK(Stage, Part)
+#endif
+
+/************************** Function Prototypes ******************************/
+
+void BootTimeInit(void);
+void BootTimeMark(u32 Stage, u32 Partition);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ___BOOT_TIME_H___ */
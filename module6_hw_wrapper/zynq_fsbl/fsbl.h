@@ -238,6 +238,32 @@
 * (in case of SD/NAND bootmode)
 * and programming the devcfg dma is accounted.
 *
+* FSBL_NO_BOOT_TIME
+*
+* By default FSBL records the end of each boot stage (ps7_init, DDR check,
+* devcfg and watchdog init, boot device init, headers, each partition move,
+* checksum, authentication, decryption and bitstream download, handoff)
+* in the boot time log in OCM at BOOT_TIME_LOG_ADDR, which the application
+* can read after handoff. This flag compiles the checkpoints out.
+*
+* SD_RAW_BOOT
+*
+* In SD and MMC boot modes, look for the boot image outside the filesystem
+* first: in the GPT partition named SD_RAW_BOOT_PARTITION (default
+* "zynq-boot") or, if SD_RAW_BOOT_SECTOR is defined, at that sector. The
+* image is read with multi-block transfers and the FAT volume is never
+* mounted. Without a boot header in either place FSBL opens BOOT.BIN on
+* FAT as usual.
+*
+* FSBL_NO_CONCURRENT_PCAP
+*
+* By default a checksummed or signed bitstream is staged at the top of DDR
+* and, once checked, PCAP loads it while FSBL goes on to load the PS
+* partitions that follow; FSBL waits for the fabric, then calls
+* FsblHookAfterBitstreamDload, before the first partition that needs PCAP
+* or would overwrite the staged bitstream, and before handoff. This flag
+* loads it in line from DDR_TEMP_START_ADDR as before.
+*
 * FSBL provides two debug levels
 * DEBUG GENERAL - fsbl_printf under this category will appear only when the
 * FSBL_DEBUG flag is set during compilation
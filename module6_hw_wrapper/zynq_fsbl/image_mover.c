@@ -49,6 +49,18 @@
 * 						encryption with E-Fuse - Enhancement
 * 11.00a ka 10/12/18    Fix for CR#1006294 Zynq FSBL - Zynq FSBL does not check
 * 						USE_AES_ONLY eFuse
+* 12.00a jmm 10/19/26   Profiling regions around the partition load steps
+* 13.00a jmm 10/19/26   Hash checksummed partitions while they are copied
+*                       from a non-linear device
+* 14.00a jmm 10/19/26   Chunked load from non-linear devices that streams
+*                       unchecked bitstreams to PCAP as they are read
+* 15.00a jmm 10/19/26   Boot time points for the headers and each partition
+*                       step
+* 16.00a jmm 10/19/26   LZ4 compressed partitions
+* 17.00a jmm 10/19/26   Load the PS partitions while PCAP configures a
+*                       checked bitstream
+* 18.00a jmm 10/19/26   SHA-256 of signed partitions computed chunk by
+*                       chunk during the pipelined load
 *
 * </pre>
 *
@@ -65,6 +77,10 @@
 #include "pcap.h"
 #include "fsbl_hooks.h"
 #include "md5.h"
+#include "xpm_counter.h"
+#include "xil_cache.h"
+#include "boot_time.h"
+#include "lz4.h"
 
 #ifdef XPAR_XWDTPS_0_BASEADDR
 #include "xwdtps.h"
@@ -72,7 +88,7 @@
 
 #ifdef RSA_SUPPORT
 #include "rsa.h"
-#include "xil_cache.h"
+#include "sha256.h"
 #endif
 /************************** Constant Definitions *****************************/
 
@@ -80,6 +96,28 @@
 #define MAXIMUM_IMAGE_WORD_LEN 0x40000000
 #define MD5_CHECKSUM_SIZE   16
 
+/*
+ * Chunk size of the pipelined load from non-linear devices; two chunks
+ * at DDR_TEMP_START_ADDR stage a streamed bitstream
+ */
+#ifndef PIPE_CHUNK_SIZE
+#define PIPE_CHUNK_SIZE		0x10000
+#endif
+
+#define PIPE_US(t)	((u32)(((t) * 1000000U) / COUNTS_PER_SECOND))
+
+/*
+ * Compressed partitions: a decoded bitstream goes to PCAP from two
+ * alternating block buffers at DDR_TEMP_START_ADDR. Compressed blocks
+ * read from the boot device land in a window at the top of DDR, fetched
+ * from LZ4_FETCH_ALIGN boundaries so SD reads stay whole sectors; a
+ * checked partition is staged whole below the top of DDR instead.
+ */
+#define LZ4_PCAP_BUFFERS_SIZE	(2 * LZ4_MAX_BLOCK_SIZE)
+#define LZ4_FETCH_ALIGN		0x200
+#define LZ4_WINDOW_SIZE		(LZ4_MAX_BLOCK_SIZE + (2 * LZ4_FETCH_ALIGN))
+#define LZ4_WINDOW_ADDR		((DDR_END_ADDR + 1) - LZ4_WINDOW_SIZE)
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -88,8 +126,68 @@
 u32 ValidateParition(u32 StartAddr, u32 Length, u32 ChecksumOffset);
 u32 GetPartitionChecksum(u32 ChecksumOffset, u8 *Checksum);
 u32 CalcPartitionChecksum(u32 SourceAddr, u32 DataLength, u8 *Checksum);
+u32 PipelinedMove(u32 SourceAddr, u32 LoadAddr, u32 Length, u8 ToPcap);
+#ifdef RSA_SUPPORT
+static const u8 *TakeMovedHash(u32 Addr, u32 Length);
+#endif
+u32 DecompressPartition(u32 SourceAddr, u32 Length, u32 LoadAddr,
+		u8 FromMemory);
+static u32 CompressedStageAddr(u32 Length);
+static u32 BitstreamStageAddr(u32 Length);
+static u32 BitstreamOverlap(u32 Addr, u32 Length);
+static void BitstreamFinish(void);
+static u32 CompressedFetch(u32 SourceAddr, u32 Offset, u32 Length,
+		u8 FromMemory, const u8 **Data);
 
 /************************** Variable Definitions *****************************/
+
+/*
+ * Profiling regions for the load path; only collected with -DXPM_REGIONS
+ */
+XPM_REGION_DEFINE(partition_move);
+XPM_REGION_DEFINE(partition_checksum);
+XPM_REGION_DEFINE(partition_auth);
+XPM_REGION_DEFINE(partition_decrypt);
+XPM_REGION_DEFINE(partition_decompress);
+XPM_REGION_DEFINE(pcap_load);
+XPM_REGION_DEFINE(pcap_wait);
+
+/*
+ * Stage times of the last pipelined load
+ */
+PipeStats PipelineStats;
+
+/*
+ * Set by PipelinedMove while a checksummed partition is read from a
+ * non-linear device; the device copy routine hashes into it as it copies
+ */
+MD5Context *MoveChecksumContext;
+
+/*
+ * Digest of the partition last hashed that way, and where it was loaded
+ */
+static u8 MovedChecksum[MD5_CHECKSUM_SIZE];
+static u32 MovedChecksumAddr;
+static u32 MovedChecksumLength;
+
+#ifdef RSA_SUPPORT
+/*
+ * SHA-256 of the last signed partition PipelinedMove loaded, certificate
+ * signature excluded, and where it was loaded
+ */
+static u8 MovedHash[SHA256_HASH_SIZE];
+static u32 MovedHashAddr;
+static u32 MovedHashLength;
+#endif
+
+/*
+ * Checked bitstream PCAP is still loading, from where, and its partition
+ */
+static u32 BitstreamLoading;
+static u32 BitstreamAddr;
+static u32 BitstreamLength;
+static u32 BitstreamPartition;
+
 /*
  * Partition information flags
  */
@@ -98,6 +196,7 @@ u8 PLPartitionFlag;
 u8 PSPartitionFlag;
 u8 SignedPartitionFlag;
 u8 PartitionChecksumFlag;
+u8 CompressedPartitionFlag;
 u8 BitstreamFlag;
 u8 ApplicationFlag;
 
@@ -163,6 +262,7 @@ u32 LoadBootImage(void)
 	 */
 	BitstreamFlag = 0;
 	ApplicationFlag = 0;
+	BitstreamLoading = 0;
 
 	RebootStatusRegister = Xil_In32(REBOOT_STATUS_REG);
 	fsbl_printf(DEBUG_INFO,
@@ -261,6 +361,7 @@ u32 LoadBootImage(void)
 #endif
 		}
 	}
+	BOOT_TIME_MARK(BOOT_STAGE_HEADER, BOOT_TIME_NO_PARTITION);
 
 #ifdef MMC_SUPPORT
 	/*
@@ -391,6 +492,16 @@ u32 LoadBootImage(void)
 			SignedPartitionFlag = 0;
 		}
 
+		/*
+		 * LZ4 compressed partition
+		 */
+		if (PartitionAttr & ATTRIBUTE_COMPRESSED_MASK) {
+			fsbl_printf(DEBUG_INFO, "Compressed\r\n");
+			CompressedPartitionFlag = 1;
+		} else {
+			CompressedPartitionFlag = 0;
+		}
+
 		/*
 		 * Load address check
 		 * Loop will break when PS load address zero and partition is
@@ -424,6 +535,17 @@ u32 LoadBootImage(void)
         	ExecAddress = PartitionExecAddr;
         }
 
+		/*
+		 * A bitstream still loading must be done before a partition
+		 * that needs PCAP, or whose load could overwrite it, is moved
+		 */
+		if (BitstreamLoading && (PLPartitionFlag || EncryptedPartitionFlag ||
+				CompressedPartitionFlag ||
+				BitstreamOverlap(PartitionLoadAddr,
+					PartitionTotalSize << WORD_LENGTH_SHIFT))) {
+			BitstreamFinish();
+		}
+
 		/*
 		 * FSBL user hook call before bitstream download
 		 */
@@ -439,20 +561,31 @@ u32 LoadBootImage(void)
 		/*
 		 * Move partitions from boot device
 		 */
+		XPM_REGION_BEGIN(partition_move);
 		Status = PartitionMove(ImageStartAddress, HeaderPtr);
+		XPM_REGION_END(partition_move);
 		if (Status != XST_SUCCESS) {
 			fsbl_printf(DEBUG_GENERAL,"PARTITION_MOVE_FAIL\r\n");
 			OutputStatus(PARTITION_MOVE_FAIL);
 			FsblFallback();
 		}
+		BOOT_TIME_MARK(BOOT_STAGE_MOVE, PartitionNum);
 
 		if ((SignedPartitionFlag) || (PartitionChecksumFlag)) {
-			if(PLPartitionFlag) {
+			if (CompressedPartitionFlag) {
+				/*
+				 * Compressed partition staged at the top of DDR;
+				 * it is checked as stored and decompressed after
+				 */
+				PartitionStartAddr = CompressedStageAddr(
+						PartitionTotalSize << WORD_LENGTH_SHIFT);
+			} else if(PLPartitionFlag) {
 				/*
 				 * PL partition loaded in to DDR temporary address
 				 * for authentication and checksum verification
 				 */
-				PartitionStartAddr = DDR_TEMP_START_ADDR;
+				PartitionStartAddr = BitstreamStageAddr(
+						PartitionTotalSize << WORD_LENGTH_SHIFT);
 			} else {
 				PartitionStartAddr = PartitionLoadAddr;
 			}
@@ -461,10 +594,12 @@ u32 LoadBootImage(void)
 				/*
 				 * Validate the partition data with checksum
 				 */
+				XPM_REGION_BEGIN(partition_checksum);
 				Status = ValidateParition(PartitionStartAddr,
 						(PartitionTotalSize << WORD_LENGTH_SHIFT),
 						ImageStartAddress  +
 						(PartitionChecksumOffset << WORD_LENGTH_SHIFT));
+				XPM_REGION_END(partition_checksum);
 				if (Status != XST_SUCCESS) {
 					fsbl_printf(DEBUG_GENERAL,"PARTITION_CHECKSUM_FAIL\r\n");
 					OutputStatus(PARTITION_CHECKSUM_FAIL);
@@ -472,6 +607,7 @@ u32 LoadBootImage(void)
 				}
 
 				fsbl_printf(DEBUG_INFO, "Partition Validation Done\r\n");
+				BOOT_TIME_MARK(BOOT_STAGE_CHECKSUM, PartitionNum);
 			}
 
 			/*
@@ -480,8 +616,12 @@ u32 LoadBootImage(void)
 			if (SignedPartitionFlag == 1 ) {
 #ifdef RSA_SUPPORT
 				Xil_DCacheEnable();
-				Status = AuthenticatePartition((u8*)PartitionStartAddr,
-						(PartitionTotalSize << WORD_LENGTH_SHIFT));
+				XPM_REGION_BEGIN(partition_auth);
+				Status = AuthenticatePartitionHash((u8*)PartitionStartAddr,
+						(PartitionTotalSize << WORD_LENGTH_SHIFT),
+						TakeMovedHash(PartitionStartAddr,
+						(PartitionTotalSize << WORD_LENGTH_SHIFT)));
+				XPM_REGION_END(partition_auth);
 				if (Status != XST_SUCCESS) {
 					Xil_DCacheFlush();
 		        	Xil_DCacheDisable();
@@ -492,6 +632,7 @@ u32 LoadBootImage(void)
 				fsbl_printf(DEBUG_INFO,"Authentication Done\r\n");
 				Xil_DCacheFlush();
                 Xil_DCacheDisable();
+				BOOT_TIME_MARK(BOOT_STAGE_AUTH, PartitionNum);
 #else
 				/*
 				 * In case user not enabled RSA authentication feature
@@ -506,38 +647,87 @@ u32 LoadBootImage(void)
 			 * Decrypt PS partition
 			 */
 			if (EncryptedPartitionFlag && PSPartitionFlag) {
+				XPM_REGION_BEGIN(partition_decrypt);
 				Status = DecryptPartition(PartitionStartAddr,
 						PartitionDataLength,
 						PartitionImageLength);
+				XPM_REGION_END(partition_decrypt);
 				if (Status != XST_SUCCESS) {
 					fsbl_printf(DEBUG_GENERAL,"DECRYPTION_FAIL\r\n");
 					OutputStatus(DECRYPTION_FAIL);
 					FsblFallback();
 				}
+				BOOT_TIME_MARK(BOOT_STAGE_DECRYPT, PartitionNum);
+			}
+
+			/*
+			 * Decompress the checked partition to its load address,
+			 * or into the fabric
+			 */
+			if (CompressedPartitionFlag) {
+				XPM_REGION_BEGIN(partition_decompress);
+				Status = DecompressPartition(PartitionStartAddr,
+						(PartitionImageLength << WORD_LENGTH_SHIFT),
+						PartitionLoadAddr, 1);
+				XPM_REGION_END(partition_decompress);
+				if (Status != XST_SUCCESS) {
+					fsbl_printf(DEBUG_GENERAL,"DECOMPRESSION_FAIL\r\n");
+					OutputStatus(PARTITION_LOAD_FAIL);
+					FsblFallback();
+				}
+				BOOT_TIME_MARK(BOOT_STAGE_DECOMPRESS, PartitionNum);
 			}
 
 			/*
 			 * Load Signed PL partition in Fabric
 			 */
-			if (PLPartitionFlag) {
+			if (PLPartitionFlag && (!CompressedPartitionFlag)) {
+#ifndef FSBL_NO_CONCURRENT_PCAP
+				/*
+				 * Start it and go on with the next partitions; it is
+				 * finished by BitstreamFinish
+				 */
+				XPM_REGION_BEGIN(pcap_load);
+				Status = PcapLoadPartitionStart((u32*)PartitionStartAddr,
+						(u32*)PartitionLoadAddr,
+						PartitionImageLength,
+						PartitionDataLength,
+						EncryptedPartitionFlag);
+				XPM_REGION_END(pcap_load);
+				if (Status != XST_SUCCESS) {
+					fsbl_printf(DEBUG_GENERAL,"BITSTREAM_DOWNLOAD_FAIL\r\n");
+					OutputStatus(BITSTREAM_DOWNLOAD_FAIL);
+					FsblFallback();
+				}
+				BitstreamLoading = 1;
+				BitstreamAddr = PartitionStartAddr;
+				BitstreamLength = PartitionTotalSize << WORD_LENGTH_SHIFT;
+				BitstreamPartition = PartitionNum;
+				BOOT_TIME_MARK(BOOT_STAGE_PCAP_START, PartitionNum);
+#else
+				XPM_REGION_BEGIN(pcap_load);
 				Status = PcapLoadPartition((u32*)PartitionStartAddr,
 						(u32*)PartitionLoadAddr,
 						PartitionImageLength,
 						PartitionDataLength,
 						EncryptedPartitionFlag);
+				XPM_REGION_END(pcap_load);
 				if (Status != XST_SUCCESS) {
 					fsbl_printf(DEBUG_GENERAL,"BITSTREAM_DOWNLOAD_FAIL\r\n");
 					OutputStatus(BITSTREAM_DOWNLOAD_FAIL);
 					FsblFallback();
 				}
+				BOOT_TIME_MARK(BOOT_STAGE_PCAP, PartitionNum);
+#endif
 			}
 		}
 
 
 		/*
-		 * FSBL user hook call after bitstream download
+		 * FSBL user hook call after bitstream download; for a bitstream
+		 * still loading, BitstreamFinish calls it
 		 */
-		if (PLPartitionFlag) {
+		if (PLPartitionFlag && (!BitstreamLoading)) {
 			Status = FsblHookAfterBitstreamDload();
 			if (Status != XST_SUCCESS) {
 				fsbl_printf(DEBUG_GENERAL,"FSBL_AFTER_BSTREAM_HOOK_FAIL\r\n");
@@ -551,9 +741,83 @@ u32 LoadBootImage(void)
 		PartitionNum++;
 	}
 
+	/*
+	 * The fabric has to be configured before handoff
+	 */
+	if (BitstreamLoading) {
+		BitstreamFinish();
+	}
+
 	return ExecAddress;
 }
 
+
+/*****************************************************************************/
+/**
+*
+* This function finishes the checked bitstream LoadBootImage left loading:
+* it waits for PCAP to be done and then calls the after bitstream download
+* hook, as LoadBootImage does for a bitstream loaded in line
+*
+* @param	None
+*
+* @return	None; falls back on failure
+*
+* @note		None
+*
+****************************************************************************/
+static void BitstreamFinish(void)
+{
+	u32 Status;
+
+	BitstreamLoading = 0;
+
+	XPM_REGION_BEGIN(pcap_wait);
+	Status = PcapLoadPartitionWait();
+	XPM_REGION_END(pcap_wait);
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_GENERAL,"BITSTREAM_DOWNLOAD_FAIL\r\n");
+		OutputStatus(BITSTREAM_DOWNLOAD_FAIL);
+		FsblFallback();
+	}
+	BOOT_TIME_MARK(BOOT_STAGE_PCAP, BitstreamPartition);
+
+	Status = FsblHookAfterBitstreamDload();
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_GENERAL,"FSBL_AFTER_BSTREAM_HOOK_FAIL\r\n");
+		OutputStatus(FSBL_AFTER_BSTREAM_HOOK_FAIL);
+		FsblFallback();
+	}
+}
+
+
+/*****************************************************************************/
+/**
+*
+* This function tells whether a load to the given range would overwrite
+* the bitstream that is loading. It also lets PCAP note the time the
+* bitstream finished for PcapReportOverlap.
+*
+* @param	Addr Start of the range
+* @param	Length Length of the range in bytes
+*
+* @return	1 if the range overlaps the staged bitstream, 0 otherwise
+*
+* @note		None
+*
+****************************************************************************/
+static u32 BitstreamOverlap(u32 Addr, u32 Length)
+{
+	(void)PcapLoadPartitionPending();
+
+	if ((Addr < (BitstreamAddr + BitstreamLength)) &&
+			(BitstreamAddr < (Addr + Length))) {
+		return 1;
+	}
+
+	return 0;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -936,6 +1200,16 @@ u32 ValidateHeader(PartHeader *Header)
 		return XST_FAILURE;
 	}
 
+	/*
+	 * Compressed partitions hold plain LZ4 frames; encrypted data does
+	 * not compress, so an encrypted one is not accepted
+	 */
+	if ((Header->PartitionAttr & ATTRIBUTE_COMPRESSED_MASK) &&
+			(Header->ImageWordLen != Header->DataWordLen)) {
+		fsbl_printf(DEBUG_GENERAL, "INVALID_COMPRESSED_PARTITION\r\n");
+		return XST_FAILURE;
+	}
+
 	return XST_SUCCESS;
 }
 
@@ -1040,6 +1314,7 @@ u32 PartitionMove(u32 ImageBaseAddress, PartHeader *Header)
     u32 LoadAddr;
     u32 ImageWordLen;
     u32 DataWordLen;
+    u8 PcapStreamed = 0;
 
 	SourceAddr = ImageBaseAddress;
 	SourceAddr += Header->PartitionStart<<WORD_LENGTH_SHIFT;
@@ -1047,6 +1322,36 @@ u32 PartitionMove(u32 ImageBaseAddress, PartHeader *Header)
 	ImageWordLen = Header->ImageWordLen;
 	DataWordLen = Header->DataWordLen;
 
+	/*
+	 * Compressed partitions are decompressed as they are read, except
+	 * checked ones: those are staged as stored for the checksum and
+	 * authentication, and LoadBootImage decompresses them afterwards
+	 */
+	if (CompressedPartitionFlag) {
+		if (!(SignedPartitionFlag || PartitionChecksumFlag)) {
+			return DecompressPartition(SourceAddr,
+					(ImageWordLen << WORD_LENGTH_SHIFT), LoadAddr, 0);
+		}
+
+		LoadAddr = CompressedStageAddr(Header->PartitionWordLen <<
+						WORD_LENGTH_SHIFT);
+		if (LoadAddr == 0) {
+			fsbl_printf(DEBUG_GENERAL, "Compressed partition too large\r\n");
+			return XST_FAILURE;
+		}
+
+		if (!LinearBootDeviceFlag) {
+			return PipelinedMove(SourceAddr, LoadAddr,
+					(Header->PartitionWordLen << WORD_LENGTH_SHIFT), 0);
+		}
+
+		return PcapDataTransfer((u32*)(SourceAddr + FlashReadBaseAddress),
+					(u32*)LoadAddr,
+					Header->PartitionWordLen,
+					Header->PartitionWordLen,
+					0);
+	}
+
 	/*
 	 * Add flash base address for linear boot devices
 	 */
@@ -1086,15 +1391,29 @@ u32 PartitionMove(u32 ImageBaseAddress, PartHeader *Header)
 	 */
 	if (!LinearBootDeviceFlag) {
 		/*
-		 * PL partition copied to DDR temporary location
+		 * PL partition copied to DDR temporary location; a checked one
+		 * is staged where it can stay while PCAP loads it
 		 */
 		if (PLPartitionFlag) {
 			LoadAddr = DDR_TEMP_START_ADDR;
+			if (SignedPartitionFlag || PartitionChecksumFlag) {
+				LoadAddr = BitstreamStageAddr(ImageWordLen <<
+								WORD_LENGTH_SHIFT);
+			}
 		}
 
-		Status = MoveImage(SourceAddr,
+		/*
+		 * Bitstreams that are not checked first go to PCAP as they
+		 * are read; encrypted ones keep the single secure transfer
+		 */
+		PcapStreamed = PLPartitionFlag &&
+				(!(SignedPartitionFlag || PartitionChecksumFlag)) &&
+				(!EncryptedPartitionFlag);
+
+		Status = PipelinedMove(SourceAddr,
 						LoadAddr,
-						(ImageWordLen << WORD_LENGTH_SHIFT));
+						(ImageWordLen << WORD_LENGTH_SHIFT),
+						PcapStreamed);
 		if(Status != XST_SUCCESS) {
 			fsbl_printf(DEBUG_GENERAL, "Move Image Failed\r\n");
 			return XST_FAILURE;
@@ -1116,17 +1435,26 @@ u32 PartitionMove(u32 ImageBaseAddress, PartHeader *Header)
 		 */
 		if(PLPartitionFlag){
 			SecureTransferFlag = 0;
-			LoadAddr = DDR_TEMP_START_ADDR;
+			LoadAddr = BitstreamStageAddr(ImageWordLen << WORD_LENGTH_SHIFT);
 		}
 
-		/*
-		 * Data transfer using PCAP
-		 */
-		Status = PcapDataTransfer((u32*)SourceAddr,
+		if (BitstreamLoading) {
+			/*
+			 * PCAP is busy with a bitstream; plain PS partitions are
+			 * copied with the boot device routine instead
+			 */
+			Status = MoveImage(SourceAddr - FlashReadBaseAddress, LoadAddr,
+						ImageWordLen << WORD_LENGTH_SHIFT);
+		} else {
+			/*
+			 * Data transfer using PCAP
+			 */
+			Status = PcapDataTransfer((u32*)SourceAddr,
 						(u32*)LoadAddr,
 						ImageWordLen,
 						DataWordLen,
 						SecureTransferFlag);
+		}
 		if(Status != XST_SUCCESS) {
 			fsbl_printf(DEBUG_GENERAL, "PCAP Data Transfer Failed\r\n");
 			return XST_FAILURE;
@@ -1142,12 +1470,15 @@ u32 PartitionMove(u32 ImageBaseAddress, PartHeader *Header)
 	 * Load Bitstream partition in to fabric only
 	 * if checksum and authentication bits are not set
 	 */
-	if (PLPartitionFlag && (!(SignedPartitionFlag || PartitionChecksumFlag))) {
+	if (PLPartitionFlag && (!(SignedPartitionFlag || PartitionChecksumFlag)) &&
+			(!PcapStreamed)) {
+		XPM_REGION_BEGIN(pcap_load);
 		Status = PcapLoadPartition((u32*)SourceAddr,
 					(u32*)Header->LoadAddr,
 					Header->ImageWordLen,
 					Header->DataWordLen,
 					EncryptedPartitionFlag);
+		XPM_REGION_END(pcap_load);
 		if(Status != XST_SUCCESS) {
 			fsbl_printf(DEBUG_GENERAL, "PCAP Bitstream Download Failed\r\n");
 			return XST_FAILURE;
@@ -1158,6 +1489,558 @@ u32 PartitionMove(u32 ImageBaseAddress, PartHeader *Header)
 }
 
 
+/******************************************************************************/
+/**
+*
+* This function moves a partition from a non-linear boot device in
+* PIPE_CHUNK_SIZE pieces.
+*
+* A checksummed partition is hashed chunk by chunk as it arrives, either
+* by the device copy routine (QSPI) or straight after the chunk is read
+* while it is still in the cache, and the digest is kept for
+* CalcPartitionChecksum. A signed partition is likewise run through
+* SHA-256 up to its partition signature, so authentication does not read
+* it again. A bitstream with ToPcap set is read into two
+* alternating buffers at LoadAddr and each chunk is queued to PCAP as soon
+* as it is in memory, so the next chunk is read while the last one is
+* configured; the fabric is done when this returns.
+*
+* The data cache is on for the duration, as for authentication.
+*
+* @param	SourceAddr Partition offset on the boot device
+* @param	LoadAddr Destination, or the staging buffers with ToPcap
+* @param	Length Partition length in bytes
+* @param	ToPcap Stream the partition to PCAP
+*
+* @return
+*		- XST_SUCCESS if the partition was moved
+*		- XST_FAILURE otherwise
+*
+* @note		Stage times are left in PipelineStats
+*
+*******************************************************************************/
+u32 PipelinedMove(u32 SourceAddr, u32 LoadAddr, u32 Length, u8 ToPcap)
+{
+	u32 Status = XST_SUCCESS;
+	u32 Offset;
+	u32 Chunk;
+	u32 Buffer;
+	u32 Hashed = 0;
+	MD5Context Context;
+#ifdef RSA_SUPPORT
+	Sha256Context HashContext;
+	u32 HashLength = 0;
+#endif
+	XTime tStart;
+	XTime tStage;
+	XTime tNow;
+
+	PipelineStats.Chunks = 0;
+	PipelineStats.Bytes = 0;
+	PipelineStats.Read = 0;
+	PipelineStats.Hash = 0;
+	PipelineStats.PcapWait = 0;
+	MovedChecksumLength = 0;
+#ifdef RSA_SUPPORT
+	MovedHashLength = 0;
+#endif
+
+	XTime_GetTime(&tStart);
+
+	Xil_DCacheEnable();
+
+	if (ToPcap) {
+		Status = PcapStreamBegin();
+		if (Status != XST_SUCCESS) {
+			goto Done;
+		}
+	}
+
+	if (PartitionChecksumFlag) {
+		MD5Init(&Context);
+	}
+
+#ifdef RSA_SUPPORT
+	/*
+	 * The partition hash covers all but the partition signature
+	 */
+	if (SignedPartitionFlag && (Length >= RSA_PARTITION_SIGNATURE_SIZE)) {
+		HashLength = Length - RSA_PARTITION_SIGNATURE_SIZE;
+		Sha256Init(&HashContext);
+	}
+#endif
+
+	for (Offset = 0; Offset < Length; Offset += Chunk) {
+		Chunk = Length - Offset;
+		if (Chunk > PIPE_CHUNK_SIZE) {
+			Chunk = PIPE_CHUNK_SIZE;
+		}
+
+		if (ToPcap) {
+			Buffer = LoadAddr + (PipelineStats.Chunks & 1) * PIPE_CHUNK_SIZE;
+		} else {
+			Buffer = LoadAddr + Offset;
+		}
+
+#ifdef	XPAR_XWDTPS_0_BASEADDR
+		/*
+		 * Prevent WDT reset
+		 */
+		XWdtPs_RestartWdt(&Watchdog);
+#endif
+
+		/*
+		 * Read the chunk; QSPI hashes it while copying
+		 */
+		if (PartitionChecksumFlag) {
+			Hashed = Context.bits[0];
+			MoveChecksumContext = &Context;
+		}
+		XTime_GetTime(&tStage);
+		Status = MoveImage(SourceAddr + Offset, Buffer, Chunk);
+		MoveChecksumContext = NULL;
+		XTime_GetTime(&tNow);
+		PipelineStats.Read += tNow - tStage;
+		if (Status != XST_SUCCESS) {
+			goto Done;
+		}
+
+		/*
+		 * Hash it here if the device did not
+		 */
+		if (PartitionChecksumFlag && (Context.bits[0] == Hashed)) {
+			tStage = tNow;
+			MD5Update(&Context, (u8 *)Buffer, Chunk, 0);
+			XTime_GetTime(&tNow);
+			PipelineStats.Hash += tNow - tStage;
+		}
+
+#ifdef RSA_SUPPORT
+		if (Offset < HashLength) {
+			tStage = tNow;
+			Sha256Update(&HashContext, (u8 *)Buffer,
+					(Chunk < (HashLength - Offset)) ?
+					Chunk : (HashLength - Offset));
+			XTime_GetTime(&tNow);
+			PipelineStats.Hash += tNow - tStage;
+		}
+#endif
+
+		/*
+		 * Hand it to PCAP; this waits for the previous chunk, which
+		 * frees the buffer the next chunk is read into
+		 */
+		if (ToPcap) {
+			tStage = tNow;
+			Status = PcapStreamWrite((u32 *)Buffer,
+					Chunk >> WORD_LENGTH_SHIFT,
+					(Offset + Chunk) == Length);
+			XTime_GetTime(&tNow);
+			PipelineStats.PcapWait += tNow - tStage;
+			if (Status != XST_SUCCESS) {
+				goto Done;
+			}
+		}
+
+		PipelineStats.Chunks++;
+		PipelineStats.Bytes += Chunk;
+	}
+
+	if (ToPcap) {
+		XTime_GetTime(&tStage);
+		Status = PcapStreamEnd();
+		XTime_GetTime(&tNow);
+		PipelineStats.PcapWait += tNow - tStage;
+		if (Status != XST_SUCCESS) {
+			goto Done;
+		}
+	}
+
+	/*
+	 * Keep the digest if every byte went into it
+	 */
+	if (PartitionChecksumFlag && (Context.bits[1] == 0) &&
+			((Context.bits[0] >> 3) == Length)) {
+		MD5Final(&Context, MovedChecksum, 0);
+		MovedChecksumAddr = LoadAddr;
+		MovedChecksumLength = Length;
+	}
+
+#ifdef RSA_SUPPORT
+	if (HashLength != 0) {
+		Sha256Final(&HashContext, MovedHash);
+		MovedHashAddr = LoadAddr;
+		MovedHashLength = Length;
+	}
+#endif
+
+Done:
+	MoveChecksumContext = NULL;
+	Xil_DCacheFlush();
+	Xil_DCacheDisable();
+
+	XTime_GetTime(&tNow);
+	PipelineStats.Total = tNow - tStart;
+
+	fsbl_printf(DEBUG_INFO, "Pipelined load: %lu chunks %lu bytes "
+			"read %lu us hash %lu us pcap wait %lu us total %lu us\r\n",
+			PipelineStats.Chunks, PipelineStats.Bytes,
+			PIPE_US(PipelineStats.Read), PIPE_US(PipelineStats.Hash),
+			PIPE_US(PipelineStats.PcapWait), PIPE_US(PipelineStats.Total));
+
+	return Status;
+}
+
+#ifdef RSA_SUPPORT
+/******************************************************************************/
+/**
+*
+* This function hands over the partition hash PipelinedMove computed, if it
+* is for the partition being authenticated
+*
+* @param	Addr Where the partition is in DDR
+* @param	Length Partition length in bytes, certificate included
+*
+* @return	The hash, or NULL if the partition must be hashed again
+*
+* @note		The hash is given out once
+*
+*******************************************************************************/
+static const u8 *TakeMovedHash(u32 Addr, u32 Length)
+{
+	u32 Matches;
+
+	Matches = (MovedHashLength != 0) && (MovedHashAddr == Addr) &&
+			(MovedHashLength == Length);
+	MovedHashLength = 0;
+
+	return Matches ? MovedHash : NULL;
+}
+#endif
+
+
+/******************************************************************************/
+/**
+*
+* This function decompresses an LZ4 compressed partition.
+*
+* The frame is decoded a block at a time. A PS partition is decoded
+* straight to its load address. A bitstream is decoded into two
+* alternating block buffers at DDR_TEMP_START_ADDR and each block is
+* queued to PCAP as soon as it is decoded, so the next block is read and
+* decoded while the last one is configured; the fabric is done when this
+* returns.
+*
+* Without FromMemory each block is read from the boot device just before
+* it is decoded, with the size word of the block after it; with FromMemory
+* the frame has already been staged and checked at SourceAddr.
+*
+* The data cache is on for the duration, as for authentication.
+*
+* @param	SourceAddr Partition offset on the boot device, or its address
+*			in memory with FromMemory
+* @param	Length Compressed length in bytes
+* @param	LoadAddr Destination of a PS partition
+* @param	FromMemory The compressed partition is at SourceAddr in memory
+*
+* @return
+*		- XST_SUCCESS if the partition was decompressed
+*		- XST_FAILURE if it could not be read, is not a frame this can
+*		  decode, is corrupt or would not fit
+*
+* @note		Bitstream frames must have independent blocks and a whole
+*			number of words
+*
+*******************************************************************************/
+u32 DecompressPartition(u32 SourceAddr, u32 Length, u32 LoadAddr,
+		u8 FromMemory)
+{
+	u32 Status;
+	Lz4FrameInfo Frame;
+	const u8 *Block;
+	u32 Offset;
+	u32 BlockWord;
+	u32 BlockLength;
+	u32 BlockTail;
+	u32 Room;
+	u32 Limit;
+	u32 Produced;
+	u32 Decoded = 0;
+	u32 Blocks = 0;
+	u8 *Out;
+	u8 *Base;
+	u8 ToPcap = PLPartitionFlag;
+	XTime tStart;
+	XTime tStage;
+	XTime tNow;
+	XTime tRead = 0;
+	XTime tDecode = 0;
+	XTime tPcap = 0;
+
+	XTime_GetTime(&tStart);
+
+	Xil_DCacheEnable();
+
+	/*
+	 * Frame header and the first block size
+	 */
+	Status = XST_FAILURE;
+	if (Length < (LZ4_FRAME_HEADER_SIZE + 4)) {
+		goto Done;
+	}
+	XTime_GetTime(&tStage);
+	Status = CompressedFetch(SourceAddr, 0, LZ4_FRAME_HEADER_SIZE + 4,
+			FromMemory, &Block);
+	XTime_GetTime(&tNow);
+	tRead += tNow - tStage;
+	if (Status != XST_SUCCESS) {
+		goto Done;
+	}
+
+	Status = XST_FAILURE;
+	if ((Lz4ParseFrame(Block, LZ4_FRAME_HEADER_SIZE, &Frame) != XST_SUCCESS) ||
+			(Frame.BlockMax > LZ4_MAX_BLOCK_SIZE) ||
+			(Frame.ContentSize == 0)) {
+		fsbl_printf(DEBUG_GENERAL, "Unsupported LZ4 frame\r\n");
+		goto Done;
+	}
+
+	if (ToPcap) {
+		if ((!Frame.Independent) ||
+				(Frame.ContentSize & ((1 << WORD_LENGTH_SHIFT) - 1))) {
+			fsbl_printf(DEBUG_GENERAL, "Unsupported LZ4 bitstream frame\r\n");
+			goto Done;
+		}
+		Status = PcapStreamBegin();
+		if (Status != XST_SUCCESS) {
+			goto Done;
+		}
+	} else {
+		/*
+		 * The output must stay clear of the compressed data
+		 */
+		Limit = FromMemory ? SourceAddr : LZ4_WINDOW_ADDR;
+		if ((LoadAddr > Limit) || (Frame.ContentSize > (Limit - LoadAddr))) {
+			fsbl_printf(DEBUG_GENERAL, "Decompressed partition too large\r\n");
+			goto Done;
+		}
+	}
+
+	BlockTail = Frame.BlockChecksum ? 4 : 0;
+	BlockWord = Lz4Le32(Block + LZ4_FRAME_HEADER_SIZE);
+	Offset = LZ4_FRAME_HEADER_SIZE + 4;
+
+	while (BlockWord != 0) {
+		BlockLength = BlockWord & LZ4_BLOCK_SIZE_MASK;
+		if ((BlockLength == 0) || (BlockLength > Frame.BlockMax) ||
+				((BlockLength + BlockTail + 4) > (Length - Offset))) {
+			goto Corrupt;
+		}
+
+#ifdef	XPAR_XWDTPS_0_BASEADDR
+		/*
+		 * Prevent WDT reset
+		 */
+		XWdtPs_RestartWdt(&Watchdog);
+#endif
+
+		/*
+		 * The block, its checksum and the next size word
+		 */
+		XTime_GetTime(&tStage);
+		Status = CompressedFetch(SourceAddr, Offset,
+				BlockLength + BlockTail + 4, FromMemory, &Block);
+		XTime_GetTime(&tNow);
+		tRead += tNow - tStage;
+		if (Status != XST_SUCCESS) {
+			goto Done;
+		}
+		tStage = tNow;
+
+		if (ToPcap) {
+			Out = (u8 *)(DDR_TEMP_START_ADDR +
+					((Blocks & 1) * LZ4_MAX_BLOCK_SIZE));
+			Base = Out;
+		} else {
+			Out = (u8 *)(LoadAddr + Decoded);
+			Base = Frame.Independent ? Out : (u8 *)LoadAddr;
+		}
+		Room = Frame.ContentSize - Decoded;
+		if (Room > Frame.BlockMax) {
+			Room = Frame.BlockMax;
+		}
+
+		if (BlockWord & LZ4_BLOCK_UNCOMPRESSED) {
+			if (BlockLength > Room) {
+				goto Corrupt;
+			}
+			memcpy(Out, Block, BlockLength);
+			Produced = BlockLength;
+		} else if (Lz4DecodeBlock(Block, BlockLength, Out, Room, Base,
+				&Produced) != XST_SUCCESS) {
+			goto Corrupt;
+		}
+		XTime_GetTime(&tNow);
+		tDecode += tNow - tStage;
+
+		if (Produced == 0) {
+			goto Corrupt;
+		}
+		Decoded += Produced;
+
+		/*
+		 * Hand it to PCAP; this waits for the previous block, which
+		 * frees the buffer the next block is decoded into
+		 */
+		if (ToPcap) {
+			if (Produced & ((1 << WORD_LENGTH_SHIFT) - 1)) {
+				goto Corrupt;
+			}
+			tStage = tNow;
+			Status = PcapStreamWrite((u32 *)Out,
+					Produced >> WORD_LENGTH_SHIFT,
+					Decoded == Frame.ContentSize);
+			XTime_GetTime(&tNow);
+			tPcap += tNow - tStage;
+			if (Status != XST_SUCCESS) {
+				goto Done;
+			}
+		}
+
+		BlockWord = Lz4Le32(Block + BlockLength + BlockTail);
+		Offset += BlockLength + BlockTail + 4;
+		Blocks++;
+	}
+
+	if (Decoded != Frame.ContentSize) {
+		goto Corrupt;
+	}
+
+	if (ToPcap) {
+		XTime_GetTime(&tStage);
+		Status = PcapStreamEnd();
+		XTime_GetTime(&tNow);
+		tPcap += tNow - tStage;
+		if (Status != XST_SUCCESS) {
+			goto Done;
+		}
+	}
+
+	Status = XST_SUCCESS;
+	goto Done;
+
+Corrupt:
+	fsbl_printf(DEBUG_GENERAL, "Corrupt LZ4 block %lu\r\n", Blocks);
+	Status = XST_FAILURE;
+
+Done:
+	Xil_DCacheFlush();
+	Xil_DCacheDisable();
+
+	XTime_GetTime(&tNow);
+
+	fsbl_printf(DEBUG_INFO, "LZ4 load: %lu blocks %lu -> %lu bytes "
+			"read %lu us decode %lu us pcap wait %lu us total %lu us\r\n",
+			Blocks, Length, Decoded, PIPE_US(tRead), PIPE_US(tDecode),
+			PIPE_US(tPcap), PIPE_US(tNow - tStart));
+
+	return Status;
+}
+
+
+/******************************************************************************/
+/**
+*
+* This function gives the address a checked compressed partition is staged
+* at: as high in DDR as it fits, clear of the PCAP block buffers
+*
+* @param	Length Partition length in bytes
+*
+* @return	Staging address, or 0 if the partition does not fit
+*
+* @note		None
+*
+*******************************************************************************/
+static u32 CompressedStageAddr(u32 Length)
+{
+	u32 Room;
+
+	Room = (DDR_END_ADDR + 1) - (DDR_TEMP_START_ADDR + LZ4_PCAP_BUFFERS_SIZE);
+	if ((Length + LZ4_FETCH_ALIGN) > Room) {
+		return 0;
+	}
+
+	return ((DDR_END_ADDR + 1) - Length) & ~(LZ4_FETCH_ALIGN - 1);
+}
+
+
+/******************************************************************************/
+/**
+*
+* This function gives the address a checked bitstream is staged at for
+* its checksum, authentication and PCAP load: as high in DDR as it fits
+* below the compressed partition window, so PS partitions loaded at the
+* bottom of DDR can be moved while PCAP reads it
+*
+* @param	Length Partition length in bytes
+*
+* @return	Staging address; DDR_TEMP_START_ADDR if it does not fit or
+*			with FSBL_NO_CONCURRENT_PCAP
+*
+* @note		None
+*
+*******************************************************************************/
+static u32 BitstreamStageAddr(u32 Length)
+{
+#ifndef FSBL_NO_CONCURRENT_PCAP
+	if ((Length + LZ4_FETCH_ALIGN) < (LZ4_WINDOW_ADDR - DDR_TEMP_START_ADDR)) {
+		return (LZ4_WINDOW_ADDR - Length) & ~(LZ4_FETCH_ALIGN - 1);
+	}
+#endif
+
+	return DDR_TEMP_START_ADDR;
+}
+
+
+/******************************************************************************/
+/**
+*
+* This function makes part of a compressed partition addressable: in
+* place when the partition is in memory, otherwise by reading it from the
+* preceding LZ4_FETCH_ALIGN boundary into the window at LZ4_WINDOW_ADDR
+*
+* @param	SourceAddr Partition offset on the boot device, or its address
+* @param	Offset Offset into the partition
+* @param	Length Bytes needed, at most LZ4_MAX_BLOCK_SIZE + 8
+* @param	FromMemory The partition is at SourceAddr in memory
+* @param	Data Set to the bytes at Offset
+*
+* @return
+*		- XST_SUCCESS if the bytes are available
+*		- XST_FAILURE if the read failed
+*
+* @note		None
+*
+*******************************************************************************/
+static u32 CompressedFetch(u32 SourceAddr, u32 Offset, u32 Length,
+		u8 FromMemory, const u8 **Data)
+{
+	u32 Start;
+	u32 Skip;
+
+	if (FromMemory) {
+		*Data = (const u8 *)(SourceAddr + Offset);
+		return XST_SUCCESS;
+	}
+
+	Start = (SourceAddr + Offset) & ~(LZ4_FETCH_ALIGN - 1);
+	Skip = (SourceAddr + Offset) - Start;
+	*Data = (const u8 *)(LZ4_WINDOW_ADDR + Skip);
+
+	return MoveImage(Start, LZ4_WINDOW_ADDR, Skip + Length);
+}
+
+
 /******************************************************************************/
 /**
 *
@@ -1316,6 +2199,21 @@ u32 GetPartitionChecksum(u32 ChecksumOffset, u8 *Checksum)
 *******************************************************************************/
 u32 CalcPartitionChecksum(u32 SourceAddr, u32 DataLength, u8 *Checksum)
 {
+	u32 Index;
+
+	/*
+	 * Use the digest taken while the partition was copied, if it covers
+	 * exactly this data
+	 */
+	if ((MovedChecksumLength != 0) && (MovedChecksumAddr == SourceAddr) &&
+			(MovedChecksumLength == DataLength)) {
+		for (Index = 0; Index < MD5_CHECKSUM_SIZE; Index++) {
+			Checksum[Index] = MovedChecksum[Index];
+		}
+		MovedChecksumLength = 0;
+		return XST_SUCCESS;
+	}
+
 	/*
 	 * Calculate checksum using MD5 algorithm
 	 */
@@ -20,6 +20,9 @@
 * 2.00a jz	06/04/11	partition header expands to 12 words
 * 5.00a kc	07/30/13	Added defines for image header information
 * 8.00a kc	01/16/13	Added defines for partition owner attribute
+* 13.00a jmm	10/19/26	Export the copy-time checksum context
+* 14.00a jmm	10/19/26	Added the pipelined load stage times
+* 15.00a jmm	10/19/26	Added the compressed partition attribute
 * </pre>
 *
 * @note
@@ -35,6 +38,8 @@ extern "C" {
 
 /***************************** Include Files *********************************/
 #include "fsbl.h"
+#include "md5.h"
+#include "xtime_l.h"
 
 /************************** Constant Definitions *****************************/
 #define PARTITION_NUMBER_SHIFT	24
@@ -73,6 +78,7 @@ extern "C" {
 #define ATTRIBUTE_PARTITION_OWNER_MASK	0x30000	/* Partition Owner */
 
 #define ATTRIBUTE_PARTITION_OWNER_FSBL	0x00000	/* FSBL Partition Owner */
+#define ATTRIBUTE_COMPRESSED_MASK		0x40000	/* LZ4 frame, see lz4.h */
 
 
 /**************************** Type Definitions *******************************/
@@ -101,6 +107,19 @@ struct HeaderArray {
 };
 
 
+/*
+ * Stage times of a pipelined partition load, in global timer counts;
+ * the stages overlap, so they need not add up to Total
+ */
+typedef struct {
+	u32 Chunks;
+	u32 Bytes;
+	XTime Read;			/* boot device to memory */
+	XTime Hash;			/* checksum of chunks the device did not hash */
+	XTime PcapWait;		/* waiting for PCAP to take the previous chunk */
+	XTime Total;
+} PipeStats;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 #define MoverIn32		Xil_In32
 #define MoverOut32		Xil_Out32
@@ -122,6 +141,8 @@ u32 ValidateHeader(PartHeader *Header);
 u32 DecryptPartition(u32 StartAddr, u32 DataLength, u32 ImageLength);
 
 /************************** Variable Definitions *****************************/
+extern MD5Context *MoveChecksumContext;
+extern PipeStats PipelineStats;
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,278 @@
+/******************************************************************************
+* Copyright (c) 2026 Joshua M. Meise
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file lz4.c
+*
+* Contains the LZ4 frame header parser and block decoder used for
+* compressed partitions.
+*
+* The decoder checks every length and offset against the input and output
+* it was given, so a corrupt block fails instead of writing outside the
+* partition. The header checksum and the optional xxHash block and content
+* checksums are not checked; the partition MD5 or RSA signature covers the
+* compressed bytes.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a jmm	10/19/26	Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <string.h>
+#include "lz4.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+
+#define LZ4_MIN_MATCH		4U
+#define LZ4_RUN_MASK		0xFU
+#define LZ4_MAX_LENGTH		0x7FFFFFFFU
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static u32 Lz4ReadLength(const u8 **Ip, const u8 *IpEnd, u32 *Length);
+static void Lz4CopyMatch(u8 *Op, const u8 *Match, u32 Length, u32 Offset);
+
+/************************** Variable Definitions *****************************/
+
+/******************************************************************************/
+/**
+*
+* This function reads the frame header of a compressed partition
+*
+* @param	Src is the start of the frame
+* @param	Length is the number of bytes available at Src
+* @param	Info is filled in from the frame descriptor
+*
+* @return
+*		- XST_SUCCESS if the frame can be decoded
+*		- XST_FAILURE for a bad magic, an unknown version, a dictionary,
+*		  a missing or too large content size or an unknown block size
+*
+* @note		The frame header is LZ4_FRAME_HEADER_SIZE bytes
+*
+****************************************************************************/
+u32 Lz4ParseFrame(const u8 *Src, u32 Length, Lz4FrameInfo *Info)
+{
+	u32 Flg;
+	u32 Bd;
+
+	if (Length < LZ4_FRAME_HEADER_SIZE) {
+		return XST_FAILURE;
+	}
+
+	if (Lz4Le32(Src) != LZ4_FRAME_MAGIC) {
+		return XST_FAILURE;
+	}
+
+	Flg = Src[4];
+	Bd = Src[5];
+
+	if (((Flg & LZ4_FLG_VERSION_MASK) != LZ4_FLG_VERSION) ||
+			(Flg & (LZ4_FLG_RESERVED | LZ4_FLG_DICT_ID)) ||
+			(!(Flg & LZ4_FLG_CONTENT_SIZE)) ||
+			(Bd & LZ4_BD_RESERVED)) {
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Block maximum size codes 4 to 7 are 64 KB, 256 KB, 1 MB and 4 MB
+	 */
+	Bd = (Bd & LZ4_BD_MAX_SIZE_MASK) >> LZ4_BD_MAX_SIZE_SHIFT;
+	if (Bd < 4) {
+		return XST_FAILURE;
+	}
+	Info->BlockMax = 1U << (8 + (2 * Bd));
+
+	/*
+	 * 64-bit content size; partitions are limited to 32 bits
+	 */
+	if (Lz4Le32(&Src[10]) != 0) {
+		return XST_FAILURE;
+	}
+	Info->ContentSize = Lz4Le32(&Src[6]);
+
+	Info->Independent = (Flg & LZ4_FLG_BLOCK_INDEP) ? 1 : 0;
+	Info->BlockChecksum = (Flg & LZ4_FLG_BLOCK_CHECKSUM) ? 1 : 0;
+	Info->ContentChecksum = (Flg & LZ4_FLG_CONTENT_CHECKSUM) ? 1 : 0;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function decodes one compressed block
+*
+* @param	Src is the compressed block
+* @param	SrcLength is the compressed block length in bytes
+* @param	Dst is where the decoded block goes
+* @param	DstLength is the room at Dst in bytes
+* @param	DstBase is the lowest address a match may copy from: Dst for an
+*			independent block, or the start of the output when the
+*			earlier blocks are in place before Dst
+* @param	Produced is set to the decoded length in bytes
+*
+* @return
+*		- XST_SUCCESS if the block decoded
+*		- XST_FAILURE if it is truncated, would overrun Dst or refers to
+*		  data before DstBase
+*
+* @note		None
+*
+****************************************************************************/
+u32 Lz4DecodeBlock(const u8 *Src, u32 SrcLength, u8 *Dst, u32 DstLength,
+		const u8 *DstBase, u32 *Produced)
+{
+	const u8 *Ip = Src;
+	const u8 *IpEnd = Src + SrcLength;
+	u8 *Op = Dst;
+	u8 *OpEnd = Dst + DstLength;
+	u32 Token;
+	u32 Length;
+	u32 Offset;
+
+	*Produced = 0;
+
+	while (Ip < IpEnd) {
+		Token = *Ip++;
+
+		/*
+		 * Literals
+		 */
+		Length = Token >> 4;
+		if (Length == LZ4_RUN_MASK) {
+			if (Lz4ReadLength(&Ip, IpEnd, &Length) != XST_SUCCESS) {
+				return XST_FAILURE;
+			}
+		}
+		if ((Length > (u32)(IpEnd - Ip)) || (Length > (u32)(OpEnd - Op))) {
+			return XST_FAILURE;
+		}
+		memcpy(Op, Ip, Length);
+		Op += Length;
+		Ip += Length;
+
+		/*
+		 * The last sequence of a block has no match
+		 */
+		if (Ip == IpEnd) {
+			*Produced = (u32)(Op - Dst);
+			return XST_SUCCESS;
+		}
+
+		/*
+		 * Match
+		 */
+		if ((IpEnd - Ip) < 2) {
+			return XST_FAILURE;
+		}
+		Offset = (u32)Ip[0] | ((u32)Ip[1] << 8);
+		Ip += 2;
+		if ((Offset == 0) || (Offset > (u32)(Op - DstBase))) {
+			return XST_FAILURE;
+		}
+
+		Length = Token & LZ4_RUN_MASK;
+		if (Length == LZ4_RUN_MASK) {
+			if (Lz4ReadLength(&Ip, IpEnd, &Length) != XST_SUCCESS) {
+				return XST_FAILURE;
+			}
+		}
+		Length += LZ4_MIN_MATCH;
+		if (Length > (u32)(OpEnd - Op)) {
+			return XST_FAILURE;
+		}
+		Lz4CopyMatch(Op, Op - Offset, Length, Offset);
+		Op += Length;
+	}
+
+	/*
+	 * Empty, or ended on a match
+	 */
+	return XST_FAILURE;
+}
+
+/******************************************************************************/
+/**
+*
+* This function adds the extra length bytes of a literal run or match
+*
+* @param	Ip points to the first extra byte and is moved past the last
+* @param	IpEnd is the end of the block
+* @param	Length holds the length from the token and gets the extra bytes
+*
+* @return	XST_SUCCESS, or XST_FAILURE if the block ends first
+*
+* @note		None
+*
+****************************************************************************/
+static u32 Lz4ReadLength(const u8 **Ip, const u8 *IpEnd, u32 *Length)
+{
+	const u8 *p = *Ip;
+	u32 Byte;
+
+	do {
+		if ((p >= IpEnd) || (*Length > LZ4_MAX_LENGTH)) {
+			return XST_FAILURE;
+		}
+		Byte = *p++;
+		*Length += Byte;
+	} while (Byte == 0xFF);
+
+	*Ip = p;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function copies a match. Matches further back than a double word
+* do not overlap their own output within one double word, so they are
+* copied eight bytes at a time; nearer ones repeat a short pattern and are
+* copied a byte at a time.
+*
+* @param	Op is the output position
+* @param	Match is the start of the earlier copy
+* @param	Length is the match length in bytes
+* @param	Offset is Op - Match
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void Lz4CopyMatch(u8 *Op, const u8 *Match, u32 Length, u32 Offset)
+{
+	if (Offset >= 8) {
+		while (Length >= 8) {
+			memcpy(Op, Match, 8);
+			Op += 8;
+			Match += 8;
+			Length -= 8;
+		}
+	}
+
+	while (Length > 0) {
+		*Op++ = *Match++;
+		Length--;
+	}
+}
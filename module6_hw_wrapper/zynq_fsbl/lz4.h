@@ -0,0 +1,96 @@
+/******************************************************************************
+* Copyright (c) 2026 Joshua M. Meise
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file lz4.h
+*
+* Contains the frame layout and the prototypes required by lz4.c
+*
+* A compressed partition holds one LZ4 frame (lz4 frame format 1.6) with
+* the content size present and no dictionary. The frame is decoded one
+* block at a time, so the caller decides where each block comes from and
+* where its output goes.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a jmm	10/19/26	Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#ifndef ___LZ4_H___
+#define ___LZ4_H___
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+
+#define LZ4_FRAME_MAGIC			0x184D2204U
+#define LZ4_FRAME_HEADER_SIZE	15U		/* magic, FLG, BD, size, HC */
+
+/*
+ * Frame descriptor bits
+ */
+#define LZ4_FLG_VERSION_MASK	0xC0U
+#define LZ4_FLG_VERSION			0x40U
+#define LZ4_FLG_BLOCK_INDEP		0x20U
+#define LZ4_FLG_BLOCK_CHECKSUM	0x10U
+#define LZ4_FLG_CONTENT_SIZE	0x08U
+#define LZ4_FLG_CONTENT_CHECKSUM	0x04U
+#define LZ4_FLG_RESERVED		0x02U
+#define LZ4_FLG_DICT_ID			0x01U
+#define LZ4_BD_MAX_SIZE_SHIFT	4U
+#define LZ4_BD_MAX_SIZE_MASK	0x70U
+#define LZ4_BD_RESERVED			0x8FU
+
+/*
+ * Largest block accepted; the 64 KB block size of the frame format
+ */
+#define LZ4_MAX_BLOCK_SIZE		0x10000U
+
+/*
+ * Block size word; a zero word ends the frame
+ */
+#define LZ4_BLOCK_UNCOMPRESSED	0x80000000U
+#define LZ4_BLOCK_SIZE_MASK		0x7FFFFFFFU
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u32 ContentSize;		/* decompressed bytes */
+	u32 BlockMax;			/* largest decompressed block */
+	u8 Independent;			/* blocks never refer to earlier blocks */
+	u8 BlockChecksum;		/* each block is followed by a checksum word */
+	u8 ContentChecksum;		/* the end mark is followed by a checksum word */
+} Lz4FrameInfo;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define Lz4Le32(p)	((u32)(p)[0] | ((u32)(p)[1] << 8) | \
+					((u32)(p)[2] << 16) | ((u32)(p)[3] << 24))
+
+/************************** Function Prototypes ******************************/
+
+u32 Lz4ParseFrame(const u8 *Src, u32 Length, Lz4FrameInfo *Info);
+u32 Lz4DecodeBlock(const u8 *Src, u32 SrcLength, u8 *Dst, u32 DstLength,
+		const u8 *DstBase, u32 *Produced);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ___LZ4_H___ */
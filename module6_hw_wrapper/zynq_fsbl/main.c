@@ -82,6 +82,12 @@
 * 											of failure.
 * 16.00a bsv 03/26/18	Fix for CR# 996973  Add code under JTAG_ENABLE_LEVEL_SHIFTERS macro
 * 											to enable level shifters in jtag boot mode.
+* 17.00a jmm 10/19/26	Profiling region report before handoff (XPM_REGIONS)
+* 18.00a jmm 10/19/26	QSPI read rate report; QSPI bank restored before
+*						handoff and fallback reset
+* 19.00a jmm 10/19/26	Boot stage times recorded in the OCM boot time log
+* 20.00a jmm 10/19/26	SD read rate report
+* 21.00a jmm 10/19/26	PCAP overlap report
 * </pre>
 *
 * @note
@@ -113,6 +119,8 @@
 #include "xstatus.h"
 #include "fsbl_hooks.h"
 #include "xtime_l.h"
+#include "xpm_counter.h"
+#include "boot_time.h"
 
 #ifdef XPAR_XWDTPS_0_BASEADDR
 #include "xwdtps.h"
@@ -232,6 +240,12 @@ int main(void)
 		FsblHookFallback();
 	}
 
+	/*
+	 * Start the boot time log; times count from FSBL entry
+	 */
+	BOOT_TIME_INIT();
+	BOOT_TIME_MARK(BOOT_STAGE_PS7_INIT, BOOT_TIME_NO_PARTITION);
+
 	/*
 	 * Unlock SLCR for SLCR register write
 	 */
@@ -248,6 +262,11 @@ int main(void)
 	FsblGetGlobalTime(&tCur);
 #endif
 
+	/*
+	 * Set up the profiling regions of the load path
+	 */
+	XPM_REGION_INIT();
+
 	/*
 	 * Flush the Caches
 	 */
@@ -287,7 +306,7 @@ int main(void)
 		 */
 		FsblHookFallback();
 	}
-
+	BOOT_TIME_MARK(BOOT_STAGE_DDR_CHECK, BOOT_TIME_NO_PARTITION);
 
 	/*
 	 * PCAP initialization
@@ -304,6 +323,7 @@ int main(void)
 	}
 
 	fsbl_printf(DEBUG_INFO,"Devcfg driver initialized \r\n");
+	BOOT_TIME_MARK(BOOT_STAGE_PCAP_INIT, BOOT_TIME_NO_PARTITION);
 
 	/*
 	 * Get the Silicon Version
@@ -326,6 +346,7 @@ int main(void)
 		FsblFallback();
 	}
 	fsbl_printf(DEBUG_INFO,"Watchdog driver initialized \r\n");
+	BOOT_TIME_MARK(BOOT_STAGE_WDT_INIT, BOOT_TIME_NO_PARTITION);
 #endif
 
 	/*
@@ -507,6 +528,8 @@ int main(void)
 		FsblFallback();
 	}
 
+	BOOT_TIME_MARK(BOOT_STAGE_DEVICE_INIT, BOOT_TIME_NO_PARTITION);
+
 	fsbl_printf(DEBUG_INFO,"Flash Base Address: 0x%08lx\r\n", FlashReadBaseAddress);
 
 	/*
@@ -558,6 +581,30 @@ int main(void)
 	FsblMeasurePerfTime(tCur,tEnd);
 #endif
 
+	/*
+	 * Report the profiling regions of the load path
+	 */
+	XPM_REGION_REPORT();
+
+#ifdef XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR
+	/*
+	 * QSPI read rate for this boot
+	 */
+	QspiReportRate();
+#endif
+
+#if defined(XPAR_PS7_SD_0_S_AXI_BASEADDR) || defined(XPAR_XSDPS_0_BASEADDR)
+	/*
+	 * SD read rate for this boot
+	 */
+	SdReportRate();
+#endif
+
+	/*
+	 * Bitstream load time hidden behind the PS partitions
+	 */
+	PcapReportOverlap();
+
 	/*
 	 * FSBL handoff to valid handoff address or
 	 * exit in JTAG
@@ -685,6 +732,13 @@ void FsblFallback(void)
 		}
 	}
 
+#ifdef XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR
+	/*
+	 * Boot ROM reads the flash from bank 0
+	 */
+	QspiRestoreBank();
+#endif
+
 	/*
 	 * Reset PS, so Boot ROM will restart
 	 */
@@ -708,6 +762,13 @@ void FsblHandoff(u32 FsblStartAddr)
 {
 	u32 Status;
 
+#ifdef XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR
+	/*
+	 * Leave the flash on bank 0 for the next stage
+	 */
+	QspiRestoreBank();
+#endif
+
 	/*
 	 * Enable level shifter
 	 */
@@ -766,6 +827,11 @@ void FsblHandoff(u32 FsblStartAddr)
 	 */
 	ClearFSBLIn();
 
+	/*
+	 * Last boot time point; the log stays in OCM for the application
+	 */
+	BOOT_TIME_MARK(BOOT_STAGE_HANDOFF, BOOT_TIME_NO_PARTITION);
+
 	if(FsblStartAddr == 0) {
 		/*
 		 * SLCR lock
@@ -67,6 +67,8 @@
 * Ver	Who	Date		Changes
 * ----- ---- -------- -------------------------------------------------------
 * 5.00a sgd	05/17/13 Initial release
+* 6.00a jmm	10/19/26 Hash aligned input in place instead of copying each
+*					 block; add MD5CopyUpdate to hash while copying
 *
 *
 * </pre>
@@ -127,6 +129,10 @@ inline void * MD5Memcpy( void *dest, const void *src,
 	register char * src8 = (char*)src;
 	
 	if( doByteSwap == FALSE ) {
+		if( ( ( (UINTPTR)dst8 | (UINTPTR)src8 ) & 3U ) == 0U ) {
+			for( ; count >= 4; count -= 4, dst8 += 4, src8 += 4 )
+				*(u32 *)dst8 = *(const u32 *)src8;
+		}
 		while( count-- )
 			*dst8++ = *src8++;
 	} else {
@@ -173,7 +179,7 @@ inline void * MD5Memcpy( void *dest, const void *src,
 * @note		None
 *
 ****************************************************************************/
-void MD5Transform( u32 *buffer, u32 *intermediate )
+static inline void MD5TransformBlock( u32 *buffer, const u32 *intermediate )
 {
 	register u32 a, b, c, d;
 	
@@ -257,6 +263,117 @@ void MD5Transform( u32 *buffer, u32 *intermediate )
 	
 }
 
+void MD5Transform( u32 *buffer, u32 *intermediate )
+{
+	MD5TransformBlock( buffer, intermediate );
+}
+
+/******************************************************************************/
+/**
+*
+* This function loads a word from any byte address. The A9 runs with
+* alignment checking off, so this compiles to a single unaligned ldr.
+*
+* @param	p
+*
+* @return	The word at p
+*
+* @note		None
+*
+****************************************************************************/
+static inline u32 MD5LoadWord( const u8 *p )
+{
+	u32 w;
+
+	__builtin_memcpy( &w, p, sizeof( w ) );
+
+	return w;
+}
+
+/******************************************************************************/
+/**
+*
+* This function hashes whole 64-byte blocks straight from the caller's
+* buffer. Word-aligned input that needs no byte swap is read in place;
+* otherwise each block is loaded into sixteen words on the stack, which
+* is still far cheaper than the byte-wise MD5Memcpy into the context.
+*
+* @param	buffer is the running hash
+*
+* @param	data is the first block
+*
+* @param	blocks is the number of 64-byte blocks
+*
+* @param	doByteSwap reverses the bytes of every input word
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void MD5Blocks( u32 *buffer, const u8 *data, u32 blocks,
+		boolean doByteSwap )
+{
+	u32 x[ 16 ];
+	const u32 *w;
+	u32 i;
+	u8 aligned = ( ( (UINTPTR)data & 3U ) == 0U );
+
+	while( blocks-- ) {
+		if( aligned && ( doByteSwap == FALSE ) ) {
+			w = (const u32 *)data;
+		} else {
+			for( i = 0; i < 16; i++ ) {
+				if( aligned ) {
+					x[ i ] = ( (const u32 *)data )[ i ];
+				} else {
+					x[ i ] = MD5LoadWord( &data[ 4 * i ] );
+				}
+				if( doByteSwap != FALSE ) {
+					x[ i ] = MD5_SWAP32( x[ i ] );
+				}
+			}
+			w = x;
+		}
+
+		MD5TransformBlock( buffer, w );
+
+		data += MD5_SIGNATURE_BYTE_SIZE;
+	}
+}
+
+/******************************************************************************/
+/**
+*
+* This function adds len bytes to the bit count of the context
+*
+* @param	context
+*
+* @param	len
+*
+* @return	Bytes already buffered in the context before the update
+*
+* @note		None
+*
+****************************************************************************/
+static inline u32 MD5CountBytes( MD5Context *context, u32 len )
+{
+	register u32	temp;
+
+	temp = context->bits[ 0 ];
+
+	if( ( context->bits[ 0 ] = temp + ( (u32)len << 3 ) ) < temp ) {
+		/*
+		 * Carry from low to high
+		 */
+		context->bits[ 1 ]++;
+	}
+
+	context->bits[ 1 ] += len >> 29;
+
+	return ( temp >> 3 ) & 0x3f;
+}
+
 /******************************************************************************/
 /**
 *
@@ -310,25 +427,9 @@ inline void MD5Update( MD5Context *context, u8 *buffer,
 	register u8 *	p;
 	
 	/*
-	 * Update bitcount
-	 */
-
-	temp = context->bits[ 0 ];
-	
-	if( ( context->bits[ 0 ] = temp + ( (u32)len << 3 ) ) < temp ) {
-		/*
-		 * Carry from low to high
-		 */
-		context->bits[ 1 ]++;
-	}
-		
-	context->bits[ 1 ] += len >> 29;
-	
-	/*
-	 * Bytes already in shsInfo->data
+	 * Update bitcount; temp is the bytes already in context->intermediate
 	 */
-	
-	temp = ( temp >> 3 ) & 0x3f;
+	temp = MD5CountBytes( context, len );
 
 	/*
 	 * Handle any leading odd-sized chunks
@@ -354,19 +455,13 @@ inline void MD5Update( MD5Context *context, u8 *buffer,
 	}
 		
 	/*
-	 * Process data in 64-byte, 512 bit, chunks
+	 * Process data in 64-byte, 512 bit, chunks, in place
 	 */
+	MD5Blocks( context->buffer, buffer, len / MD5_SIGNATURE_BYTE_SIZE,
+			doByteSwap );
 
-	while( len >= MD5_SIGNATURE_BYTE_SIZE ) {
-		MD5Memcpy( context->intermediate, buffer, MD5_SIGNATURE_BYTE_SIZE,
-				 doByteSwap );
-		
-		MD5Transform( context->buffer, (u32 *)context->intermediate );
-		
-		buffer += MD5_SIGNATURE_BYTE_SIZE;
-		len    -= MD5_SIGNATURE_BYTE_SIZE;
-		
-	}
+	buffer += len & ~( MD5_SIGNATURE_BYTE_SIZE - 1U );
+	len    &= MD5_SIGNATURE_BYTE_SIZE - 1U;
 
 	/*
 	 * Handle any remaining bytes of data
@@ -375,6 +470,70 @@ inline void MD5Update( MD5Context *context, u8 *buffer,
 	
 }
 
+/******************************************************************************/
+/**
+*
+* This function copies len bytes from src to dest and adds them to the
+* hash in the same pass, so the data is read from memory once. The copy
+* itself is never byte swapped; doByteSwap only applies to the hash, as
+* for MD5Update.
+*
+* Whole blocks are fused when dest is word aligned and nothing is buffered
+* in the context; an unaligned src, such as the QSPI read buffer, is
+* gathered a byte at a time but still stored as words. Anything else is
+* copied first and handed to MD5Update.
+*
+* @param	context
+*
+* @param	dest
+*
+* @param	src
+*
+* @param	len
+*
+* @param	doByteSwap
+*
+* @return	None
+*
+* @note		dest and src must not overlap
+*
+****************************************************************************/
+void MD5CopyUpdate( MD5Context *context, u8 *dest, const u8 *src,
+		u32 len, boolean doByteSwap )
+{
+	u32 x[ 16 ];
+	u32 blocks;
+	u32 i, w;
+	u8 aligned = ( ( (UINTPTR)src & 3U ) == 0U );
+
+	if( ( ( (UINTPTR)dest & 3U ) == 0U ) &&
+			( ( ( context->bits[ 0 ] >> 3 ) & 0x3f ) == 0U ) ) {
+		blocks = len / MD5_SIGNATURE_BYTE_SIZE;
+		(void)MD5CountBytes( context, blocks * MD5_SIGNATURE_BYTE_SIZE );
+
+		while( blocks-- ) {
+			for( i = 0; i < 16; i++ ) {
+				if( aligned ) {
+					w = ( (const u32 *)src )[ i ];
+				} else {
+					w = MD5LoadWord( &src[ 4 * i ] );
+				}
+				( (u32 *)dest )[ i ] = w;
+				x[ i ] = ( doByteSwap != FALSE ) ? MD5_SWAP32( w ) : w;
+			}
+
+			MD5TransformBlock( context->buffer, x );
+
+			src  += MD5_SIGNATURE_BYTE_SIZE;
+			dest += MD5_SIGNATURE_BYTE_SIZE;
+			len  -= MD5_SIGNATURE_BYTE_SIZE;
+		}
+	}
+
+	MD5Memcpy( dest, src, len, FALSE );
+	MD5Update( context, dest, len, doByteSwap );
+}
+
 /******************************************************************************/
 /**
 *
@@ -482,3 +641,36 @@ void md5( u8 *input, u32 len, u8 *digest, boolean doByteSwap )
 	
 	MD5Final( &context, digest, doByteSwap );
 }
+
+/******************************************************************************/
+/**
+*
+* This function copies 'len' bytes from 'src' to 'dest' and stores the MD5
+* digest of them in 'digest' in a single pass over the source
+*
+* @param	dest
+*
+* @param	src
+*
+* @param	len
+*
+* @param	digest must have enough space to hold 16 bytes
+*
+* @param	doByteSwap
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+void md5_copy( u8 *dest, const u8 *src, u32 len, u8 *digest,
+		boolean doByteSwap )
+{
+	MD5Context context;
+
+	MD5Init( &context );
+
+	MD5CopyUpdate( &context, dest, src, len, doByteSwap );
+
+	MD5Final( &context, digest, doByteSwap );
+}
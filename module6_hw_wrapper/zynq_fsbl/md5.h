@@ -15,6 +15,7 @@
 * Ver	Who	Date		Changes
 * ----- ---- -------- -------------------------------------------------------
 * 5.00a sgd	05/17/13 Initial release
+* 6.00a jmm	10/19/26 Add MD5CopyUpdate and md5_copy
 *
 * </pre>
 *
@@ -61,6 +62,13 @@ typedef struct MD5Context MD5Context;
 #define F4( x, y, z ) ( y ^ ( x | ~z ) )
 
 
+/*
+ * Reverse the bytes of a word
+ */
+#define MD5_SWAP32( x ) \
+	( ( (x) << 24 ) | ( ( (x) & 0xff00U ) << 8 ) | \
+	  ( ( (x) >> 8 ) & 0xff00U ) | ( (x) >> 24 ) )
+
 /*
  * This is the central step in the MD5 algorithm
  */
@@ -80,10 +88,16 @@ void MD5Init( MD5Context *context );
 
 void MD5Update( MD5Context *context, u8 *buffer, u32 len, boolean doByteSwap );
 
+void MD5CopyUpdate( MD5Context *context, u8 *dest, const u8 *src, u32 len,
+		boolean doByteSwap );
+
 void MD5Final( MD5Context *context, u8 *digest, boolean doByteSwap );
 
 void md5( u8 *input, u32	len, u8 *digest, boolean doByteSwap );
 
+void md5_copy( u8 *dest, const u8 *src, u32 len, u8 *digest,
+		boolean doByteSwap );
+
 /************************** Variable Definitions *****************************/
 
 #ifdef __cplusplus
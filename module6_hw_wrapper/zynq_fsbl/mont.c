@@ -0,0 +1,221 @@
+/******************************************************************************
+* Copyright (c) 2026 Joshua M. Meise
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file mont.c
+*
+* Contains the RSA-2048 public key operation used for authentication
+*
+* The modular multiply is Montgomery's, with the multiply and the reduction
+* of each digit interleaved in one pass over the digits (FIOS), so the
+* intermediate product is never stored twice as wide. Every step is a
+* 32 x 32 + 32 + 32 bit multiply-accumulate, which fits 64 bits and is a
+* single UMAAL on the Cortex-A9.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a jmm	10/19/26	Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <string.h>
+#include "mont.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static u32 MontInverse(u32 Digit);
+static void MontMul(u32 *Result, const u32 *A, const u32 *B,
+		const u32 *Modulus, u32 NInv);
+
+/************************** Variable Definitions *****************************/
+
+/******************************************************************************/
+/**
+*
+* This function raises a number to a public exponent modulo an odd modulus
+*
+* @param	Result is where Base ^ Exponent mod Modulus goes; it may be
+*			the same array as Base
+* @param	Base is the number, normally a signature
+* @param	Exponent is the public exponent
+* @param	Modulus is the odd modulus
+* @param	RRModN is R * R mod Modulus with R = 2 ^ 2048, the modulus
+*			extension of the certificate
+*
+* @return
+*		- XST_SUCCESS on success
+*		- XST_FAILURE for an even modulus or a zero exponent
+*
+* @note		None
+*
+****************************************************************************/
+u32 MontPubExp(u32 *Result, const u32 *Base, u32 Exponent,
+		const u32 *Modulus, const u32 *RRModN)
+{
+	u32 BaseMont[MONT_DIGITS];
+	u32 One[MONT_DIGITS];
+	u32 NInv;
+	u32 Bit;
+
+	if (((Modulus[0] & 1U) == 0U) || (Exponent == 0U)) {
+		return XST_FAILURE;
+	}
+
+	NInv = MontInverse(Modulus[0]);
+
+	/*
+	 * Base * R mod N
+	 */
+	MontMul(BaseMont, Base, RRModN, Modulus, NInv);
+
+	/*
+	 * Square and multiply from the top bit down; a public exponent
+	 * (65537) has few bits, so no window is used
+	 */
+	Bit = 31U;
+	while ((Exponent & (1U << Bit)) == 0U) {
+		Bit--;
+	}
+	memcpy(Result, BaseMont, sizeof(BaseMont));
+	while (Bit-- > 0U) {
+		MontMul(Result, Result, Result, Modulus, NInv);
+		if ((Exponent & (1U << Bit)) != 0U) {
+			MontMul(Result, Result, BaseMont, Modulus, NInv);
+		}
+	}
+
+	/*
+	 * Out of the Montgomery domain
+	 */
+	memset(One, 0, sizeof(One));
+	One[0] = 1U;
+	MontMul(Result, Result, One, Modulus, NInv);
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function gives -1 / Digit mod 2 ^ 32 for an odd digit
+*
+* @param	Digit is the least significant digit of the modulus
+*
+* @return	The Montgomery constant
+*
+* @note		Each Newton step doubles the correct low bits; the start
+*			value is correct to three
+*
+****************************************************************************/
+static u32 MontInverse(u32 Digit)
+{
+	u32 Inverse = Digit;
+	u32 Step;
+
+	for (Step = 0U; Step < 4U; Step++) {
+		Inverse *= 2U - (Digit * Inverse);
+	}
+
+	return 0U - Inverse;
+}
+
+/******************************************************************************/
+/**
+*
+* This function gives A * B / R mod N, fully reduced
+*
+* @param	Result is where the product goes; it may be A or B
+* @param	A is the first factor
+* @param	B is the second factor
+* @param	Modulus is N
+* @param	NInv is -1 / N mod 2 ^ 32
+*
+* @return	None
+*
+* @note		A * B must be below N * R, true when one factor is below N
+*
+****************************************************************************/
+static void MontMul(u32 *Result, const u32 *A, const u32 *B,
+		const u32 *Modulus, u32 NInv)
+{
+	u32 T[MONT_DIGITS + 1];
+	u32 Digit;
+	u32 M;
+	u32 CarryMul;
+	u32 CarryRed;
+	u32 Borrow;
+	u32 Index;
+	u32 Jndex;
+	u64 Acc;
+
+	memset(T, 0, sizeof(T));
+
+	for (Index = 0U; Index < MONT_DIGITS; Index++) {
+		Digit = B[Index];
+
+		/*
+		 * The multiplier that clears the low digit of T + A * b
+		 */
+		Acc = (u64)A[0] * Digit + T[0];
+		CarryMul = (u32)(Acc >> 32);
+		M = (u32)Acc * NInv;
+		Acc = (u64)M * Modulus[0] + (u32)Acc;
+		CarryRed = (u32)(Acc >> 32);
+
+		/*
+		 * T = (T + A * b + M * N) / 2 ^ 32
+		 */
+		for (Jndex = 1U; Jndex < MONT_DIGITS; Jndex++) {
+			Acc = (u64)A[Jndex] * Digit + T[Jndex] + CarryMul;
+			CarryMul = (u32)(Acc >> 32);
+			Acc = (u64)M * Modulus[Jndex] + (u32)Acc + CarryRed;
+			CarryRed = (u32)(Acc >> 32);
+			T[Jndex - 1U] = (u32)Acc;
+		}
+		Acc = (u64)T[MONT_DIGITS] + CarryMul + CarryRed;
+		T[MONT_DIGITS - 1U] = (u32)Acc;
+		T[MONT_DIGITS] = (u32)(Acc >> 32);
+	}
+
+	/*
+	 * T is below 2N; subtract N once if T >= N
+	 */
+	if (T[MONT_DIGITS] == 0U) {
+		Index = MONT_DIGITS;
+		while (Index-- > 0U) {
+			if (T[Index] != Modulus[Index]) {
+				break;
+			}
+		}
+		if ((Index < MONT_DIGITS) && (T[Index] < Modulus[Index])) {
+			memcpy(Result, T, MONT_DIGITS * sizeof(u32));
+			return;
+		}
+	}
+
+	Borrow = 0U;
+	for (Index = 0U; Index < MONT_DIGITS; Index++) {
+		Acc = (u64)T[Index] - Modulus[Index] - Borrow;
+		Result[Index] = (u32)Acc;
+		Borrow = (u32)(Acc >> 63);
+	}
+}
@@ -0,0 +1,56 @@
+/******************************************************************************
+* Copyright (c) 2026 Joshua M. Meise
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file mont.h
+*
+* Contains the prototypes required by mont.c
+*
+* Numbers are RSA-2048 sized arrays of MONT_DIGITS 32-bit digits, least
+* significant digit first, the layout of the keys and signatures in the
+* authentication certificate.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a jmm	10/19/26	Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#ifndef ___MONT_H___
+#define ___MONT_H___
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+
+#define MONT_DIGITS				64U		/* 2048 bits */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+u32 MontPubExp(u32 *Result, const u32 *Base, u32 Exponent,
+		const u32 *Modulus, const u32 *RRModN);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ___MONT_H___ */
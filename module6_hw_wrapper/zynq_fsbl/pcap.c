@@ -59,6 +59,12 @@
 * 											In pcap.c, check pl power
 * 											through MCTRL register for
 * 											3.0 and later versions of silicon.
+* 17.00a jmm 10/19/26   Chunked bitstream load (PcapStream*) so the next
+* 						chunk can be read while PCAP takes the last one
+* 18.00a jmm 10/19/26   Split PcapLoadPartition into Start and Wait so
+* 						other partitions can load while PCAP runs
+* 19.00a jmm 10/19/26   PCAP DMA completes through the devcfg asynchronous
+* 						transfer API instead of XDcfgPollDone
 * </pre>
 *
 * @note
@@ -76,6 +82,7 @@
 #include "xdevcfg.h"
 #include "sleep.h"
 #include "xtime_l.h"
+#include "xil_cache.h"
 
 #ifdef XPAR_XWDTPS_0_BASEADDR
 #include "xwdtps.h"
@@ -89,17 +96,42 @@
 
 #define DCFG_DEVICE_ID		XPAR_XDCFG_0_DEVICE_ID
 
+#define PCAP_US(t)	((u32)(((t) * 1000000U) / COUNTS_PER_SECOND))
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
 extern int XDcfgPollDone(u32 MaskValue, u32 MaxCount);
+static void PcapTransferDone(void *CallBackRef, u32 Status, u32 IntrStatus);
+static u32 PcapTransferWait(void);
 
 /************************** Variable Definitions *****************************/
 /* Devcfg driver instance */
 static XDcfg DcfgInstance;
 XDcfg *DcfgInstPtr;
+
+/* A chunk of a streamed bitstream is still in the PCAP DMA */
+static u32 PcapStreamPending;
+
+/* Interrupt events seen by the last devcfg transfer */
+static u32 PcapTransferEvents;
+
+/*
+ * A bitstream started by PcapLoadPartitionStart has not been waited for;
+ * when it started, when it was first seen done, and the totals of the
+ * loads of this boot
+ */
+static u32 PcapLoadPending;
+static XTime PcapLoadStarted;
+static XTime PcapLoadSeenDone;
+static XTime PcapLoadTime;
+static XTime PcapLoadWaited;
+static u32 PcapLoadCount;
+#ifdef FSBL_PERF
+static XTime PcapLoadPerfStart;
+#endif
 extern u32 Silicon_Version;
 #ifdef XPAR_XWDTPS_0_BASEADDR
 extern XWdtPs Watchdog;	/* Instance of WatchDog Timer	*/
@@ -168,10 +200,11 @@ u32 PcapDataTransfer(u32 *SourceDataPtr, u32 *DestinationDataPtr,
 	/*
 	 * Transfer using Device Configuration
 	 */
-	Status = XDcfg_Transfer(DcfgInstPtr, (u8 *)SourceDataPtr,
+	Status = XDcfg_TransferAsync(DcfgInstPtr, (u8 *)SourceDataPtr,
 					SourceLength,
 					(u8 *)DestinationDataPtr,
-					DestinationLength, PcapTransferType);
+					DestinationLength, PcapTransferType,
+					XDCFG_ASYNC_DMA_DONE);
 	if (Status != XST_SUCCESS) {
 		fsbl_printf(DEBUG_INFO,"Status of XDcfg_Transfer = %lu \r \n",Status);
 		return XST_FAILURE;
@@ -183,9 +216,9 @@ u32 PcapDataTransfer(u32 *SourceDataPtr, u32 *DestinationDataPtr,
 	PcapDumpRegisters();
 
 	/*
-	 * Poll for the DMA done
+	 * Wait for the DMA done
 	 */
-	Status = XDcfgPollDone(XDCFG_IXR_DMA_DONE_MASK, MAX_COUNT);
+	Status = PcapTransferWait();
 	if (Status != XST_SUCCESS) {
 		fsbl_printf(DEBUG_INFO,"PCAP_DMA_DONE_FAIL \r\n");
 		return XST_FAILURE;
@@ -238,7 +271,42 @@ u32 PcapLoadPartition(u32 *SourceDataPtr, u32 *DestinationDataPtr,
 		u32 SourceLength, u32 DestinationLength, u32 SecureTransfer)
 {
 	u32 Status;
-	u32 IntrStsReg;
+
+	Status = PcapLoadPartitionStart(SourceDataPtr, DestinationDataPtr,
+			SourceLength, DestinationLength, SecureTransfer);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	return PcapLoadPartitionWait();
+}
+
+/******************************************************************************/
+/**
+*
+* This function starts loading a PL partition using PCAP and returns while
+* the DMA runs. PcapLoadPartitionWait finishes the load; devcfg must not
+* be used for anything else, nor the source changed, until it has.
+*
+* @param 	SourceDataPtr is a pointer to where the data is read from
+* @param 	DestinationDataPtr is a pointer to where the data is written to
+* @param 	SourceLength is the length of the data to be moved in words
+* @param 	DestinationLength is the length of the data to be moved in words
+* @param 	SecureTransfer indicated the encryption key location, 0 for
+* 			non-encrypted
+*
+* @return
+*		- XST_SUCCESS if the transfer was started
+*		- XST_FAILURE if the fabric could not be initialised or the
+*		  transfer was refused
+*
+* @note		 None
+*
+****************************************************************************/
+u32 PcapLoadPartitionStart(u32 *SourceDataPtr, u32 *DestinationDataPtr,
+		u32 SourceLength, u32 DestinationLength, u32 SecureTransfer)
+{
+	u32 Status;
 	u32 PcapTransferType = XDCFG_NON_SECURE_PCAP_WRITE;
 
 	/*
@@ -249,8 +317,7 @@ u32 PcapLoadPartition(u32 *SourceDataPtr, u32 *DestinationDataPtr,
 	}
 
 #ifdef FSBL_PERF
-	XTime tXferCur = 0;
-	FsblGetGlobalTime(&tXferCur);
+	FsblGetGlobalTime(&PcapLoadPerfStart);
 #endif
 
 	/*
@@ -292,44 +359,102 @@ u32 PcapLoadPartition(u32 *SourceDataPtr, u32 *DestinationDataPtr,
 	/*
 	 * Transfer using Device Configuration
 	 */
-	Status = XDcfg_Transfer(DcfgInstPtr, (u8 *)SourceDataPtr,
+	XTime_GetTime(&PcapLoadStarted);
+	PcapLoadSeenDone = 0;
+	PcapLoadPending = 1;
+
+	/*
+	 * The transfer completes once the DMA and the fabric are done
+	 */
+	Status = XDcfg_TransferAsync(DcfgInstPtr, (u8 *)SourceDataPtr,
 					SourceLength,
 					(u8 *)DestinationDataPtr,
-					DestinationLength, PcapTransferType);
+					DestinationLength, PcapTransferType,
+					XDCFG_ASYNC_PCFG_DONE);
 	if (Status != XST_SUCCESS) {
+		PcapLoadPending = 0;
 		fsbl_printf(DEBUG_INFO,"Status of XDcfg_Transfer = %lu \r \n",Status);
 		return XST_FAILURE;
 	}
 
-
 	/*
 	 * Dump the PCAP registers
 	 */
 	PcapDumpRegisters();
 
+	return XST_SUCCESS;
+}
 
-	/*
-	 * Poll for the DMA done
-	 */
-	Status = XDcfgPollDone(XDCFG_IXR_DMA_DONE_MASK, MAX_COUNT);
-	if (Status != XST_SUCCESS) {
-		fsbl_printf(DEBUG_INFO,"PCAP_DMA_DONE_FAIL \r\n");
-		return XST_FAILURE;
+/******************************************************************************/
+/**
+*
+* This function tells whether a load started with PcapLoadPartitionStart
+* still has to be finished with PcapLoadPartitionWait. It polls the devcfg
+* transfer, so the completion handler notes when the fabric was configured
+* for PcapReportOverlap.
+*
+* @param	None
+*
+* @return	1 if a load is outstanding, 0 otherwise
+*
+* @note		A load that has completed stays outstanding until it is waited
+*			for, which also checks it for errors
+*
+****************************************************************************/
+u32 PcapLoadPartitionPending(void)
+{
+	if (PcapLoadPending) {
+		(void)XDcfg_TransferPoll(DcfgInstPtr);
 	}
 
-	fsbl_printf(DEBUG_INFO,"DMA Done ! \n\r");
+	return PcapLoadPending;
+}
+
+/******************************************************************************/
+/**
+*
+* This function finishes a load started with PcapLoadPartitionStart: it
+* waits for the DMA and the fabric to be done and checks for errors
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if the bitstream is loaded, or none was outstanding
+*		- XST_FAILURE if the transfer fails
+*
+* @note		None
+*
+****************************************************************************/
+u32 PcapLoadPartitionWait(void)
+{
+	u32 Status;
+	u32 IntrStsReg;
+	XTime tWait;
+	XTime tNow;
+
+	if (!PcapLoadPending) {
+		return XST_SUCCESS;
+	}
+	PcapLoadPending = 0;
+
+	XTime_GetTime(&tWait);
 
 	/*
-	 * Poll for FPGA Done
+	 * Wait for the DMA done and FPGA Done
 	 */
-	Status = XDcfgPollDone(XDCFG_IXR_PCFG_DONE_MASK, MAX_COUNT);
+	Status = PcapTransferWait();
 	if (Status != XST_SUCCESS) {
-		fsbl_printf(DEBUG_INFO,"PCAP_FPGA_DONE_FAIL\r\n");
+		if (PcapTransferEvents & XDCFG_IXR_DMA_DONE_MASK) {
+			fsbl_printf(DEBUG_INFO,"PCAP_FPGA_DONE_FAIL\r\n");
+		} else {
+			fsbl_printf(DEBUG_INFO,"PCAP_DMA_DONE_FAIL \r\n");
+		}
 		return XST_FAILURE;
 	}
 
+	fsbl_printf(DEBUG_INFO,"DMA Done ! \n\r");
 	fsbl_printf(DEBUG_INFO,"FPGA Done ! \n\r");
-	
+
 	/*
 	 * Check for errors
 	 */
@@ -339,18 +464,265 @@ u32 PcapLoadPartition(u32 *SourceDataPtr, u32 *DestinationDataPtr,
 		return XST_FAILURE;
 	}
 
+	/*
+	 * Time the load took and how much of it was spent waiting here
+	 */
+	XTime_GetTime(&tNow);
+	if (PcapLoadSeenDone == 0) {
+		PcapLoadSeenDone = tNow;
+	}
+	PcapLoadTime += PcapLoadSeenDone - PcapLoadStarted;
+	PcapLoadWaited += tNow - tWait;
+	PcapLoadCount++;
+
 	/*
 	 * For Performance measurement
 	 */
 #ifdef FSBL_PERF
 	XTime tXferEnd = 0;
 	fsbl_printf(DEBUG_GENERAL,"Time taken is ");
-	FsblMeasurePerfTime(tXferCur,tXferEnd);
+	FsblMeasurePerfTime(PcapLoadPerfStart,tXferEnd);
 #endif
 
 	return XST_SUCCESS;
 }
 
+/******************************************************************************/
+/**
+*
+* This function reports how long the PCAP bitstream loads of this boot took
+* and how much of that was hidden behind other work
+*
+* @param	None
+*
+* @return	None
+*
+* @note		A load that finished during a step is only seen done at the
+*			end of it, so the hidden time can be over by up to one step
+*
+****************************************************************************/
+void PcapReportOverlap(void)
+{
+	if (PcapLoadCount == 0) {
+		return;
+	}
+
+	fsbl_printf(DEBUG_INFO, "PCAP loaded %lu bitstreams in %lu us, "
+			"waited %lu us, saved %lu us\r\n", PcapLoadCount,
+			PCAP_US(PcapLoadTime), PCAP_US(PcapLoadWaited),
+			(PcapLoadTime > PcapLoadWaited) ?
+				PCAP_US(PcapLoadTime - PcapLoadWaited) : 0);
+}
+
+/******************************************************************************/
+/**
+*
+* This function is the completion handler of every devcfg transfer. It
+* keeps the events for the error report and notes when a bitstream started
+* by PcapLoadPartitionStart was done.
+*
+* @param	CallBackRef is unused
+* @param	Status is the result of the transfer
+* @param	IntrStatus is the interrupt events the transfer saw
+*
+* @return	None
+*
+* @note		Called from XDcfg_TransferPoll and XDcfg_TransferWait, or
+*			from the devcfg interrupt if it is connected
+*
+****************************************************************************/
+static void PcapTransferDone(void *CallBackRef, u32 Status, u32 IntrStatus)
+{
+	(void)CallBackRef;
+
+	PcapTransferEvents = IntrStatus;
+
+	if ((Status == XST_SUCCESS) && PcapLoadPending &&
+			(PcapLoadSeenDone == 0)) {
+		XTime_GetTime(&PcapLoadSeenDone);
+	}
+}
+
+/******************************************************************************/
+/**
+*
+* This function waits for the devcfg transfer started last and reports a
+* failure as XDcfgPollDone does, without its progress output, which would
+* otherwise be printed for every chunk of a streamed bitstream
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if the transfer completed
+*		- XST_FAILURE on a PCAP error or time out
+*
+* @note		None
+*
+****************************************************************************/
+static u32 PcapTransferWait(void)
+{
+	u32 Status;
+
+	Status = XDcfg_TransferWait(DcfgInstPtr, MAX_COUNT);
+	if (Status == XST_TIMEOUT) {
+		fsbl_printf(DEBUG_GENERAL,"PCAP transfer timed out \r\n");
+		return XST_FAILURE;
+	}
+
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_INFO,"FATAL errors in PCAP %lx\r\n",
+				PcapTransferEvents);
+		PcapDumpRegisters();
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function starts a bitstream download that is fed in chunks with
+* PcapStreamWrite and finished with PcapStreamEnd
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if the fabric is ready for the bitstream
+*		- XST_FAILURE otherwise
+*
+* @note		Only for non-encrypted bitstreams
+*
+****************************************************************************/
+u32 PcapStreamBegin(void)
+{
+	u32 Status;
+
+	PcapStreamPending = 0;
+
+	/*
+	 * Clear the PCAP status registers
+	 */
+	Status = ClearPcapStatus();
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_INFO,"PCAP_CLEAR_STATUS_FAIL \r\n");
+		return XST_FAILURE;
+	}
+
+	/*
+	 * New Bitstream download initialization sequence
+	 */
+	return FabricInit();
+}
+
+/******************************************************************************/
+/**
+*
+* This function queues one chunk of a bitstream to the PCAP. It waits for
+* the previous chunk to leave the DMA first, so once it returns the buffer
+* handed in before this one may be reused.
+*
+* @param	SourceDataPtr is the chunk, word aligned
+* @param	WordLength is the length of the chunk in words
+* @param	Last is set for the final chunk of the bitstream
+*
+* @return
+*		- XST_SUCCESS if the chunk was queued
+*		- XST_FAILURE if the previous chunk failed or the DMA refused
+*
+* @note		The chunk is flushed from the data cache before the DMA
+*
+****************************************************************************/
+u32 PcapStreamWrite(u32 *SourceDataPtr, u32 WordLength, u32 Last)
+{
+	u32 Status;
+	u32 SourceAddr = (u32)SourceDataPtr;
+
+	if (PcapStreamPending) {
+		Status = PcapTransferWait();
+		if (Status != XST_SUCCESS) {
+			fsbl_printf(DEBUG_INFO,"PCAP_DMA_DONE_FAIL \r\n");
+			return XST_FAILURE;
+		}
+		PcapStreamPending = 0;
+	}
+
+	Xil_DCacheFlushRange(SourceAddr, WordLength << WORD_LENGTH_SHIFT);
+
+	/*
+	 * Only the final DMA command of the bitstream carries the last
+	 * transfer flag and completes once the fabric is done too; the
+	 * destination of a PCAP write is always invalid
+	 */
+	if (Last) {
+		SourceAddr |= PCAP_LAST_TRANSFER;
+	}
+
+	Status = XDcfg_TransferAsync(DcfgInstPtr, (u8 *)SourceAddr, WordLength,
+			(u8 *)XDCFG_DMA_INVALID_ADDRESS, WordLength,
+			XDCFG_NON_SECURE_PCAP_WRITE,
+			Last ? XDCFG_ASYNC_PCFG_DONE : XDCFG_ASYNC_DMA_DONE);
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_INFO,"Status of XDcfg_Transfer = %lu \r \n",Status);
+		return XST_FAILURE;
+	}
+
+	PcapStreamPending = 1;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function waits for the last chunk of a streamed bitstream and for
+* the fabric to report done
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if the fabric is configured
+*		- XST_FAILURE otherwise
+*
+* @note		None
+*
+****************************************************************************/
+u32 PcapStreamEnd(void)
+{
+	u32 Status;
+	u32 IntrStsReg;
+
+	/*
+	 * The last chunk completes with the DMA and FPGA Done
+	 */
+	if (PcapStreamPending) {
+		Status = PcapTransferWait();
+		if (Status != XST_SUCCESS) {
+			if (PcapTransferEvents & XDCFG_IXR_DMA_DONE_MASK) {
+				fsbl_printf(DEBUG_INFO,"PCAP_FPGA_DONE_FAIL\r\n");
+			} else {
+				fsbl_printf(DEBUG_INFO,"PCAP_DMA_DONE_FAIL \r\n");
+			}
+			return XST_FAILURE;
+		}
+		PcapStreamPending = 0;
+	}
+
+	fsbl_printf(DEBUG_INFO,"DMA Done ! \n\r");
+	fsbl_printf(DEBUG_INFO,"FPGA Done ! \n\r");
+
+	/*
+	 * Check for errors
+	 */
+	IntrStsReg = XDcfg_IntrGetStatus(DcfgInstPtr);
+	if (IntrStsReg & FSBL_XDCFG_IXR_ERROR_FLAGS_MASK) {
+		fsbl_printf(DEBUG_INFO,"Errors in PCAP \r\n");
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
 /******************************************************************************/
 /**
 *
@@ -383,6 +755,14 @@ int InitPcap(void)
 		return XST_FAILURE;
 	}
 
+	/*
+	 * Transfers fail on the FSBL error flags and complete through
+	 * PcapTransferDone; the devcfg interrupt is not connected, so they
+	 * are polled with XDcfg_TransferPoll and XDcfg_TransferWait
+	 */
+	XDcfg_SetAsyncErrorMask(DcfgInstPtr, FSBL_XDCFG_IXR_ERROR_FLAGS_MASK);
+	XDcfg_SetDoneHandler(DcfgInstPtr, (void *)PcapTransferDone, NULL);
+
 	return XST_SUCCESS;
 }
 /******************************************************************************/
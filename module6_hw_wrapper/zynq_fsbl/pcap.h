@@ -22,6 +22,8 @@
 * 						Fabric Initialization sequence is modified to check
 * 						the PL power before sequence starts and checking INIT_B
 * 						reset status twice in case of failure.
+* 17.00a jmm 10/19/26   Added the PcapStream chunked bitstream load
+* 18.00a jmm 10/19/26   Added the PcapLoadPartition Start/Wait split
 * </pre>
 *
 * @note
@@ -70,8 +72,16 @@ u32 FabricInit(void);
 int XDcfgPollDone(u32 MaskValue, u32 MaxCount);
 u32 PcapLoadPartition(u32 *SourceData, u32 *DestinationData, u32 SourceLength,
 		 	u32 DestinationLength, u32 Flags);
+u32 PcapLoadPartitionStart(u32 *SourceData, u32 *DestinationData,
+			u32 SourceLength, u32 DestinationLength, u32 Flags);
+u32 PcapLoadPartitionPending(void);
+u32 PcapLoadPartitionWait(void);
+void PcapReportOverlap(void);
 u32 PcapDataTransfer(u32 *SourceData, u32 *DestinationData, u32 SourceLength,
  			u32 DestinationLength, u32 Flags);
+u32 PcapStreamBegin(void);
+u32 PcapStreamWrite(u32 *SourceData, u32 WordLength, u32 Last);
+u32 PcapStreamEnd(void);
 /************************** Variable Definitions *****************************/
 #ifdef __cplusplus
 }
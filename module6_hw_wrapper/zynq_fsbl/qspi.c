@@ -37,6 +37,15 @@
 *					 					 instead of hard coded read
 *					 					 command (0x6B).
 * 15.0 bsv 09/04/20  Add support for 2Gb flash parts
+* 16.0 jmm 10/19/26  Hash the data while copying it out of the read buffer
+*                    when image_mover asks for a checksum
+* 17.0 jmm 10/19/26  Read flash larger than 16MB through the linear window,
+*                    one bank at a time, with the PL330 moving the data;
+*                    the selected bank is cached instead of being set and
+*                    reset on every access
+* 18.0 jmm 10/19/26  Invalidate each DMA block once it lands, before it is
+*                    hashed, so lines prefetched during the transfer are
+*                    not read stale
 * </pre>
 *
 * @note
@@ -51,6 +60,16 @@
 #ifdef XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR
 #include "xqspips_hw.h"
 #include "xqspips.h"
+#include "xil_cache.h"
+#include "xtime_l.h"
+
+/*
+ * The secure PL330 copies out of the linear window unless QSPI_NO_DMA
+ */
+#if defined(XPAR_XDMAPS_1_DEVICE_ID) && !defined(QSPI_NO_DMA)
+#define QSPI_DMA
+#include "xdmaps.h"
+#endif
 
 /************************** Constant Definitions *****************************/
 
@@ -158,11 +177,31 @@
 #define QSPI_BUSWIDTH_TWO	1U
 #define QSPI_BUSWIDTH_FOUR	2U
 
+/*
+ * DMA from the linear window: channel, block size (the CPU hashes one
+ * block while the next is in flight), alignment of the destination (a
+ * cache line, so invalidating it never touches other data) and poll limit
+ */
+#define QSPI_DMA_CHANNEL	0U
+#define QSPI_DMA_BLOCK		0x4000U
+#define QSPI_DMA_ALIGN		32U
+#define QSPI_DMA_TIMEOUT	100000000U
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
+static u32 QspiWindowAccess(u32 SourceAddress, u32 DestinationAddress,
+		u32 LengthBytes);
+static u32 QspiWindowCopy(u32 SourceAddress, u32 DestinationAddress,
+		u32 LengthBytes);
+static void QspiSetLinear(u8 Linear);
+#ifdef QSPI_DMA
+static u32 QspiDmaStart(u32 SourceAddress, u32 DestinationAddress,
+		u32 LengthBytes);
+static u32 QspiDmaWait(void);
+#endif
 
 /************************** Variable Definitions *****************************/
 
@@ -180,6 +219,27 @@ extern u8 LinearBootDeviceFlag;
 u8 ReadBuffer[DATA_SIZE + DATA_OFFSET + DUMMY_SIZE];
 u8 WriteBuffer[DATA_OFFSET + DUMMY_SIZE];
 
+/*
+ * Bank the flash is known to have selected and whether the controller is
+ * in linear mode; the boot ROM leaves bank 0 selected
+ */
+static u8 QspiBank;
+static u8 QspiLinear;
+
+/*
+ * Read rate of QspiAccess, reported by QspiReportRate
+ */
+static u32 QspiReadBytes;
+static u32 QspiDmaBytes;
+static u32 QspiBankSelects;
+static XTime QspiReadTime;
+
+#ifdef QSPI_DMA
+static XDmaPs QspiDmaInstance;
+static XDmaPs_Cmd QspiDmaCmd;
+static u8 QspiDmaReady;
+#endif
+
 /******************************************************************************/
 /**
 *
@@ -415,6 +475,24 @@ u32 InitQspi(void)
 		XQspiPs_SetLqspiConfigReg(QspiInstancePtr, ConfigCmd);
 	}
 
+	QspiLinear = LinearBootDeviceFlag;
+
+#ifdef QSPI_DMA
+	{
+		XDmaPs_Config *DmaConfig;
+
+		/*
+		 * Without the DMA controller the CPU copies from the window
+		 */
+		DmaConfig = XDmaPs_LookupConfig(XPAR_XDMAPS_1_DEVICE_ID);
+		if ((DmaConfig != NULL) &&
+				(XDmaPs_CfgInitialize(&QspiDmaInstance, DmaConfig,
+						DmaConfig->BaseAddress) == XST_SUCCESS)) {
+			QspiDmaReady = 1;
+		}
+	}
+#endif
+
 	return XST_SUCCESS;
 }
 
@@ -580,8 +658,13 @@ u32 QspiAccess( u32 SourceAddress, u32 DestinationAddress, u32 LengthBytes)
 	u32 Length = 0;
 	u32 BankSel = 0;
 	u32 LqspiCrReg;
-	u32 Status;
+	u32 Status = XST_SUCCESS;
 	u8 BankSwitchFlag = 1;
+	u32 Requested = LengthBytes;
+	XTime tStart;
+	XTime tEnd;
+
+	XTime_GetTime(&tStart);
 
 	/*
 	 * Linear access check
@@ -594,9 +677,17 @@ u32 QspiAccess( u32 SourceAddress, u32 DestinationAddress, u32 LengthBytes)
 			LengthBytes += (4 - (LengthBytes & 0x00000003));
 		}
 
-		memcpy((void*)DestinationAddress,
-		      (const void*)(SourceAddress + FlashReadBaseAddress),
-		      (size_t)LengthBytes);
+		Status = QspiWindowCopy(SourceAddress + FlashReadBaseAddress,
+				DestinationAddress, LengthBytes);
+#ifndef QSPI_IO_READ
+	} else if (XPAR_XQSPIPS_0_QSPI_MODE != DUAL_STACK_CONNECTION) {
+		/*
+		 * Non linear flash read through the linear window a bank at a
+		 * time; dual stack keeps the I/O path below
+		 */
+		Status = QspiWindowAccess(SourceAddress, DestinationAddress,
+				LengthBytes);
+#endif
 	} else {
 		/*
 		 * Non Linear access
@@ -703,9 +794,15 @@ u32 QspiAccess( u32 SourceAddress, u32 DestinationAddress, u32 LengthBytes)
 			FlashRead(SourceAddress, Length);
 
 			/*
-			 * Moving the data from local buffer to DDR destination address
+			 * Moving the data from local buffer to DDR destination address,
+			 * hashing it on the way if a checksum is wanted
 			 */
-			memcpy(BufferPtr, &ReadBuffer[DATA_OFFSET + DUMMY_SIZE], Length);
+			if (MoveChecksumContext != NULL) {
+				MD5CopyUpdate(MoveChecksumContext, BufferPtr,
+						&ReadBuffer[DATA_OFFSET + DUMMY_SIZE], Length, 0);
+			} else {
+				memcpy(BufferPtr, &ReadBuffer[DATA_OFFSET + DUMMY_SIZE], Length);
+			}
 
 			/*
 			 * Updated the variables
@@ -750,9 +847,376 @@ u32 QspiAccess( u32 SourceAddress, u32 DestinationAddress, u32 LengthBytes)
 		}
 	}
 
+	XTime_GetTime(&tEnd);
+	QspiReadTime += tEnd - tStart;
+	QspiReadBytes += Requested;
+
+	return Status;
+}
+
+/******************************************************************************/
+/**
+*
+* This function reads flash larger than the 16MB linear window. Each bank
+* is selected once in I/O mode, then read through the window in linear
+* mode with the configured fast read command, so the controller streams
+* the whole span instead of one DATA_SIZE command at a time.
+*
+* @param	SourceAddress is address in FLASH data space
+* @param	DestinationAddress is address in DDR data space
+* @param	LengthBytes is the length of the data in Bytes
+*
+* @return
+*		- XST_SUCCESS if the read completes correctly
+*		- XST_FAILURE if a bank could not be selected or the copy failed
+*
+* @note	The bank and the mode are left as they are for the next access;
+*		QspiRestoreBank puts them back before handoff.
+*
+****************************************************************************/
+static u32 QspiWindowAccess(u32 SourceAddress, u32 DestinationAddress,
+		u32 LengthBytes)
+{
+	u32 WindowSize = FLASH_SIZE_16MB;
+	u32 Bank;
+	u32 Offset;
+	u32 Length;
+	u32 Status;
+
+	/*
+	 * In dual parallel the window interleaves both flashes, so one bank
+	 * covers 32MB of it
+	 */
+	if (XPAR_XQSPIPS_0_QSPI_MODE == DUAL_PARALLEL_CONNECTION) {
+		WindowSize = 2 * FLASH_SIZE_16MB;
+	}
+
+	while (LengthBytes > 0) {
+		Bank = SourceAddress / WindowSize;
+		Offset = SourceAddress % WindowSize;
+
+		Length = WindowSize - Offset;
+		if (Length > LengthBytes) {
+			Length = LengthBytes;
+		}
+
+		if (Bank != QspiBank) {
+			QspiSetLinear(0);
+
+			fsbl_printf(DEBUG_INFO, "Bank Selection %lu\n\r", Bank);
+
+			Status = SendBankSelect(Bank);
+			if (Status != XST_SUCCESS) {
+				fsbl_printf(DEBUG_INFO, "Bank Selection Failed\n\r");
+				return XST_FAILURE;
+			}
+
+			QspiBank = Bank;
+			QspiBankSelects++;
+		}
+
+		QspiSetLinear(1);
+
+		Status = QspiWindowCopy(FlashReadBaseAddress + Offset,
+				DestinationAddress, Length);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		SourceAddress += Length;
+		DestinationAddress += Length;
+		LengthBytes -= Length;
+	}
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function switches the controller between I/O mode, which bank
+* select commands need, and linear mode, keeping the configured read
+* command
+*
+* @param	Linear is 1 for linear mode, 0 for I/O mode
+*
+* @return	None
+*
+* @note	None
+*
+****************************************************************************/
+static void QspiSetLinear(u8 Linear)
+{
+	u32 LqspiCrReg;
+
+	if (QspiLinear == Linear) {
+		return;
+	}
+
+	LqspiCrReg = XQspiPs_GetLqspiConfigReg(QspiInstancePtr);
+
+	XQspiPs_Disable(QspiInstancePtr);
+
+	if (Linear) {
+		XQspiPs_SetOptions(QspiInstancePtr, XQSPIPS_LQSPI_MODE_OPTION |
+				XQSPIPS_HOLD_B_DRIVE_OPTION);
+		XQspiPs_SetLqspiConfigReg(QspiInstancePtr,
+				LqspiCrReg | XQSPIPS_LQSPI_CR_LINEAR_MASK);
+	} else {
+		XQspiPs_SetOptions(QspiInstancePtr, XQSPIPS_FORCE_SSELECT_OPTION |
+				XQSPIPS_HOLD_B_DRIVE_OPTION);
+		XQspiPs_SetLqspiConfigReg(QspiInstancePtr,
+				LqspiCrReg & ~XQSPIPS_LQSPI_CR_LINEAR_MASK);
+		XQspiPs_SetSlaveSelect(QspiInstancePtr);
+	}
+
+	XQspiPs_Enable(QspiInstancePtr);
+
+	QspiLinear = Linear;
+}
+
+/******************************************************************************/
+/**
+*
+* This function copies from the linear window. The cache-line aligned bulk
+* goes through the PL330 in QSPI_DMA_BLOCK pieces; with a checksum wanted
+* the CPU hashes each piece while the next one is read. Whatever the DMA
+* cannot take is copied (and hashed) by the CPU.
+*
+* @param	SourceAddress is the address in the linear window
+* @param	DestinationAddress is address in DDR data space
+* @param	LengthBytes is the length of the data in Bytes
+*
+* @return
+*		- XST_SUCCESS if the copy completes correctly
+*		- XST_FAILURE if the DMA failed
+*
+* @note	None
+*
+****************************************************************************/
+static u32 QspiWindowCopy(u32 SourceAddress, u32 DestinationAddress,
+		u32 LengthBytes)
+{
+#ifdef QSPI_DMA
+	u32 Bulk;
+	u32 Block;
+	u32 Next;
+	u32 Status;
+
+	Bulk = LengthBytes & ~(QSPI_DMA_ALIGN - 1U);
+
+	if (QspiDmaReady && (Bulk != 0) &&
+			((SourceAddress & 3U) == 0) &&
+			((DestinationAddress & (QSPI_DMA_ALIGN - 1U)) == 0)) {
+		Block = (Bulk < QSPI_DMA_BLOCK) ? Bulk : QSPI_DMA_BLOCK;
+		Status = QspiDmaStart(SourceAddress, DestinationAddress, Block);
+
+		while (Status == XST_SUCCESS) {
+			Status = QspiDmaWait();
+			if (Status != XST_SUCCESS) {
+				break;
+			}
+
+			/*
+			 * The L1 and L2 prefetchers may have pulled lines of the
+			 * block in while the DMA was writing it; drop them before
+			 * the block is read here or by the caller
+			 */
+			Xil_DCacheInvalidateRange(DestinationAddress, Block);
+
+			Next = Bulk - Block;
+			if (Next > QSPI_DMA_BLOCK) {
+				Next = QSPI_DMA_BLOCK;
+			}
+			if (Next != 0) {
+				Status = QspiDmaStart(SourceAddress + Block,
+						DestinationAddress + Block, Next);
+			}
+
+			if (MoveChecksumContext != NULL) {
+				MD5Update(MoveChecksumContext, (u8 *)DestinationAddress,
+						Block, 0);
+			}
+
+			QspiDmaBytes += Block;
+			SourceAddress += Block;
+			DestinationAddress += Block;
+			LengthBytes -= Block;
+			Bulk -= Block;
+			Block = Next;
+
+			if (Block == 0) {
+				break;
+			}
+		}
+
+		if (Status != XST_SUCCESS) {
+			fsbl_printf(DEBUG_GENERAL, "QSPI DMA failed\r\n");
+			return XST_FAILURE;
+		}
+	}
+#endif
+
+	if (MoveChecksumContext != NULL) {
+		MD5CopyUpdate(MoveChecksumContext, (u8 *)DestinationAddress,
+				(const u8 *)SourceAddress, LengthBytes, 0);
+	} else {
+		memcpy((void *)DestinationAddress, (const void *)SourceAddress,
+				(size_t)LengthBytes);
+	}
+
 	return XST_SUCCESS;
 }
 
+#ifdef QSPI_DMA
+/******************************************************************************/
+/**
+*
+* This function starts one PL330 copy out of the linear window
+*
+* @param	SourceAddress is the address in the linear window
+* @param	DestinationAddress is address in DDR data space
+* @param	LengthBytes is the length, a multiple of QSPI_DMA_ALIGN
+*
+* @return
+*		- XST_SUCCESS if the DMA was started
+*		- XST_FAILURE otherwise
+*
+* @note	The driver invalidates the destination before starting; the
+*		caller invalidates it again once the copy is done
+*
+****************************************************************************/
+static u32 QspiDmaStart(u32 SourceAddress, u32 DestinationAddress,
+		u32 LengthBytes)
+{
+	memset(&QspiDmaCmd, 0, sizeof(QspiDmaCmd));
+
+	QspiDmaCmd.ChanCtrl.SrcBurstSize = 4;
+	QspiDmaCmd.ChanCtrl.SrcBurstLen = 16;
+	QspiDmaCmd.ChanCtrl.SrcInc = 1;
+	QspiDmaCmd.ChanCtrl.DstBurstSize = 4;
+	QspiDmaCmd.ChanCtrl.DstBurstLen = 16;
+	QspiDmaCmd.ChanCtrl.DstInc = 1;
+	QspiDmaCmd.BD.SrcAddr = SourceAddress;
+	QspiDmaCmd.BD.DstAddr = DestinationAddress;
+	QspiDmaCmd.BD.Length = LengthBytes;
+
+	if (XDmaPs_Start(&QspiDmaInstance, QSPI_DMA_CHANNEL, &QspiDmaCmd, 0)
+			!= XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function waits for the PL330 copy to finish. The FSBL runs with
+* interrupts off, so the channel event is polled and the driver's done
+* handler is called directly to release the channel.
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if the copy finished
+*		- XST_FAILURE on a DMA fault or time out
+*
+* @note	None
+*
+****************************************************************************/
+static u32 QspiDmaWait(void)
+{
+	u32 BaseAddr = QspiDmaInstance.Config.BaseAddress;
+	u32 Count = QSPI_DMA_TIMEOUT;
+
+	while ((XDmaPs_ReadReg(BaseAddr, XDMAPS_INTSTATUS_OFFSET) &
+			(1U << QSPI_DMA_CHANNEL)) == 0) {
+		if ((XDmaPs_ReadReg(BaseAddr, XDMAPS_FSM_OFFSET) != 0) ||
+				((XDmaPs_ReadReg(BaseAddr, XDMAPS_FSC_OFFSET) &
+				(1U << QSPI_DMA_CHANNEL)) != 0)) {
+			XDmaPs_FaultISR(&QspiDmaInstance);
+			return XST_FAILURE;
+		}
+
+		if (--Count == 0) {
+			XDmaPs_ResetChannel(&QspiDmaInstance, QSPI_DMA_CHANNEL);
+			return XST_FAILURE;
+		}
+	}
+
+	XDmaPs_DoneISR_0(&QspiDmaInstance);
+
+	return XST_SUCCESS;
+}
+#endif
+
+/******************************************************************************/
+/**
+*
+* This function puts the flash back to bank 0 and the controller back to
+* I/O mode, as the boot ROM and the next stage expect. It does nothing if
+* the window read path never moved off bank 0.
+*
+* @param	None
+*
+* @return	None
+*
+* @note	Called before handoff and before a fallback reset
+*
+****************************************************************************/
+void QspiRestoreBank(void)
+{
+	if ((QspiInstancePtr == NULL) || (LinearBootDeviceFlag == 1)) {
+		return;
+	}
+
+	QspiSetLinear(0);
+
+	if (QspiBank != 0) {
+		if (SendBankSelect(0) != XST_SUCCESS) {
+			fsbl_printf(DEBUG_INFO, "Bank Selection Reset Failed\n\r");
+		}
+		QspiBank = 0;
+	}
+}
+
+/******************************************************************************/
+/**
+*
+* This function prints how fast QspiAccess has read so far
+*
+* @param	None
+*
+* @return	None
+*
+* @note	Printed with FSBL_DEBUG_INFO
+*
+****************************************************************************/
+void QspiReportRate(void)
+{
+	u32 Us;
+	u32 Rate;
+
+	if (QspiReadTime == 0) {
+		return;
+	}
+
+	Us = (u32)((QspiReadTime * 1000000U) / COUNTS_PER_SECOND);
+
+	/*
+	 * Tenths of a MB/s
+	 */
+	Rate = (u32)(((u64)QspiReadBytes * 10U * COUNTS_PER_SECOND) /
+			(QspiReadTime * 1000000U));
+
+	fsbl_printf(DEBUG_INFO, "QSPI %s read %lu bytes in %lu us, %lu.%lu MB/s, "
+			"%lu bytes by DMA, %lu bank selects\r\n",
+			LinearBootDeviceFlag ? "linear" : "non-linear",
+			QspiReadBytes, Us, Rate / 10, Rate % 10,
+			QspiDmaBytes, QspiBankSelects);
+}
+
 
 
 /******************************************************************************
@@ -20,6 +20,7 @@
 * 5.00a sgd	05/17/13 Added Flash Size > 128Mbit support
 * 					 Dual Stack support
 * 6.00a bsv	09/04/20 Added support for 2Gb flash parts
+* 7.00a jmm	10/19/26 Added QspiRestoreBank and QspiReportRate
 * </pre>
 *
 * @note
@@ -103,6 +104,8 @@ u32 QspiAccess( u32 SourceAddress,
 
 u32 FlashReadID(void);
 u32 SendBankSelect(u8 BankSel);
+void QspiRestoreBank(void);
+void QspiReportRate(void);
 /************************** Variable Definitions *****************************/
 
 
@@ -28,6 +28,10 @@
 *					 					 fallback unless FSBL* and FSBL are
 *					 					 identical in length
 *					 Fix for CR#791245 - Use of xilrsa in FSBL
+* 10.00a jmm 10/19/26 Replaced xilrsa with the SHA-256 of sha256.c and the
+*					 Montgomery exponentiation of mont.c
+*					 Added AuthenticatePartitionHash to take a partition
+*					 hash computed while the partition was loaded
 * </pre>
 *
 * @note
@@ -38,7 +42,8 @@
 #ifdef RSA_SUPPORT
 #include "fsbl.h"
 #include "rsa.h"
-#include "xilrsa.h"
+#include "sha256.h"
+#include "mont.h"
 
 #ifdef	XPAR_XWDTPS_0_BASEADDR
 #include "xwdtps.h"
@@ -171,8 +176,33 @@ void SetPpk(void )
 ******************************************************************************/
 u32 AuthenticatePartition(u8 *Buffer, u32 Size)
 {
-	u8 DecryptSignature[256];
-	u8 HashSignature[32];
+	return AuthenticatePartitionHash(Buffer, Size, NULL);
+}
+
+
+/*****************************************************************************/
+/**
+*
+* This function Authenticate Partition Signature against a partition hash
+* computed while the partition was loaded
+*
+* @param	Buffer is the partition, certificate last
+* @param	Size is the partition size in bytes, certificate included
+* @param	PartitionHash is the SHA-256 of the first
+*			Size - RSA_PARTITION_SIGNATURE_SIZE bytes, or NULL to
+*			hash them here
+*
+* @return
+*		- XST_SUCCESS if Authentication passed
+*		- XST_FAILURE if Authentication failed
+*
+* @note		None
+*
+******************************************************************************/
+u32 AuthenticatePartitionHash(u8 *Buffer, u32 Size, const u8 *PartitionHash)
+{
+	u32 DecryptSignature[MONT_DIGITS];
+	u8 HashSignature[SHA256_HASH_SIZE];
 	u8 *SpkModular;
 	u8 *SpkModularEx;
 	u32 SpkExp;
@@ -211,7 +241,7 @@ u32 AuthenticatePartition(u8 *Buffer, u32 Size)
 	/*
 	 * Calculate Hash Signature
 	 */
-	sha_256((u8 *)SignaturePtr, (RSA_SPK_MODULAR_EXT_SIZE +
+	Sha256((u8 *)SignaturePtr, (RSA_SPK_MODULAR_EXT_SIZE +
 				RSA_SPK_EXPO_SIZE + RSA_SPK_MODULAR_SIZE),
 				HashSignature);
 	FsblPrintArray(HashSignature, 32, "SPK Hash Calculated");
@@ -229,16 +259,19 @@ u32 AuthenticatePartition(u8 *Buffer, u32 Size)
 	/*
 	 * Decrypt SPK Signature
 	 */
-	rsa2048_pubexp((RSA_NUMBER)DecryptSignature,
-			(RSA_NUMBER)SignaturePtr,
+	Status = MontPubExp(DecryptSignature,
+			(u32 *)SignaturePtr,
 			(u32)PpkExp,
-			(RSA_NUMBER)PpkModular,
-			(RSA_NUMBER)PpkModularEx);
-	FsblPrintArray(DecryptSignature, RSA_SPK_SIGNATURE_SIZE,
+			(u32 *)PpkModular,
+			(u32 *)PpkModularEx);
+	FsblPrintArray((u8 *)DecryptSignature, RSA_SPK_SIGNATURE_SIZE,
 					"SPK Decrypted Hash");
 
 
-	Status = RecreatePaddingAndCheck(DecryptSignature, HashSignature);
+	if (Status == XST_SUCCESS) {
+		Status = RecreatePaddingAndCheck((u8 *)DecryptSignature,
+					HashSignature);
+	}
 	if (Status != XST_SUCCESS) {
 		fsbl_printf(DEBUG_INFO, "Partition SPK Signature "
 				"Authentication failed\r\n");
@@ -249,25 +282,32 @@ u32 AuthenticatePartition(u8 *Buffer, u32 Size)
 	/*
 	 * Decrypt Partition Signature
 	 */
-	rsa2048_pubexp((RSA_NUMBER)DecryptSignature,
-			(RSA_NUMBER)SignaturePtr,
+	Status = MontPubExp(DecryptSignature,
+			(u32 *)SignaturePtr,
 			(u32)SpkExp,
-			(RSA_NUMBER)SpkModular,
-			(RSA_NUMBER)SpkModularEx);
-	FsblPrintArray(DecryptSignature, RSA_PARTITION_SIGNATURE_SIZE,
+			(u32 *)SpkModular,
+			(u32 *)SpkModularEx);
+	FsblPrintArray((u8 *)DecryptSignature, RSA_PARTITION_SIGNATURE_SIZE,
 					"Partition Decrypted Hash");
 
 	/*
 	 * Partition Authentication
-	 * Calculate Hash Signature
+	 * Calculate Hash Signature, unless it was calculated during the load
 	 */
-	sha_256((u8 *)Buffer,
-			(Size - RSA_PARTITION_SIGNATURE_SIZE),
-			HashSignature);
+	if (PartitionHash != NULL) {
+		memcpy(HashSignature, PartitionHash, SHA256_HASH_SIZE);
+	} else {
+		Sha256((u8 *)Buffer,
+				(Size - RSA_PARTITION_SIGNATURE_SIZE),
+				HashSignature);
+	}
 	FsblPrintArray(HashSignature, 32,
 						"Partition Hash Calculated");
 
-	Status = RecreatePaddingAndCheck(DecryptSignature, HashSignature);
+	if (Status == XST_SUCCESS) {
+		Status = RecreatePaddingAndCheck((u8 *)DecryptSignature,
+					HashSignature);
+	}
 	if (Status != XST_SUCCESS) {
 		fsbl_printf(DEBUG_INFO, "Partition Signature "
 				"Authentication failed\r\n");
@@ -16,6 +16,7 @@
 * Ver	Who	Date		Changes
 * ----- ---- -------- -------------------------------------------------------
 * 4.00a sg	02/28/13 Initial release
+* 5.00a jmm 10/19/26 Added AuthenticatePartitionHash
 *
 * </pre>
 *
@@ -45,6 +46,7 @@ extern "C" {
 
 void SetPpk(void );
 u32 AuthenticatePartition(u8 *Buffer, u32 Size);
+u32 AuthenticatePartitionHash(u8 *Buffer, u32 Size, const u8 *PartitionHash);
 u32 RecreatePaddingAndCheck(u8 *signature, u8 *hash);
 
 #ifdef __cplusplus
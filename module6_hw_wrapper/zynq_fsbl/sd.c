@@ -18,10 +18,28 @@
 * 1.00a jz	04/28/11 Initial release
 * 7.00a kc  10/18/13 Integrated SD/MMC driver
 * 12.00a ssc 12/11/14 Fix for CR# 839182
+* 13.00a jmm 10/19/26 Boot file read as sector extents: whole sectors by
+*                     multi-block read straight into the destination, the
+*                     rest through a small readahead cache
+* 14.00a jmm 10/19/26 Raw boot from a GPT partition or a fixed sector
+*                     (SD_RAW_BOOT), falling back to BOOT.BIN on FAT
 *
 * </pre>
 *
 * @note
+* InitSD maps the clusters of the boot file to runs of contiguous sectors
+* once, so SDAccess neither walks the FAT on a backward seek nor splits a
+* read at every cluster boundary. A file in more than SD_MAX_EXTENTS
+* fragments is read through FatFs as before.
+*
+* The card runs 4-bit and, when it supports it, high speed: the SD driver
+* switches both while it initializes the card (SD_HS_MODE_ENABLE).
+*
+* With SD_RAW_BOOT the boot image may instead sit outside any filesystem:
+* in the GPT partition named SD_RAW_BOOT_PARTITION or, failing that, at
+* sector SD_RAW_BOOT_SECTOR if it is defined. InitSD reads it as a single
+* extent with XSdPs_ReadPolled and never mounts the volume; when neither
+* place holds a boot header it opens the file on FAT as usual.
 *
 ******************************************************************************/
 
@@ -36,18 +54,88 @@
 #endif
 
 #include "xstatus.h"
+#include "xtime_l.h"
+#include "xsdps_hw.h"
 
 #include "ff.h"
+#include "diskio.h"
 #include "sd.h"
 
+#ifdef SD_RAW_BOOT
+#include "xsdps.h"
+#endif
+
 /************************** Constant Definitions *****************************/
 
+#define SD_SECTOR_SIZE		512U
+#define SD_MAX_EXTENTS		16U
+
+/*
+ * Readahead for reads that are not whole aligned sectors (headers,
+ * checksums and the ends of partitions)
+ */
+#ifndef SD_CACHE_SECTORS
+#define SD_CACHE_SECTORS	8U
+#endif
+
+/*
+ * Largest single multi-block read; the driver's ADMA2 table covers 2 MB
+ */
+#define SD_MAX_READ_SECTORS	2048U
+
+#ifdef SD_RAW_BOOT
+#ifndef XPAR_PS7_SD_0_DEVICE_ID
+#define XPAR_PS7_SD_0_DEVICE_ID XPAR_XSDPS_0_DEVICE_ID
+#endif
+
+/*
+ * GPT partition holding the raw boot image, matched on its name
+ */
+#ifndef SD_RAW_BOOT_PARTITION
+#define SD_RAW_BOOT_PARTITION	"zynq-boot"
+#endif
+
+#define GPT_HEADER_SECTOR		1U
+#define GPT_SIGNATURE_LOW		0x20494645U	/* "EFI " */
+#define GPT_SIGNATURE_HIGH		0x54524150U	/* "PART" */
+#define GPT_ENTRY_SECTOR_OFFSET	72U
+#define GPT_ENTRY_COUNT_OFFSET	80U
+#define GPT_ENTRY_SIZE_OFFSET	84U
+#define GPT_ENTRY_FIRST_OFFSET	32U
+#define GPT_ENTRY_LAST_OFFSET	40U
+#define GPT_ENTRY_NAME_OFFSET	56U
+#define GPT_ENTRY_NAME_CHARS	36U
+#define GPT_MAX_ENTRIES			128U
+#define BOOT_WIDTH_DETECT		0xAA995566U
+#endif
+
 /**************************** Type Definitions *******************************/
 
+/*
+ * A run of the boot file in contiguous sectors
+ */
+typedef struct {
+	u32 Offset;		/* file offset of the first byte */
+	u32 Sector;		/* first sector */
+	u32 Sectors;	/* length in sectors */
+} SdExtent;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
 
+static u32 SdMapFile(void);
+static SdExtent *SdFindExtent(u32 Offset);
+static u32 SdFileRead(u32 SourceAddress, u32 DestinationAddress,
+		u32 LengthBytes);
+static u32 SdReadSectors(u32 Sector, u32 Count, u8 *Buffer);
+#ifdef SD_RAW_BOOT
+static u32 SdRawInit(void);
+static u32 SdRawFindPartition(u32 *Start, u32 *Sectors);
+static u32 SdRawCheckImage(u32 Start);
+static u32 SdGetLe32(const u8 *Ptr);
+#endif
+
 /************************** Variable Definitions *****************************/
 
 extern u32 FlashReadBaseAddress;
@@ -58,6 +146,36 @@ static FATFS fatfs;
 static char buffer[32];
 static char *boot_file = buffer;
 
+/*
+ * Sector map of the boot file; empty when it is too fragmented
+ */
+static SdExtent SdExtents[SD_MAX_EXTENTS];
+static u32 SdExtentCount;
+
+/*
+ * Readahead cache
+ */
+static u8 SdCache[SD_CACHE_SECTORS * SD_SECTOR_SIZE] __attribute__((aligned(32)));
+static u32 SdCacheSector;
+static u32 SdCacheCount;
+
+/*
+ * Read statistics, reported by SdReportRate
+ */
+static u32 SdReadBytes;
+static u32 SdDirectBytes;
+static u32 SdCacheHits;
+static u32 SdCacheMisses;
+static XTime SdReadTime;
+
+#ifdef SD_RAW_BOOT
+/*
+ * Card instance of the raw path; FatFs keeps its own for the FAT path
+ */
+static XSdPs SdRawInstance;
+static u8 SdRaw;
+#endif
+
 /******************************************************************************/
 /******************************************************************************/
 /**
@@ -78,6 +196,19 @@ u32 InitSD(const char *filename)
 
 	FRESULT rc;
 	TCHAR *path = "0:/"; /* Logical drive number is 0 */
+	u32 RegVal;
+
+	strcpy_rom(buffer, filename);
+	boot_file = (char *)buffer;
+	FlashReadBaseAddress = XPAR_PS7_SD_0_S_AXI_BASEADDR;
+	SdCacheCount = 0;
+
+#ifdef SD_RAW_BOOT
+	if (SdRawInit() == XST_SUCCESS) {
+		return XST_SUCCESS;
+	}
+	fsbl_printf(DEBUG_INFO,"SD: no raw boot image, using %s\r\n", boot_file);
+#endif
 
 	/* Register volume work area, initialize device */
 	rc = f_mount(&fatfs, path, 0);
@@ -87,20 +218,124 @@ u32 InitSD(const char *filename)
 		return XST_FAILURE;
 	}
 
-	strcpy_rom(buffer, filename);
-	boot_file = (char *)buffer;
-	FlashReadBaseAddress = XPAR_PS7_SD_0_S_AXI_BASEADDR;
-
 	rc = f_open(&fil, boot_file, FA_READ);
 	if (rc) {
 		fsbl_printf(DEBUG_GENERAL,"SD: Unable to open file %s: %d\n", boot_file, rc);
 		return XST_FAILURE;
 	}
 
+	/*
+	 * Bus mode the driver settled on while mounting
+	 */
+	RegVal = XSdPs_ReadReg8(XPAR_PS7_SD_0_S_AXI_BASEADDR,
+			XSDPS_HOST_CTRL1_OFFSET);
+	fsbl_printf(DEBUG_INFO,"SD: %s bit, %s speed\r\n",
+			(RegVal & XSDPS_HC_WIDTH_MASK) ? "4" : "1",
+			(RegVal & XSDPS_HC_SPEED_MASK) ? "high" : "default");
+
+	if (SdMapFile() != XST_SUCCESS) {
+		fsbl_printf(DEBUG_INFO,"SD: %s is fragmented, "
+				"reading through FatFs\r\n", boot_file);
+		SdExtentCount = 0;
+	}
+
 	return XST_SUCCESS;
 
 }
 
+/******************************************************************************/
+/**
+*
+* This function maps the boot file to runs of contiguous sectors by
+* following its cluster chain once
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if the file fits in SD_MAX_EXTENTS runs
+*		- XST_FAILURE otherwise
+*
+* @note		Each seek lands on the first sector boundary past a cluster
+*			start, so FatFs follows one link and reads no data.
+*
+****************************************************************************/
+static u32 SdMapFile(void)
+{
+	SdExtent *Extent = NULL;
+	u32 ClusterBytes;
+	u32 FileSize;
+	u32 Offset;
+	u32 Sector;
+	u32 Sectors;
+
+	SdExtentCount = 0;
+	ClusterBytes = (u32)fatfs.csize * SD_SECTOR_SIZE;
+	FileSize = (u32)fil.obj.objsize;
+
+	for (Offset = 0; Offset < FileSize; Offset += ClusterBytes) {
+		if (f_lseek(&fil, Offset + SD_SECTOR_SIZE) != FR_OK) {
+			return XST_FAILURE;
+		}
+
+		Sector = (u32)fatfs.database +
+				((u32)fil.clust - 2U) * (u32)fatfs.csize;
+		Sectors = (FileSize - Offset + SD_SECTOR_SIZE - 1U) / SD_SECTOR_SIZE;
+		if (Sectors > fatfs.csize) {
+			Sectors = fatfs.csize;
+		}
+
+		if ((Extent != NULL) &&
+				(Extent->Sector + Extent->Sectors == Sector)) {
+			Extent->Sectors += Sectors;
+			continue;
+		}
+
+		if (SdExtentCount == SD_MAX_EXTENTS) {
+			return XST_FAILURE;
+		}
+		Extent = &SdExtents[SdExtentCount++];
+		Extent->Offset = Offset;
+		Extent->Sector = Sector;
+		Extent->Sectors = Sectors;
+	}
+
+	if (f_lseek(&fil, 0) != FR_OK) {
+		return XST_FAILURE;
+	}
+
+	fsbl_printf(DEBUG_INFO,"SD: %s is %lu bytes in %lu extent(s)\r\n",
+			boot_file, FileSize, SdExtentCount);
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function finds the run of the boot file holding a file offset
+*
+* @param	Offset is the file offset
+*
+* @return	The extent, or NULL past the end of the file
+*
+* @note		None.
+*
+****************************************************************************/
+static SdExtent *SdFindExtent(u32 Offset)
+{
+	u32 Index;
+
+	for (Index = 0; Index < SdExtentCount; Index++) {
+		if ((Offset >= SdExtents[Index].Offset) &&
+				(((Offset - SdExtents[Index].Offset) / SD_SECTOR_SIZE) <
+						SdExtents[Index].Sectors)) {
+			return &SdExtents[Index];
+		}
+	}
+
+	return NULL;
+}
+
 /******************************************************************************/
 /**
 *
@@ -115,10 +350,385 @@ u32 InitSD(const char *filename)
 *		- XST_SUCCESS if the write completes correctly
 *		- XST_FAILURE if the write fails to completes correctly
 *
-* @note		None.
+* @note		Whole sectors going to a word aligned destination are read
+*			straight into it, as many at once as the extent allows; the
+*			rest is copied out of the readahead cache. Like f_read, a read
+*			past the end of the file stops short.
 *
 ****************************************************************************/
 u32 SDAccess( u32 SourceAddress, u32 DestinationAddress, u32 LengthBytes)
+{
+	SdExtent *Extent;
+	u32 Sector;
+	u32 Left;
+	u32 Within;
+	u32 Count;
+	u32 Bytes;
+	u32 Status = XST_SUCCESS;
+	XTime tStart;
+	XTime tEnd;
+
+	if (SdExtentCount == 0) {
+		return SdFileRead(SourceAddress, DestinationAddress, LengthBytes);
+	}
+
+	XTime_GetTime(&tStart);
+	SdReadBytes += LengthBytes;
+
+	while (LengthBytes > 0) {
+		Extent = SdFindExtent(SourceAddress);
+		if (Extent == NULL) {
+			break;
+		}
+
+		Sector = (SourceAddress - Extent->Offset) / SD_SECTOR_SIZE;
+		Left = Extent->Sectors - Sector;
+		Sector += Extent->Sector;
+		Within = SourceAddress % SD_SECTOR_SIZE;
+
+		if ((Within == 0) && (LengthBytes >= SD_SECTOR_SIZE) &&
+				((DestinationAddress & 3U) == 0)) {
+			/*
+			 * Multi-block read into the destination
+			 */
+			Count = LengthBytes / SD_SECTOR_SIZE;
+			if (Count > Left) {
+				Count = Left;
+			}
+			if (Count > SD_MAX_READ_SECTORS) {
+				Count = SD_MAX_READ_SECTORS;
+			}
+
+			if (SdReadSectors(Sector, Count,
+					(u8 *)DestinationAddress) != XST_SUCCESS) {
+				fsbl_printf(DEBUG_GENERAL,"SD: read of %lu sectors at %lu "
+						"failed\r\n", Count, Sector);
+				Status = XST_FAILURE;
+				break;
+			}
+
+			Bytes = Count * SD_SECTOR_SIZE;
+			SdDirectBytes += Bytes;
+		} else {
+			/*
+			 * Through the readahead cache
+			 */
+			if ((SdCacheCount == 0) || (Sector < SdCacheSector) ||
+					(Sector >= SdCacheSector + SdCacheCount)) {
+				Count = (Left < SD_CACHE_SECTORS) ? Left : SD_CACHE_SECTORS;
+				SdCacheCount = 0;
+				if (SdReadSectors(Sector, Count, SdCache) != XST_SUCCESS) {
+					fsbl_printf(DEBUG_GENERAL,"SD: readahead at %lu "
+							"failed\r\n", Sector);
+					Status = XST_FAILURE;
+					break;
+				}
+				SdCacheSector = Sector;
+				SdCacheCount = Count;
+				SdCacheMisses++;
+			} else {
+				SdCacheHits++;
+			}
+
+			Bytes = (SdCacheSector + SdCacheCount - Sector) * SD_SECTOR_SIZE -
+					Within;
+			if (Bytes > LengthBytes) {
+				Bytes = LengthBytes;
+			}
+
+			memcpy((void *)DestinationAddress,
+					&SdCache[(Sector - SdCacheSector) * SD_SECTOR_SIZE + Within],
+					Bytes);
+		}
+
+		SourceAddress += Bytes;
+		DestinationAddress += Bytes;
+		LengthBytes -= Bytes;
+	}
+
+	XTime_GetTime(&tEnd);
+	SdReadTime += tEnd - tStart;
+
+	return Status;
+
+} /* End of SDAccess */
+
+/******************************************************************************/
+/**
+*
+* This function reads whole sectors of the card, through the raw instance
+* on the raw path and through FatFs's disk layer otherwise
+*
+* @param	Sector is the first sector
+* @param	Count is the number of sectors
+* @param	Buffer is the word aligned destination
+*
+* @return
+*		- XST_SUCCESS if the read completes
+*		- XST_FAILURE otherwise
+*
+* @note		None.
+*
+****************************************************************************/
+static u32 SdReadSectors(u32 Sector, u32 Count, u8 *Buffer)
+{
+#ifdef SD_RAW_BOOT
+	if (SdRaw) {
+		/*
+		 * Standard capacity cards are byte addressed
+		 */
+		if (SdRawInstance.HCS == 0U) {
+			Sector *= SD_SECTOR_SIZE;
+		}
+
+		if (XSdPs_ReadPolled(&SdRawInstance, Sector, Count, Buffer) !=
+				XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		return XST_SUCCESS;
+	}
+#endif
+
+	if (disk_read(fatfs.pdrv, Buffer, Sector, Count) != RES_OK) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+#ifdef SD_RAW_BOOT
+/******************************************************************************/
+/**
+*
+* This function looks for a raw boot image, first in the GPT partition
+* named SD_RAW_BOOT_PARTITION and then at SD_RAW_BOOT_SECTOR, and maps it
+* as the single extent SDAccess reads
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if a boot image was found
+*		- XST_FAILURE if the card failed or holds no raw image
+*
+* @note		The card is initialized here, without FatFs.
+*
+****************************************************************************/
+static u32 SdRawInit(void)
+{
+	XSdPs_Config *SdConfig;
+	u32 Start = 0;
+	u32 Sectors = 0;
+	u32 Found = XST_FAILURE;
+
+	SdConfig = XSdPs_LookupConfig(XPAR_PS7_SD_0_DEVICE_ID);
+	if (SdConfig == NULL) {
+		return XST_FAILURE;
+	}
+
+	if (XSdPs_CfgInitialize(&SdRawInstance, SdConfig,
+			SdConfig->BaseAddress) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	if (XSdPs_CardInitialize(&SdRawInstance) != XST_SUCCESS) {
+		fsbl_printf(DEBUG_GENERAL,"SD: card initialization failed\r\n");
+		return XST_FAILURE;
+	}
+
+	SdRaw = 1;
+
+	if ((SdRawFindPartition(&Start, &Sectors) == XST_SUCCESS) &&
+			(SdRawCheckImage(Start) == XST_SUCCESS)) {
+		fsbl_printf(DEBUG_INFO,"SD: raw boot from partition %s at "
+				"sector %lu\r\n", SD_RAW_BOOT_PARTITION, Start);
+		Found = XST_SUCCESS;
+	}
+#ifdef SD_RAW_BOOT_SECTOR
+	else if (SdRawCheckImage(SD_RAW_BOOT_SECTOR) == XST_SUCCESS) {
+		Start = SD_RAW_BOOT_SECTOR;
+		Sectors = (SdRawInstance.SectorCount > Start) ?
+				(SdRawInstance.SectorCount - Start) : 0U;
+		fsbl_printf(DEBUG_INFO,"SD: raw boot from sector %lu\r\n", Start);
+		Found = XST_SUCCESS;
+	}
+#endif
+
+	SdCacheCount = 0;
+
+	if ((Found != XST_SUCCESS) || (Sectors == 0U)) {
+		SdRaw = 0;
+		return XST_FAILURE;
+	}
+
+	SdExtents[0].Offset = 0;
+	SdExtents[0].Sector = Start;
+	SdExtents[0].Sectors = Sectors;
+	SdExtentCount = 1;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function finds the GPT partition named SD_RAW_BOOT_PARTITION
+*
+* @param	Start returns the first sector of the partition
+* @param	Sectors returns its length in sectors
+*
+* @return
+*		- XST_SUCCESS if the partition was found
+*		- XST_FAILURE if there is no GPT or no such partition
+*
+* @note		Names compare as ASCII against the UTF-16LE names in the table.
+*			The header and table CRCs are not checked; SdRawCheckImage
+*			checks the boot header of whatever is found.
+*
+****************************************************************************/
+static u32 SdRawFindPartition(u32 *Start, u32 *Sectors)
+{
+	const char *Name = SD_RAW_BOOT_PARTITION;
+	const u8 *Entry;
+	u32 EntrySector;
+	u32 EntryCount;
+	u32 EntrySize;
+	u32 Index;
+	u32 Char;
+	u32 Loaded = 0xFFFFFFFFU;
+	u32 Sector;
+	u32 First;
+	u32 Last;
+
+	if (SdReadSectors(GPT_HEADER_SECTOR, 1U, SdCache) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	if ((SdGetLe32(&SdCache[0]) != GPT_SIGNATURE_LOW) ||
+			(SdGetLe32(&SdCache[4]) != GPT_SIGNATURE_HIGH)) {
+		return XST_FAILURE;
+	}
+
+	EntrySector = SdGetLe32(&SdCache[GPT_ENTRY_SECTOR_OFFSET]);
+	EntryCount = SdGetLe32(&SdCache[GPT_ENTRY_COUNT_OFFSET]);
+	EntrySize = SdGetLe32(&SdCache[GPT_ENTRY_SIZE_OFFSET]);
+
+	if ((EntrySize < 128U) || (EntrySize > SD_SECTOR_SIZE) ||
+			((SD_SECTOR_SIZE % EntrySize) != 0U)) {
+		return XST_FAILURE;
+	}
+	if (EntryCount > GPT_MAX_ENTRIES) {
+		EntryCount = GPT_MAX_ENTRIES;
+	}
+
+	for (Index = 0; Index < EntryCount; Index++) {
+		Sector = EntrySector + (Index * EntrySize) / SD_SECTOR_SIZE;
+		if (Sector != Loaded) {
+			if (SdReadSectors(Sector, 1U, SdCache) != XST_SUCCESS) {
+				return XST_FAILURE;
+			}
+			Loaded = Sector;
+		}
+		Entry = &SdCache[(Index * EntrySize) % SD_SECTOR_SIZE];
+
+		for (Char = 0; Char < GPT_ENTRY_NAME_CHARS; Char++) {
+			if ((Entry[GPT_ENTRY_NAME_OFFSET + 2U * Char] != (u8)Name[Char]) ||
+					(Entry[GPT_ENTRY_NAME_OFFSET + 2U * Char + 1U] != 0U)) {
+				break;
+			}
+			if (Name[Char] == '\0') {
+				break;
+			}
+		}
+		if ((Char == GPT_ENTRY_NAME_CHARS) || (Name[Char] != '\0') ||
+				(Entry[GPT_ENTRY_NAME_OFFSET + 2U * Char] != 0U)) {
+			continue;
+		}
+
+		/*
+		 * Sectors above 2 TB are out of reach of the 32 bit map
+		 */
+		if ((SdGetLe32(&Entry[GPT_ENTRY_FIRST_OFFSET + 4U]) != 0U) ||
+				(SdGetLe32(&Entry[GPT_ENTRY_LAST_OFFSET + 4U]) != 0U)) {
+			return XST_FAILURE;
+		}
+		First = SdGetLe32(&Entry[GPT_ENTRY_FIRST_OFFSET]);
+		Last = SdGetLe32(&Entry[GPT_ENTRY_LAST_OFFSET]);
+		if (Last < First) {
+			return XST_FAILURE;
+		}
+
+		*Start = First;
+		*Sectors = Last - First + 1U;
+		return XST_SUCCESS;
+	}
+
+	return XST_FAILURE;
+}
+
+/******************************************************************************/
+/**
+*
+* This function checks for a boot header at a sector
+*
+* @param	Start is the sector the image would start at
+*
+* @return
+*		- XST_SUCCESS if the width detection word and XLNX are there
+*		- XST_FAILURE otherwise
+*
+* @note		None.
+*
+****************************************************************************/
+static u32 SdRawCheckImage(u32 Start)
+{
+	if (SdReadSectors(Start, 1U, SdCache) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	if ((SdGetLe32(&SdCache[IMAGE_WIDTH_CHECK_OFFSET]) != BOOT_WIDTH_DETECT) ||
+			(SdGetLe32(&SdCache[IMAGE_IDENT_OFFSET]) != IMAGE_IDENT)) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function reads a little endian word from a byte buffer
+*
+* @param	Ptr points at the word
+*
+* @return	The word
+*
+* @note		None.
+*
+****************************************************************************/
+static u32 SdGetLe32(const u8 *Ptr)
+{
+	return (u32)Ptr[0] | ((u32)Ptr[1] << 8) | ((u32)Ptr[2] << 16) |
+			((u32)Ptr[3] << 24);
+}
+#endif
+
+/******************************************************************************/
+/**
+*
+* This function reads the boot file through FatFs, for a file that
+* SdMapFile could not map
+*
+* @param	SourceAddress is the file offset
+* @param	DestinationAddress is the destination address
+* @param	LengthBytes is the number of bytes to move
+*
+* @return	XST_SUCCESS
+*
+* @note		None.
+*
+****************************************************************************/
+static u32 SdFileRead(u32 SourceAddress, u32 DestinationAddress,
+		u32 LengthBytes)
 {
 
 	FRESULT rc;	 /* Result code */
@@ -138,7 +748,7 @@ u32 SDAccess( u32 SourceAddress, u32 DestinationAddress, u32 LengthBytes)
 
 	return XST_SUCCESS;
 
-} /* End of SDAccess */
+}
 
 
 /******************************************************************************/
@@ -155,11 +765,51 @@ u32 SDAccess( u32 SourceAddress, u32 DestinationAddress, u32 LengthBytes)
 ****************************************************************************/
 void ReleaseSD(void) {
 
+#ifdef SD_RAW_BOOT
+	if (SdRaw) {
+		return;
+	}
+#endif
 	f_close(&fil);
 	return;
 
 
 }
+
+/******************************************************************************/
+/**
+*
+* This function prints how fast SDAccess has read so far
+*
+* @param	None
+*
+* @return	None
+*
+* @note	Printed with FSBL_DEBUG_INFO
+*
+****************************************************************************/
+void SdReportRate(void)
+{
+	u32 Us;
+	u32 Rate;
+
+	if (SdReadTime == 0) {
+		return;
+	}
+
+	Us = (u32)((SdReadTime * 1000000U) / COUNTS_PER_SECOND);
+
+	/*
+	 * Tenths of a MB/s
+	 */
+	Rate = (u32)(((u64)SdReadBytes * 10U * COUNTS_PER_SECOND) /
+			(SdReadTime * 1000000U));
+
+	fsbl_printf(DEBUG_INFO, "SD read %lu bytes in %lu us, %lu.%lu MB/s, "
+			"%lu bytes direct, readahead %lu hits %lu misses\r\n",
+			SdReadBytes, Us, Rate / 10, Rate % 10,
+			SdDirectBytes, SdCacheHits, SdCacheMisses);
+}
 #endif
 
 
@@ -17,6 +17,7 @@
 * ----- ---- -------- -------------------------------------------------------
 * 1.00a bh	03/10/11 Initial release
 * 7.00a kc  10/18/13 Integrated SD/MMC driver
+* 13.00a jmm 10/19/26 SdReportRate
 *
 * </pre>
 *
@@ -42,6 +43,8 @@ u32 SDAccess( u32 SourceAddress,
 		u32 LengthWords);
 
 void ReleaseSD(void);
+
+void SdReportRate(void);
 #endif
 /************************** Variable Definitions *****************************/
 #ifdef __cplusplus
@@ -0,0 +1,319 @@
+/******************************************************************************
+* Copyright (c) 2026 Joshua M. Meise
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file sha256.c
+*
+* Contains the SHA-256 (FIPS 180-4) used for partition authentication
+*
+* Whole blocks are hashed where they are, without the copy into the
+* context the library makes, and the rounds are unrolled sixteen at a time
+* so the message schedule stays in a sixteen word window with constant
+* indices. Only a partial block at either end of an update is buffered.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a jmm	10/19/26	Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <string.h>
+#include "sha256.h"
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define ROR(x, n)		(((x) >> (n)) | ((x) << (32 - (n))))
+#define CH(x, y, z)		((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x, y, z)	(((x) & (y)) | ((z) & ((x) | (y))))
+#define SIGMA0(x)		(ROR(x, 2) ^ ROR(x, 13) ^ ROR(x, 22))
+#define SIGMA1(x)		(ROR(x, 6) ^ ROR(x, 11) ^ ROR(x, 25))
+#define GAMMA0(x)		(ROR(x, 7) ^ ROR(x, 18) ^ ((x) >> 3))
+#define GAMMA1(x)		(ROR(x, 17) ^ ROR(x, 19) ^ ((x) >> 10))
+
+/*
+ * Big-endian word at any alignment; the compiler makes this a load and a
+ * byte reverse where unaligned loads are allowed
+ */
+#define SHA256_BE32(p)	(((u32)(p)[0] << 24) | ((u32)(p)[1] << 16) | \
+						((u32)(p)[2] << 8) | (u32)(p)[3])
+
+/*
+ * One round; the caller rotates the roles of a to h instead of moving
+ * the working variables
+ */
+#define ROUND(a, b, c, d, e, f, g, h, w, k)							\
+	do {															\
+		T1 = (h) + SIGMA1(e) + CH(e, f, g) + (k) + (w);				\
+		(d) += T1;													\
+		(h) = T1 + SIGMA0(a) + MAJ(a, b, c);						\
+	} while (0)
+
+/*
+ * Next schedule word in place in the sixteen word window
+ */
+#define SCHEDULE(i)	(W[(i) & 15] += GAMMA1(W[((i) - 2) & 15]) +		\
+						W[((i) - 7) & 15] + GAMMA0(W[((i) - 15) & 15]))
+
+#define ROUNDS_16(K, WORD)											\
+	do {															\
+		ROUND(A, B, C, D, E, F, G, H, WORD(0), (K)[0]);				\
+		ROUND(H, A, B, C, D, E, F, G, WORD(1), (K)[1]);				\
+		ROUND(G, H, A, B, C, D, E, F, WORD(2), (K)[2]);				\
+		ROUND(F, G, H, A, B, C, D, E, WORD(3), (K)[3]);				\
+		ROUND(E, F, G, H, A, B, C, D, WORD(4), (K)[4]);				\
+		ROUND(D, E, F, G, H, A, B, C, WORD(5), (K)[5]);				\
+		ROUND(C, D, E, F, G, H, A, B, WORD(6), (K)[6]);				\
+		ROUND(B, C, D, E, F, G, H, A, WORD(7), (K)[7]);				\
+		ROUND(A, B, C, D, E, F, G, H, WORD(8), (K)[8]);				\
+		ROUND(H, A, B, C, D, E, F, G, WORD(9), (K)[9]);				\
+		ROUND(G, H, A, B, C, D, E, F, WORD(10), (K)[10]);			\
+		ROUND(F, G, H, A, B, C, D, E, WORD(11), (K)[11]);			\
+		ROUND(E, F, G, H, A, B, C, D, WORD(12), (K)[12]);			\
+		ROUND(D, E, F, G, H, A, B, C, WORD(13), (K)[13]);			\
+		ROUND(C, D, E, F, G, H, A, B, WORD(14), (K)[14]);			\
+		ROUND(B, C, D, E, F, G, H, A, WORD(15), (K)[15]);			\
+	} while (0)
+
+#define LOAD_WORD(i)	(W[i] = SHA256_BE32(Data + 4 * (i)))
+#define NEXT_WORD(i)	SCHEDULE((i) + 16)
+
+/************************** Function Prototypes ******************************/
+
+static void Sha256Blocks(u32 *State, const u8 *Data, u32 Blocks);
+
+/************************** Variable Definitions *****************************/
+
+static const u32 Sha256K[64] = {
+	0x428A2F98U, 0x71374491U, 0xB5C0FBCFU, 0xE9B5DBA5U,
+	0x3956C25BU, 0x59F111F1U, 0x923F82A4U, 0xAB1C5ED5U,
+	0xD807AA98U, 0x12835B01U, 0x243185BEU, 0x550C7DC3U,
+	0x72BE5D74U, 0x80DEB1FEU, 0x9BDC06A7U, 0xC19BF174U,
+	0xE49B69C1U, 0xEFBE4786U, 0x0FC19DC6U, 0x240CA1CCU,
+	0x2DE92C6FU, 0x4A7484AAU, 0x5CB0A9DCU, 0x76F988DAU,
+	0x983E5152U, 0xA831C66DU, 0xB00327C8U, 0xBF597FC7U,
+	0xC6E00BF3U, 0xD5A79147U, 0x06CA6351U, 0x14292967U,
+	0x27B70A85U, 0x2E1B2138U, 0x4D2C6DFCU, 0x53380D13U,
+	0x650A7354U, 0x766A0ABBU, 0x81C2C92EU, 0x92722C85U,
+	0xA2BFE8A1U, 0xA81A664BU, 0xC24B8B70U, 0xC76C51A3U,
+	0xD192E819U, 0xD6990624U, 0xF40E3585U, 0x106AA070U,
+	0x19A4C116U, 0x1E376C08U, 0x2748774CU, 0x34B0BCB5U,
+	0x391C0CB3U, 0x4ED8AA4AU, 0x5B9CCA4FU, 0x682E6FF3U,
+	0x748F82EEU, 0x78A5636FU, 0x84C87814U, 0x8CC70208U,
+	0x90BEFFFAU, 0xA4506CEBU, 0xBEF9A3F7U, 0xC67178F2U
+};
+
+/******************************************************************************/
+/**
+*
+* This function starts a hash
+*
+* @param	Context is the hash state to initialise
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+void Sha256Init(Sha256Context *Context)
+{
+	Context->State[0] = 0x6A09E667U;
+	Context->State[1] = 0xBB67AE85U;
+	Context->State[2] = 0x3C6EF372U;
+	Context->State[3] = 0xA54FF53AU;
+	Context->State[4] = 0x510E527FU;
+	Context->State[5] = 0x9B05688CU;
+	Context->State[6] = 0x1F83D9ABU;
+	Context->State[7] = 0x5BE0CD19U;
+	Context->Length = 0;
+	Context->LengthHigh = 0;
+}
+
+/******************************************************************************/
+/**
+*
+* This function adds the next piece of the message to a hash. Pieces may be
+* of any length and alignment.
+*
+* @param	Context is the hash state
+* @param	Data is the next piece of the message
+* @param	Length is its length in bytes
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+void Sha256Update(Sha256Context *Context, const u8 *Data, u32 Length)
+{
+	u32 Fill = Context->Length & (SHA256_BLOCK_SIZE - 1);
+	u32 Take;
+
+	Context->Length += Length;
+	if (Context->Length < Length) {
+		Context->LengthHigh++;
+	}
+
+	/*
+	 * Complete a block left over from the last update
+	 */
+	if (Fill != 0) {
+		Take = SHA256_BLOCK_SIZE - Fill;
+		if (Length < Take) {
+			memcpy(&Context->Buffer[Fill], Data, Length);
+			return;
+		}
+		memcpy(&Context->Buffer[Fill], Data, Take);
+		Sha256Blocks(Context->State, Context->Buffer, 1);
+		Data += Take;
+		Length -= Take;
+	}
+
+	/*
+	 * Whole blocks straight from the message
+	 */
+	if (Length >= SHA256_BLOCK_SIZE) {
+		Sha256Blocks(Context->State, Data, Length / SHA256_BLOCK_SIZE);
+		Data += Length & ~(SHA256_BLOCK_SIZE - 1);
+		Length &= SHA256_BLOCK_SIZE - 1;
+	}
+
+	if (Length != 0) {
+		memcpy(Context->Buffer, Data, Length);
+	}
+}
+
+/******************************************************************************/
+/**
+*
+* This function pads the message and gives the hash
+*
+* @param	Context is the hash state; it must be initialised again before
+*			it is reused
+* @param	Hash is where the SHA256_HASH_SIZE byte hash goes
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+void Sha256Final(Sha256Context *Context, u8 *Hash)
+{
+	u32 Fill = Context->Length & (SHA256_BLOCK_SIZE - 1);
+	u32 BitsHigh = (Context->LengthHigh << 3) | (Context->Length >> 29);
+	u32 BitsLow = Context->Length << 3;
+	u32 Index;
+
+	Context->Buffer[Fill++] = 0x80;
+
+	/*
+	 * The bit length takes the last eight bytes of a block
+	 */
+	if (Fill > (SHA256_BLOCK_SIZE - 8)) {
+		memset(&Context->Buffer[Fill], 0, SHA256_BLOCK_SIZE - Fill);
+		Sha256Blocks(Context->State, Context->Buffer, 1);
+		Fill = 0;
+	}
+	memset(&Context->Buffer[Fill], 0, (SHA256_BLOCK_SIZE - 8) - Fill);
+
+	for (Index = 0; Index < 4; Index++) {
+		Context->Buffer[56 + Index] = (u8)(BitsHigh >> (24 - 8 * Index));
+		Context->Buffer[60 + Index] = (u8)(BitsLow >> (24 - 8 * Index));
+	}
+	Sha256Blocks(Context->State, Context->Buffer, 1);
+
+	for (Index = 0; Index < SHA256_HASH_SIZE; Index++) {
+		Hash[Index] = (u8)(Context->State[Index >> 2] >>
+					(24 - 8 * (Index & 3)));
+	}
+}
+
+/******************************************************************************/
+/**
+*
+* This function hashes a message held in memory
+*
+* @param	Data is the message
+* @param	Length is its length in bytes
+* @param	Hash is where the SHA256_HASH_SIZE byte hash goes
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+void Sha256(const u8 *Data, u32 Length, u8 *Hash)
+{
+	Sha256Context Context;
+
+	Sha256Init(&Context);
+	Sha256Update(&Context, Data, Length);
+	Sha256Final(&Context, Hash);
+}
+
+/******************************************************************************/
+/**
+*
+* This function runs the compression function over whole blocks
+*
+* @param	State is the hash state
+* @param	Data is the first block, at any alignment
+* @param	Blocks is the number of blocks
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void Sha256Blocks(u32 *State, const u8 *Data, u32 Blocks)
+{
+	u32 A, B, C, D, E, F, G, H;
+	u32 T1;
+	u32 W[16];
+	const u32 *K;
+
+	while (Blocks-- > 0) {
+		A = State[0];
+		B = State[1];
+		C = State[2];
+		D = State[3];
+		E = State[4];
+		F = State[5];
+		G = State[6];
+		H = State[7];
+
+		/*
+		 * Rounds 0 to 15 take the message words, the rest the schedule
+		 */
+		ROUNDS_16(Sha256K, LOAD_WORD);
+		for (K = &Sha256K[16]; K < &Sha256K[64]; K += 16) {
+			ROUNDS_16(K, NEXT_WORD);
+		}
+
+		State[0] += A;
+		State[1] += B;
+		State[2] += C;
+		State[3] += D;
+		State[4] += E;
+		State[5] += F;
+		State[6] += G;
+		State[7] += H;
+
+		Data += SHA256_BLOCK_SIZE;
+	}
+}
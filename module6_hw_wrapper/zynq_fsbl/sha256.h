@@ -0,0 +1,66 @@
+/******************************************************************************
+* Copyright (c) 2026 Joshua M. Meise
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file sha256.h
+*
+* Contains the context and the prototypes required by sha256.c
+*
+* The hash is streamed: Sha256Update takes the partition in whatever pieces
+* it is loaded in, so it can run on each chunk while the chunk is still in
+* the cache instead of in a second pass over DDR.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a jmm	10/19/26	Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#ifndef ___SHA256_H___
+#define ___SHA256_H___
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+
+#define SHA256_BLOCK_SIZE		64U
+#define SHA256_HASH_SIZE		32U
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u32 State[8];
+	u32 Length;						/* bytes hashed, low word */
+	u32 LengthHigh;					/* bytes hashed, high word */
+	u8 Buffer[SHA256_BLOCK_SIZE];	/* partial block */
+} Sha256Context;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+void Sha256Init(Sha256Context *Context);
+void Sha256Update(Sha256Context *Context, const u8 *Data, u32 Length);
+void Sha256Final(Sha256Context *Context, u8 *Hash);
+void Sha256(const u8 *Data, u32 Length, u8 *Hash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ___SHA256_H___ */
@@ -133,6 +133,10 @@
 * 3.5   ms  04/18/17 Modified tcl file to add suffix U for all macros
 *                    definitions of devcfg in xparameters.h
 *       ms  08/07/17 Fixed compilation warnings in xdevcfg_sinit.c
+* 3.8   jmm 10/19/26 Added XDcfg_TransferAsync and its completion handler,
+*		     XDcfg_TransferPoll, XDcfg_TransferWait and
+*		     XDcfg_TransferCancel so PCAP DMA can complete from the
+*		     devcfg interrupt instead of being polled.
 * </pre>
 *
 ******************************************************************************/
@@ -159,6 +163,15 @@ extern "C" {
 #define XDCFG_CONCURRENT_SECURE_READ_WRITE	4
 #define XDCFG_CONCURRENT_NONSEC_READ_WRITE	5
 
+/*
+ * Events that complete an asynchronous transfer: the DMA alone, the DMA
+ * and the PCAP, or for a full bitstream also the fabric DONE signal
+ */
+#define XDCFG_ASYNC_DMA_DONE		XDCFG_IXR_DMA_DONE_MASK
+#define XDCFG_ASYNC_D_P_DONE		XDCFG_IXR_D_P_DONE_MASK
+#define XDCFG_ASYNC_PCFG_DONE		(XDCFG_IXR_DMA_DONE_MASK | \
+					XDCFG_IXR_PCFG_DONE_MASK)
+
 
 /**************************** Type Definitions *******************************/
 /**
@@ -174,6 +187,21 @@ extern "C" {
 */
 typedef void (*XDcfg_IntrHandler) (void *CallBackRef, u32 Status);
 
+/**
+* The completion handler of an asynchronous transfer. It is called once per
+* transfer, from the interrupt handler or from the function that polled or
+* cancelled the transfer, so the amount of processing should be minimized.
+*
+* @param	CallBackRef is the reference passed to XDcfg_SetDoneHandler.
+* @param	Status is XST_SUCCESS when every completion event was seen,
+*		XST_FAILURE when an error event was seen first and XST_TIMEOUT
+*		when the transfer was cancelled or XDcfg_TransferWait ran out.
+* @param	IntrStatus is the interrupt events seen during the transfer;
+*		on XST_FAILURE it includes the error bits.
+*/
+typedef void (*XDcfg_DoneHandler) (void *CallBackRef, u32 Status,
+					u32 IntrStatus);
+
 /**
  * This typedef contains configuration information for the device.
  */
@@ -193,6 +221,13 @@ typedef struct {
 				  */
 	XDcfg_IntrHandler StatusHandler;  /* Event handler function */
 	void *CallBackRef;	/* Callback reference for event handler */
+	XDcfg_DoneHandler DoneHandler;	/* Asynchronous transfer completion */
+	void *DoneRef;		/* Callback reference for DoneHandler */
+	u32 AsyncErrorMask;	/* Events that fail a transfer */
+	u32 AsyncDoneMask;	/* Events that complete the pending transfer */
+	volatile u32 AsyncEvents;	/* Events seen so far */
+	volatile u32 AsyncPending;	/* An asynchronous transfer is running */
+	volatile u32 AsyncStatus;	/* Result of the last asynchronous transfer */
 } XDcfg;
 
 /****************************************************************************/
@@ -291,6 +326,40 @@ typedef struct {
 	((XDcfg_ReadReg((InstancePtr)->Config.BaseAddr, XDCFG_CTRL_OFFSET))  \
 	| XDCFG_CTRL_PCAP_PR_MASK))
 
+/****************************************************************************/
+/**
+*
+* Select the interrupt events that fail an asynchronous transfer. The default
+* is XDCFG_IXR_ERROR_FLAGS_MASK.
+*
+* @param	InstancePtr is a pointer to the instance of XDcfg driver.
+* @param	Mask is formed by OR'ing XDCFG_IXR_* error bits.
+*
+* @return	None.
+*
+* @note		C-style signature:
+*		void XDcfg_SetAsyncErrorMask(XDcfg* InstancePtr, u32 Mask)
+*
+*****************************************************************************/
+#define XDcfg_SetAsyncErrorMask(InstancePtr, Mask)			\
+	((InstancePtr)->AsyncErrorMask = (Mask))
+
+/****************************************************************************/
+/**
+*
+* Tell whether an asynchronous transfer is still running.
+*
+* @param	InstancePtr is a pointer to the instance of XDcfg driver.
+*
+* @return	1 while the transfer runs, 0 once its handler has been called.
+*
+* @note		C-style signature:
+*		u32 XDcfg_IsTransferPending(XDcfg* InstancePtr)
+*
+*****************************************************************************/
+#define XDcfg_IsTransferPending(InstancePtr)				\
+	((InstancePtr)->AsyncPending)
+
 
 
 /************************** Function Prototypes ******************************/
@@ -369,6 +438,20 @@ void XDcfg_InterruptHandler(XDcfg *InstancePtr);
 void XDcfg_SetHandler(XDcfg *InstancePtr, void *CallBackFunc,
 				void *CallBackRef);
 
+void XDcfg_SetDoneHandler(XDcfg *InstancePtr, void *CallBackFunc,
+				void *CallBackRef);
+
+u32 XDcfg_TransferAsync(XDcfg *InstancePtr,
+				void *SourcePtr, u32 SrcWordLength,
+				void *DestPtr, u32 DestWordLength,
+				u32 TransferType, u32 DoneMask);
+
+u32 XDcfg_TransferPoll(XDcfg *InstancePtr);
+
+u32 XDcfg_TransferWait(XDcfg *InstancePtr, u32 MaxCount);
+
+u32 XDcfg_TransferCancel(XDcfg *InstancePtr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,6 +20,7 @@
 * 1.00a sdm  07/11/11 First release
 * 4.2	pkp	 07/21/14 Corrected reset value of event counter in function
 *					  Xpm_ResetEventCounters to fix CR#796275
+* 7.6   jmm  10/19/26 Added named profiling regions.
 * </pre>
 *
 ******************************************************************************/
@@ -27,9 +28,16 @@
 /***************************** Include Files *********************************/
 
 #include "xpm_counter.h"
+#include "xil_printf.h"
 
 /************************** Constant Definitions ****************************/
 
+/* Empty passes used to measure the cost of a region */
+#define XPM_REGION_CALIBRATE	16U
+
+/* Cycles a whole begin/end pair should cost */
+#define XPM_REGION_TARGET	30U
+
 /**************************** Type Definitions ******************************/
 
 typedef const u32 PmcrEventCfg32[XPM_CTRCOUNT];
@@ -38,6 +46,10 @@ typedef const u32 PmcrEventCfg32[XPM_CTRCOUNT];
 
 /************************** Variable Definitions *****************************/
 
+static XpmRegion *XpmRegionList;
+static u32 XpmRegionOverhead[XPM_REGION_EVENTS];
+static u32 XpmRegionCost;
+
 /************************** Function Prototypes ******************************/
 
 void Xpm_DisableEventCounters(void);
@@ -253,3 +265,199 @@ void Xpm_GetEventCounters(u32 *PmCtrValue)
 #endif
 	}
 }
+
+/****************************************************************************/
+/**
+*
+* @brief	Sets up the counters used by the profiling regions and times
+*			empty passes through Xpm_RegionBegin and Xpm_RegionEnd, as the
+*			macros make them. What an empty region records is subtracted
+*			from every pass; the cost of the whole pair, accumulation
+*			included, is kept for Xpm_RegionReport. Event counters 3-5 are
+*			left alone.
+*
+* @return	None.
+*
+*****************************************************************************/
+void Xpm_RegionInit(void)
+{
+	static const u32 Events[XPM_REGION_EVENTS - 1U] = {
+		XPM_EVENT_INSTRRENAME,
+		XPM_EVENT_DATA_CACHEREFILL,
+		XPM_EVENT_BRANCHMISS
+	};
+	static XpmRegion Empty = { "xpm_empty" };
+	XpmRegion *Region;
+	u32 Counter;
+	u32 Pass;
+	u32 Before;
+	u32 Cost;
+
+	mtcp(XREG_CP15_COUNT_ENABLE_CLR, 0x80000007U);
+	for(Counter = 0U; Counter < (XPM_REGION_EVENTS - 1U); Counter++) {
+		mtcp(XREG_CP15_EVENT_CNTR_SEL, Counter);
+		mtcp(XREG_CP15_EVENT_TYPE_SEL, Events[Counter]);
+	}
+	/* Enable the unit with the cycle counter undivided */
+	mtcp(XREG_CP15_PERF_MONITOR_CTRL,
+		(mfcp(XREG_CP15_PERF_MONITOR_CTRL) | 0x1U) & ~0x8U);
+	mtcp(XREG_CP15_COUNT_ENABLE_SET, 0x80000007U);
+	isb();
+
+	for(Counter = 0U; Counter < XPM_REGION_EVENTS; Counter++) {
+		XpmRegionOverhead[Counter] = 0U;
+	}
+	Empty.Count = 0U;
+	XpmRegionCost = 0xFFFFFFFFU;
+	for(Pass = 0U; Pass < XPM_REGION_CALIBRATE; Pass++) {
+		Before = mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+		Xpm_RegionBegin(&Empty);
+		Xpm_RegionEnd(&Empty);
+		Cost = mfcp(XREG_CP15_PERF_CYCLE_COUNTER) - Before;
+		if (Cost < XpmRegionCost) {
+			XpmRegionCost = Cost;
+		}
+	}
+	for(Counter = 0U; Counter < XPM_REGION_EVENTS; Counter++) {
+		XpmRegionOverhead[Counter] = Empty.Min[Counter];
+	}
+
+	/* Keep the calibration region out of the report */
+	if (XpmRegionList == &Empty) {
+		XpmRegionList = Empty.Next;
+	} else {
+		for(Region = XpmRegionList; Region != NULL; Region = Region->Next) {
+			if (Region->Next == &Empty) {
+				Region->Next = Empty.Next;
+				break;
+			}
+		}
+	}
+	Empty.Linked = 0U;
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Adds a pass to a profiling region. Called by Xpm_RegionEnd with
+*			the counters read at the end of the pass.
+*
+* @param	Region: The region.
+* @param	Now: Counters at the end of the pass.
+*
+* @return	None.
+*
+*****************************************************************************/
+void Xpm_RegionAccumulate(XpmRegion *Region, const u32 *Now)
+{
+	u32 Counter;
+	u32 Delta;
+	u32 Cpsr;
+
+	/* First pass: make the region visible to the report */
+	if (Region->Linked == 0U) {
+		Cpsr = mfcpsr();
+		mtcpsr(Cpsr | XREG_CPSR_IRQ_ENABLE | XREG_CPSR_FIQ_ENABLE);
+		if (Region->Linked == 0U) {
+			Region->Next = XpmRegionList;
+			XpmRegionList = Region;
+			Region->Linked = 1U;
+		}
+		mtcpsr(Cpsr);
+	}
+
+	for(Counter = 0U; Counter < XPM_REGION_EVENTS; Counter++) {
+		Delta = Now[Counter] - Region->Start[Counter];
+		Delta = (Delta > XpmRegionOverhead[Counter]) ?
+				(Delta - XpmRegionOverhead[Counter]) : 0U;
+		if ((Region->Count == 0U) || (Delta < Region->Min[Counter])) {
+			Region->Min[Counter] = Delta;
+		}
+		if ((Region->Count == 0U) || (Delta > Region->Max[Counter])) {
+			Region->Max[Counter] = Delta;
+		}
+		Region->Sum[Counter] += Delta;
+	}
+	Region->Count++;
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Clears the statistics of every region that has run.
+*
+* @return	None.
+*
+*****************************************************************************/
+void Xpm_RegionReset(void)
+{
+	XpmRegion *Region;
+	u32 Counter;
+
+	for(Region = XpmRegionList; Region != NULL; Region = Region->Next) {
+		Region->Count = 0U;
+		for(Counter = 0U; Counter < XPM_REGION_EVENTS; Counter++) {
+			Region->Sum[Counter] = 0U;
+		}
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Prints every region that has run, most total cycles first: the
+*			pass count, total kilocycles, min/mean/max cycles and the mean
+*			instructions, data cache refills and mispredicted branches per
+*			pass. At most XPM_REGION_MAX regions are printed, after the
+*			cycles subtracted from each pass and the cost of a begin/end
+*			pair measured by Xpm_RegionInit.
+*
+* @return	None.
+*
+*****************************************************************************/
+void Xpm_RegionReport(void)
+{
+	XpmRegion *Sorted[XPM_REGION_MAX];
+	XpmRegion *Region;
+	u32 Num;
+	u32 Index;
+	u32 Slot;
+
+	/* Insertion sort on total cycles, largest first */
+	Num = 0U;
+	for(Region = XpmRegionList; Region != NULL; Region = Region->Next) {
+		if (Region->Count == 0U) {
+			continue;
+		}
+		for(Slot = Num; (Slot > 0U) &&
+				(Sorted[Slot - 1U]->Sum[XPM_REGION_CYCLES] <
+				 Region->Sum[XPM_REGION_CYCLES]); Slot--) {
+			if (Slot < XPM_REGION_MAX) {
+				Sorted[Slot] = Sorted[Slot - 1U];
+			}
+		}
+		if (Slot < XPM_REGION_MAX) {
+			Sorted[Slot] = Region;
+		}
+		if (Num < XPM_REGION_MAX) {
+			Num++;
+		}
+	}
+
+	xil_printf("[xpm overhead %u cycles pair %u cycles%s]\r\n",
+		XpmRegionOverhead[XPM_REGION_CYCLES], XpmRegionCost,
+		(XpmRegionCost > XPM_REGION_TARGET) ? " over target" : "");
+	xil_printf("[xpm region count kcycles min mean max instr dmiss brmiss]\r\n");
+	for(Index = 0U; Index < Num; Index++) {
+		Region = Sorted[Index];
+		xil_printf("[xpm %s %u %u %u %u %u %u %u %u]\r\n", Region->Name,
+			Region->Count,
+			(u32)(Region->Sum[XPM_REGION_CYCLES] / 1000U),
+			Region->Min[XPM_REGION_CYCLES],
+			(u32)(Region->Sum[XPM_REGION_CYCLES] / Region->Count),
+			Region->Max[XPM_REGION_CYCLES],
+			(u32)(Region->Sum[XPM_REGION_INSTRS] / Region->Count),
+			(u32)(Region->Sum[XPM_REGION_DMISS] / Region->Count),
+			(u32)(Region->Sum[XPM_REGION_BRMISS] / Region->Count));
+	}
+}
@@ -81,6 +81,43 @@ struct gmonparam {
 extern struct gmonparam *_gmonparam;
 extern s32 n_gmon_sections;
 
+/*
+ * Call-graph arcs are counted in a hash table keyed on (frompc, selfpc)
+ * and copied into the froms/tos lists read by the debugger when
+ * they are flushed: PROFILE_CG_FLUSH_SLOTS slots on every profiling timer
+ * tick, so a target that never exits still has a call graph when it is
+ * halted, and the whole table at exit from _profile_clean. The table size
+ * must be a power of two; an arc that cannot be placed within
+ * PROFILE_CG_PROBES slots is dropped and counted as an overflow.
+ */
+#ifndef PROFILE_CG_SLOTS
+#define PROFILE_CG_SLOTS	2048U
+#endif
+#ifndef PROFILE_CG_PROBES
+#define PROFILE_CG_PROBES	8U
+#endif
+#ifndef PROFILE_CG_FLUSH_SLOTS
+#define PROFILE_CG_FLUSH_SLOTS	4U
+#endif
+
+struct cgslot {
+	u32  frompc;	/* 0: free */
+	u32  selfpc;
+	u32  count;
+};
+
+struct cgstats {
+	u32  arcs;		/* slots in use */
+	u32  overflows;	/* calls dropped: no slot within PROFILE_CG_PROBES */
+	u32  outside;	/* calls from outside every profiled section */
+	u32  maxprobe;	/* longest probe sequence seen */
+	u32  tosfull;	/* arcs the flush dropped: froms/tos links are 16 bits */
+};
+
+void profile_cg_flush( void );
+void profile_cg_flush_step( void );
+void profile_cg_stats( struct cgstats *stats );
+
 /*
  * Possible states of profiling.
  */
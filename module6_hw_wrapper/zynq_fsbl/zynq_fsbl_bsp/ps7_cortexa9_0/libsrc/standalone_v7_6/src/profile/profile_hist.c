@@ -40,6 +40,10 @@ void profile_intr_handler( void )
 			break;
 		}
 	}
+#ifndef PROFILE_NO_GRAPH
+	/* Keep the froms/tos lists current for a debugger halt, a few slots a tick */
+	profile_cg_flush_step() ;
+#endif
 	/* Ack the Timer Interrupt */
 	timer_ack();
 }
@@ -18,9 +18,19 @@
 * configurations XPM_CNTRCFGx which can be used to program the event counters
 * to count a set of events.
 *
+* Named profiling regions are built on top of the counters. A region is
+* defined with XPM_REGION_DEFINE and bracketed with XPM_REGION_BEGIN and
+* XPM_REGION_END; each one accumulates cycles, instructions, data cache
+* refills and mispredicted branches, and keeps their minimum, maximum and
+* mean per pass. Xpm_RegionReport prints every region that has run, sorted
+* by total cycles. The macros expand to nothing unless the application is
+* built with -DXPM_REGIONS.
+*
 * @note
-* It doesn't handle the Cortex-A9 cycle counter, as the cycle counter is
-* being used for time keeping.
+* Xpm_SetEvents doesn't handle the Cortex-A9 cycle counter; the profiling
+* regions use it, as time keeping uses the global timer. Regions may nest
+* but may not recurse, and a region interrupted by a handler includes the
+* handler's events.
 *
 * @{
 *
@@ -31,6 +41,7 @@
 * ----- ---- -------- -----------------------------------------------
 * 1.00a sdm  07/11/11 First release
 * 6.8   aru  09/06/18 Removed compilation warnings for ARMCC toolchain.
+* 7.6   jmm  10/19/26 Added named profiling regions (Xpm_Region*).
 * </pre>
 *
 ******************************************************************************/
@@ -532,10 +543,46 @@ extern "C" {
 #define XPM_CNTRCFG10	9
 #define XPM_CNTRCFG11	10
 
+/* Events accumulated by a profiling region */
+#define XPM_REGION_CYCLES	0U	/* cycle counter */
+#define XPM_REGION_INSTRS	1U	/* XPM_EVENT_INSTRRENAME */
+#define XPM_REGION_DMISS	2U	/* XPM_EVENT_DATA_CACHEREFILL */
+#define XPM_REGION_BRMISS	3U	/* XPM_EVENT_BRANCHMISS */
+#define XPM_REGION_EVENTS	4U
+
+/* Most regions Xpm_RegionReport sorts */
+#define XPM_REGION_MAX		32U
+
 /**************************** Type Definitions ******************************/
 
+/* A named profiling region */
+typedef struct XpmRegion {
+	const char *Name;
+	struct XpmRegion *Next;			/* regions that have run */
+	u32 Linked;
+	u32 Count;				/* completed passes */
+	u32 Start[XPM_REGION_EVENTS];
+	u32 Min[XPM_REGION_EVENTS];
+	u32 Max[XPM_REGION_EVENTS];
+	u64 Sum[XPM_REGION_EVENTS];
+} XpmRegion;
+
 /***************** Macros (Inline Functions) Definitions ********************/
 
+#ifdef XPM_REGIONS
+#define XPM_REGION_DEFINE(Name)	static XpmRegion XpmRegion_##Name = { #Name }
+#define XPM_REGION_INIT()	Xpm_RegionInit()
+#define XPM_REGION_BEGIN(Name)	Xpm_RegionBegin(&XpmRegion_##Name)
+#define XPM_REGION_END(Name)	Xpm_RegionEnd(&XpmRegion_##Name)
+#define XPM_REGION_REPORT()	Xpm_RegionReport()
+#else
+#define XPM_REGION_DEFINE(Name)	extern XpmRegion XpmRegion_##Name
+#define XPM_REGION_INIT()
+#define XPM_REGION_BEGIN(Name)
+#define XPM_REGION_END(Name)
+#define XPM_REGION_REPORT()
+#endif
+
 /************************** Variable Definitions ****************************/
 
 /**
@@ -548,6 +595,72 @@ extern "C" {
 void Xpm_SetEvents(s32 PmcrCfg);
 void Xpm_GetEventCounters(u32 *PmCtrValue);
 
+/* Profiling regions */
+void Xpm_RegionInit(void);
+void Xpm_RegionAccumulate(XpmRegion *Region, const u32 *Now);
+void Xpm_RegionReset(void);
+void Xpm_RegionReport(void);
+
+/****************************************************************************/
+/**
+*
+* @brief	Reads the region events: event counters 0-2 and the cycle counter.
+*
+* @param	Ctr: Array of XPM_REGION_EVENTS values to fill.
+*
+* @return	None.
+*
+*****************************************************************************/
+static inline void Xpm_RegionRead(u32 *Ctr)
+{
+	mtcp(XREG_CP15_EVENT_CNTR_SEL, 0U);
+	Ctr[XPM_REGION_INSTRS] = mfcp(XREG_CP15_PERF_MONITOR_COUNT);
+	mtcp(XREG_CP15_EVENT_CNTR_SEL, 1U);
+	Ctr[XPM_REGION_DMISS] = mfcp(XREG_CP15_PERF_MONITOR_COUNT);
+	mtcp(XREG_CP15_EVENT_CNTR_SEL, 2U);
+	Ctr[XPM_REGION_BRMISS] = mfcp(XREG_CP15_PERF_MONITOR_COUNT);
+	Ctr[XPM_REGION_CYCLES] = mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Starts a pass through a profiling region.
+*
+* @param	Region: The region.
+*
+* @return	None.
+*
+*****************************************************************************/
+static inline void Xpm_RegionBegin(XpmRegion *Region)
+{
+	Xpm_RegionRead(Region->Start);
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Ends a pass through a profiling region and accumulates it.
+*
+* @param	Region: The region.
+*
+* @return	None.
+*
+*****************************************************************************/
+static inline void Xpm_RegionEnd(XpmRegion *Region)
+{
+	u32 Now[XPM_REGION_EVENTS];
+
+	Now[XPM_REGION_CYCLES] = mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+	mtcp(XREG_CP15_EVENT_CNTR_SEL, 0U);
+	Now[XPM_REGION_INSTRS] = mfcp(XREG_CP15_PERF_MONITOR_COUNT);
+	mtcp(XREG_CP15_EVENT_CNTR_SEL, 1U);
+	Now[XPM_REGION_DMISS] = mfcp(XREG_CP15_PERF_MONITOR_COUNT);
+	mtcp(XREG_CP15_EVENT_CNTR_SEL, 2U);
+	Now[XPM_REGION_BRMISS] = mfcp(XREG_CP15_PERF_MONITOR_COUNT);
+	Xpm_RegionAccumulate(Region, Now);
+}
+
 #ifdef __cplusplus
 }
 #endif